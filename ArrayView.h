@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Шаблон ArrayView - неизменяемое представление непрерывного массива
+ * (аналог std::span из C++20). Не владеет данными, копируется дёшево.
+ * Поддерживает range-based for, поэтому код вида
+ *     for (int v : graph.getAdjList(u)) { ... }
+ * работает одинаково для обычного списка смежности и для CSR.
+ */
+template <typename T>
+class ArrayView {
+private:
+    const T* ptr;        // Указатель на первый элемент
+    size_t count;        // Количество элементов
+
+public:
+    /**
+     * Пустое представление
+     */
+    ArrayView() : ptr(nullptr), count(0) {}
+
+    /**
+     * Представление участка памяти
+     * @param data - указатель на первый элемент
+     * @param size - количество элементов
+     */
+    ArrayView(const T* data, size_t size) : ptr(data), count(size) {}
+
+    /**
+     * Представление всего вектора
+     * @param v - вектор (должен жить дольше представления)
+     */
+    ArrayView(const std::vector<T>& v) : ptr(v.data()), count(v.size()) {}
+
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+    const T* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    const T& front() const { return ptr[0]; }
+    const T& back() const { return ptr[count - 1]; }
+};
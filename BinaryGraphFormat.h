@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Graph.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Заголовок бинарного файла графа (64 байта, little-endian)
+ *
+ * Структура файла (все секции выровнены на 8 байт):
+ *   заголовок
+ *   offsets   - int64[numVertices + 1]   смещения CSR
+ *   neighbors - int32[2 * numEdges]      соседи вершин (CSR)
+ *   edges     - int32[2 * numEdges]      список рёбер (пары u, v)
+ *   layout    - float[numVertices] X, затем float[numVertices] Y (необязательно)
+ *
+ * Позиции секций хранятся в заголовке, поэтому при открытии файл
+ * не разбирается: массивы используются напрямую из отображения в память.
+ */
+struct BinaryGraphHeader {
+    char magic[8];            // Сигнатура "LGRAPHB" + '\0'
+    uint32_t version;         // Версия формата
+    uint32_t flags;           // Флаги (FLAG_HAS_LAYOUT)
+    int64_t numVertices;      // Количество вершин
+    int64_t numEdges;         // Количество рёбер
+    uint64_t offsetsPos;      // Смещение секции offsets от начала файла
+    uint64_t neighborsPos;    // Смещение секции neighbors
+    uint64_t edgesPos;        // Смещение секции edges
+    uint64_t layoutPos;       // Смещение секции layout (0, если её нет)
+};
+
+/**
+ * Класс BinaryGraphFormat - запись и чтение бинарного формата графа,
+ * конвертация между текстовым и бинарным форматами
+ */
+class BinaryGraphFormat {
+public:
+    /**
+     * Текущая версия формата
+     */
+    static const uint32_t VERSION = 1;
+
+    /**
+     * Флаг: в файле сохранены координаты вершин
+     */
+    static const uint32_t FLAG_HAS_LAYOUT = 1;
+
+    /**
+     * Записать граф в бинарный файл
+     * @param filename - имя файла
+     * @param graph - граф (если он не заморожен, CSR строится на копии)
+     * @param layoutX - координаты X вершин или nullptr
+     * @param layoutY - координаты Y вершин или nullptr
+     * @return true если файл записан
+     */
+    static bool write(const std::string& filename, const Graph& graph,
+                      const std::vector<float>* layoutX = nullptr,
+                      const std::vector<float>* layoutY = nullptr);
+
+    /**
+     * Прочитать сохранённые координаты вершин
+     * @param filename - имя бинарного файла
+     * @param x - результат: координаты X
+     * @param y - результат: координаты Y
+     * @return true если файл корректен и содержит координаты
+     */
+    static bool readLayout(const std::string& filename, std::vector<float>& x, std::vector<float>& y);
+
+    /**
+     * Прочитать и проверить заголовок без отображения файла в память
+     * (для потокового чтения секции рёбер, см. EdgeStream)
+     * @param filename - имя файла
+     * @param header - результат: заголовок
+     * @return true если заголовок корректен и секции лежат внутри файла
+     */
+    static bool readHeader(const std::string& filename, BinaryGraphHeader& header);
+
+    /**
+     * Проверить, является ли файл бинарным файлом графа (по сигнатуре)
+     * @param filename - имя файла
+     * @return true если файл начинается с сигнатуры формата
+     */
+    static bool isBinaryFile(const std::string& filename);
+
+    /**
+     * Конвертировать текстовый файл графа в бинарный
+     * @param textFile - исходный текстовый файл
+     * @param binaryFile - результирующий бинарный файл
+     * @param numThreads - количество потоков разбора (0 - по числу ядер)
+     * @return true если конвертация успешна
+     */
+    static bool convertTextToBinary(const std::string& textFile, const std::string& binaryFile, int numThreads = 0);
+
+    /**
+     * Конвертировать бинарный файл графа в текстовый
+     * @param binaryFile - исходный бинарный файл
+     * @param textFile - результирующий текстовый файл
+     * @return true если конвертация успешна
+     */
+    static bool convertBinaryToText(const std::string& binaryFile, const std::string& textFile);
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/**
+ * Ошибка разбора текстового списка рёбер
+ */
+struct ParseError {
+    size_t offset;          // Смещение ошибочного числа от начала файла (в байтах)
+    size_t line;            // Номер строки (с единицы)
+    std::string message;    // Описание ошибки
+};
+
+/**
+ * Номер вершины, ещё не получивший пару (первая половина ребра)
+ * Пара может начинаться в одном участке текста, а заканчиваться в следующем
+ */
+struct PendingVertex {
+    bool present;           // Есть ли номер без пары
+    int value;              // Номер вершины
+    size_t offset;          // Смещение числа от начала файла
+    size_t line;            // Номер строки (внутри участка или абсолютный - см. linkChunks)
+
+    PendingVertex() : present(false), value(0), offset(0), line(0) {}
+};
+
+/**
+ * Результат разбора участка текста
+ */
+struct EdgeChunk {
+    std::vector<std::pair<int, int>> edges;   // Корректные рёбра в порядке файла
+    std::vector<ParseError> errors;           // Первые ошибки (номер строки - внутри участка)
+    size_t errorCount;                        // Общее количество ошибок
+    size_t lineCount;                         // Количество строк в участке
+    size_t tokenCount;                        // Чисел после последнего нечислового слова (или всех)
+    bool reset;                               // Было нечисловое слово (оно обрывает пару)
+    PendingVertex last;                       // Последнее число участка (строка - внутри участка)
+
+    EdgeChunk() : errorCount(0), lineCount(0), tokenCount(0), reset(false) {}
+
+    /**
+     * Очистить результат перед повторным разбором (память векторов сохраняется)
+     */
+    void clear() {
+        edges.clear();
+        errors.clear();
+        errorCount = 0;
+        lineCount = 0;
+        tokenCount = 0;
+        reset = false;
+        last = PendingVertex();
+    }
+};
+
+/**
+ * Результат разбора всего файла
+ */
+struct ParsedEdgeList {
+    int numVertices;                          // Количество вершин из первой строки
+    std::vector<std::pair<int, int>> edges;   // Корректные рёбра в порядке файла
+    std::vector<ParseError> errors;           // Первые ошибки с абсолютными номерами строк
+    size_t errorCount;                        // Общее количество ошибок
+
+    ParsedEdgeList() : numVertices(0), errorCount(0) {}
+};
+
+/**
+ * Класс EdgeListParser - разбор текстового формата графа:
+ * количество вершин, затем номера вершин, которые попарно образуют рёбра.
+ * Как и при чтении через оператор >>, важны только числа: разделителем
+ * служит любой пробельный символ, поэтому обычно по ребру "u v" на строку,
+ * но допустимы и "0 1 1 2" в одной строке, и ребро на одной строке
+ * с количеством вершин, и пара, разорванная переводом строки.
+ * Нечисловое слово не прерывает чтение, а попадает в список ошибок
+ * (начатая пара при этом отбрасывается); номер строки и смещение
+ * используются только в сообщениях об ошибках.
+ * Числа читаются через std::from_chars (без локали и без потоков ввода).
+ */
+class EdgeListParser {
+public:
+    /**
+     * Сколько ошибок сохраняется подробно (остальные только считаются)
+     */
+    static const size_t MAX_STORED_ERRORS = 100;
+
+    /**
+     * Прочитать первое число текста (количество вершин)
+     * @param data - начало текста
+     * @param size - размер текста
+     * @param numVertices - результат: количество вершин
+     * @param bodyOffset - результат: смещение сразу после числа (рёбра могут быть в той же строке)
+     * @param error - описание ошибки, если число некорректно
+     * @return true если количество вершин прочитано
+     */
+    static bool parseHeader(const char* data, size_t size, int& numVertices, size_t& bodyOffset, ParseError& error);
+
+    /**
+     * Разобрать участок текста, состоящий из целых строк
+     * Число без пары в конце участка не теряется: оно остаётся в out.last,
+     * а linkChunks передаёт его следующему участку
+     * @param begin - начало участка (начало строки)
+     * @param end - конец участка (после '\n' или конец текста)
+     * @param baseOffset - смещение начала участка от начала файла
+     * @param numVertices - количество вершин (для проверки диапазона)
+     * @param out - результат разбора
+     * @param carry - первая половина пары из предыдущих участков (или nullptr)
+     */
+    static void parseChunk(const char* begin, const char* end, size_t baseOffset, int numVertices, EdgeChunk& out,
+                           const PendingVertex* carry = nullptr);
+
+    /**
+     * Связать участки, разобранные независимо (каждый - как будто с начала пары)
+     * Для каждого участка определяет половину пары, с которой он на самом
+     * деле начинается; участки с непустой половиной нужно разобрать заново
+     * (parseChunk с carries[c]). Обычно (ребро на строку) таких участков нет.
+     * @param chunks - результаты первого разбора участков
+     * @param count - количество участков
+     * @param firstLine - количество строк до первого участка
+     * @param carry - на входе: половина пары перед первым участком,
+     *                на выходе: половина пары после последнего (строка - абсолютная)
+     * @param carries - результат: половина пары перед каждым участком
+     * @return номера участков, которые нужно разобрать заново
+     */
+    static std::vector<int> linkChunks(const std::vector<EdgeChunk>& chunks, int count, size_t firstLine,
+                                       PendingVertex& carry, std::vector<PendingVertex>& carries);
+
+    /**
+     * Записать ошибку "число без пары в конце файла"
+     * @param carry - оставшаяся половина пары (строка - абсолютная)
+     * @param result - результат разбора (ошибка добавляется к нему)
+     */
+    static void addUnpairedError(const PendingVertex& carry, ParsedEdgeList& result);
+
+    /**
+     * Разобрать весь текст параллельно
+     * Текст делится на участки по границам строк, каждый участок
+     * разбирается в своём потоке, результаты склеиваются в порядке файла
+     * (участки, начинающиеся с середины пары, разбираются повторно)
+     * @param data - начало текста
+     * @param size - размер текста
+     * @param numThreads - количество потоков (0 - по числу ядер)
+     * @param result - результат разбора
+     * @return false если первая строка некорректна (рёбра не читаются)
+     */
+    static bool parse(const char* data, size_t size, int numThreads, ParsedEdgeList& result);
+
+    /**
+     * Вывести ошибки разбора в std::cerr (не больше maxShown штук)
+     * @param filename - имя файла для сообщений
+     * @param parsed - результат разбора
+     * @param maxShown - сколько ошибок показать подробно
+     */
+    static void reportErrors(const std::string& filename, const ParsedEdgeList& parsed, size_t maxShown = 10);
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Класс EdgeStream - последовательное чтение списка рёбер блоками
+ * для графов больше оперативной памяти. Формат файла - текстовый
+ * (как у loadFromFile) или бинарный (BinaryGraphFormat, читается
+ * только секция рёбер); определяется по сигнатуре.
+ *
+ * Файл читается блоками по BLOCK_BYTES отдельным потоком чтения,
+ * пока пул потоков разбирает предыдущий блок (двойная буферизация),
+ * поэтому диск читает без пауз на разбор. Текстовый блок делится
+ * между потоками по границам строк (EdgeListParser::parseChunk),
+ * строка, разрезанная границей блока, переносится в следующий блок,
+ * а пара номеров, разорванная переводом строки, - связывается
+ * (EdgeListParser::linkChunks).
+ * В памяти одновременно только два блока и рёбра одного блока.
+ */
+class EdgeStream {
+public:
+    /**
+     * Обработчик порции рёбер: вызывается из потоков пула одновременно,
+     * worker - номер потока (для буферов "на поток")
+     */
+    typedef std::function<void(const std::pair<int, int>* edges, size_t count, int worker)> EdgeHandler;
+
+    /**
+     * Размер блока чтения в байтах
+     */
+    static constexpr size_t BLOCK_BYTES = 32 << 20;
+
+private:
+    std::string filename;     // Имя файла
+    int numVertices;          // Количество вершин из заголовка
+    bool binary;              // Бинарный формат (иначе текстовый)
+    uint64_t bodyBegin;       // Начало рёбер в файле (после заголовка)
+    uint64_t bodyEnd;         // Конец рёбер в файле
+    size_t headerLines;       // Строк до строки, в которой начинаются рёбра (текстовый формат)
+    uint64_t edgeCount;       // Корректных рёбер за последний проход
+    uint64_t errorCount;      // Ошибок формата за последний проход
+
+public:
+    EdgeStream();
+
+    /**
+     * Открыть файл и прочитать заголовок (количество вершин)
+     * Рёбра не читаются
+     * @param name - имя файла
+     * @return true если файл открыт и заголовок корректен
+     */
+    bool open(const std::string& name);
+
+    /**
+     * Прочитать все рёбра файла за один последовательный проход
+     * Можно вызывать многократно (каждый вызов - новый проход по файлу)
+     * @param pool - пул потоков для разбора и обработки
+     * @param handler - обработчик порций корректных рёбер (потокобезопасный)
+     * @param reportErrors - вывести ошибки формата в std::cerr
+     * @return true если файл прочитан до конца
+     */
+    bool forEachEdge(ThreadPool& pool, const EdgeHandler& handler, bool reportErrors = true);
+
+    /**
+     * Получить количество вершин
+     * @return количество вершин из заголовка файла
+     */
+    int getNumVertices() const;
+
+    /**
+     * Проверить формат файла
+     * @return true для бинарного формата
+     */
+    bool isBinary() const;
+
+    /**
+     * Получить количество корректных рёбер последнего прохода
+     * @return количество рёбер (строк "u v" или записей бинарной секции)
+     */
+    uint64_t getEdgeCount() const;
+
+    /**
+     * Получить количество ошибок формата последнего прохода
+     * @return количество некорректных строк
+     */
+    uint64_t getErrorCount() const;
+
+    /**
+     * Получить объём данных одного прохода
+     * @return количество байт рёбер в файле
+     */
+    uint64_t getBodyBytes() const;
+};
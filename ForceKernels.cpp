@@ -0,0 +1,203 @@
+// Подключаем заголовочный файл вычислительных ядер
+#include "ForceKernels.h"
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем математические функции (sqrt)
+#include <cmath>
+
+// Векторная версия собирается только для x86/x64
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define FORCE_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC разрешает AVX2-интринсики без флагов компиляции
+#define FORCE_KERNELS_AVX2_TARGET
+#else
+// GCC/Clang: включаем AVX2 и FMA только для этой функции, остальной код
+// остаётся совместимым с любым x86-64 процессором
+#define FORCE_KERNELS_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+// Внутренние функции ядер
+namespace {
+
+// Тип функции отталкивания (скалярная или векторная)
+typedef void (*RepulsionKernel)(const float*, const float*, int, int, int, float, float*, float*);
+
+#ifdef FORCE_KERNELS_X86
+// Проверка поддержки AVX2 и FMA процессором и операционной системой
+bool detectAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    // ОС должна сохранять регистры YMM при переключении потоков
+    if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+// Векторная версия отталкивания: 8 вершин j за одну итерацию
+FORCE_KERNELS_AVX2_TARGET
+void repulsionRowsAvx2(const float* x, const float* y, int n, int rowBegin, int rowEnd,
+                       float k, float* fx, float* fy) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 kv = _mm256_set1_ps(k);
+    int vectorEnd = n - n % 8;
+    for (int i = rowBegin; i < rowEnd; i++) {
+        const __m256 xi = _mm256_set1_ps(x[i]);
+        const __m256 yi = _mm256_set1_ps(y[i]);
+        __m256 accX = _mm256_setzero_ps();
+        __m256 accY = _mm256_setzero_ps();
+        for (int j = 0; j < vectorEnd; j += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + j), xi);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + j), yi);
+            // distSq = max(dx^2 + dy^2, 1) - защита от деления на ноль
+            __m256 distSq = _mm256_max_ps(_mm256_fmadd_ps(dx, dx, _mm256_mul_ps(dy, dy)), one);
+            // f = k / (r^2 * r) = (k / r^2) * (1 / r)
+            __m256 f = _mm256_div_ps(kv, _mm256_mul_ps(distSq, _mm256_sqrt_ps(distSq)));
+            accX = _mm256_fnmadd_ps(dx, f, accX);
+            accY = _mm256_fnmadd_ps(dy, f, accY);
+        }
+        // Складываем 8 частичных сумм
+        alignas(32) float partX[8], partY[8];
+        _mm256_store_ps(partX, accX);
+        _mm256_store_ps(partY, accY);
+        float sumX = 0, sumY = 0;
+        for (int l = 0; l < 8; l++) {
+            sumX += partX[l];
+            sumY += partY[l];
+        }
+        // Хвост, не кратный 8
+        for (int j = vectorEnd; j < n; j++) {
+            float dx = x[j] - x[i];
+            float dy = y[j] - y[i];
+            float distSq = std::max(dx * dx + dy * dy, 1.0f);
+            float f = k / (distSq * std::sqrt(distSq));
+            sumX -= dx * f;
+            sumY -= dy * f;
+        }
+        fx[i] += sumX;
+        fy[i] += sumY;
+    }
+}
+#endif
+
+// Выбрать ядро отталкивания по возможностям процессора (один раз)
+RepulsionKernel selectRepulsionKernel() {
+#ifdef FORCE_KERNELS_X86
+    if (detectAvx2()) return repulsionRowsAvx2;
+#endif
+    return ForceKernels::repulsionRowsScalar;
+}
+
+// Активное ядро (инициализация статической переменной потокобезопасна)
+RepulsionKernel activeRepulsionKernel() {
+    static const RepulsionKernel kernel = selectRepulsionKernel();
+    return kernel;
+}
+
+} // namespace
+
+// Функция точного отталкивания (вызывает активное ядро)
+void ForceKernels::repulsionRows(const float* x, const float* y, int n, int rowBegin, int rowEnd,
+                                 float k, float* fx, float* fy) {
+    activeRepulsionKernel()(x, y, n, rowBegin, rowEnd, k, fx, fy);
+}
+
+// Скалярная версия точного отталкивания
+void ForceKernels::repulsionRowsScalar(const float* x, const float* y, int n, int rowBegin, int rowEnd,
+                                       float k, float* fx, float* fy) {
+    for (int i = rowBegin; i < rowEnd; i++) {
+        float xi = x[i], yi = y[i];
+        float sumX = 0, sumY = 0;
+        for (int j = 0; j < n; j++) {
+            float dx = x[j] - xi;
+            float dy = y[j] - yi;
+            // Защита от деления на ноль (если вершины совпадают)
+            float distSq = std::max(dx * dx + dy * dy, 1.0f);
+            // (dx / r) * (k / r^2) = dx * k / (r^2 * r)
+            float f = k / (distSq * std::sqrt(distSq));
+            sumX -= dx * f;
+            sumY -= dy * f;
+        }
+        fx[i] += sumX;
+        fy[i] += sumY;
+    }
+}
+
+// Функция притяжения вдоль рёбер (по спискам соседей CSR)
+void ForceKernels::attractionRange(const float* x, const float* y, const int64_t* offsets, const int* neighbors,
+                                   int begin, int end, float attraction, float optimal, float* fx, float* fy) {
+    for (int i = begin; i < end; i++) {
+        float xi = x[i], yi = y[i];
+        float sumX = 0, sumY = 0;
+        for (int64_t e = offsets[i]; e < offsets[i + 1]; e++) {
+            int j = neighbors[e];
+            float dx = x[j] - xi;
+            float dy = y[j] - yi;
+            float dist = std::max(std::sqrt(dx * dx + dy * dy), 1.0f);
+            // Дальше оптимального расстояния - притяжение, ближе - отталкивание
+            float f = attraction * (dist - optimal) / dist;
+            sumX += dx * f;
+            sumY += dy * f;
+        }
+        fx[i] += sumX;
+        fy[i] += sumY;
+    }
+}
+
+// Функция обновления позиций (цикл без ветвлений, векторизуется компилятором)
+void ForceKernels::integrateRange(float* x, float* y, float* vx, float* vy, int begin, int end, float damping,
+                                  float minX, float minY, float maxX, float maxY) {
+    for (int i = begin; i < end; i++) {
+        float newX = std::max(minX, std::min(maxX, x[i] + vx[i] * damping));
+        float newY = std::max(minY, std::min(maxY, y[i] + vy[i] * damping));
+        // Фактическое смещение (после ограничения границами): вершина,
+        // прижатая к краю, не сдвигается и не мешает сходимости
+        vx[i] = newX - x[i];
+        vy[i] = newY - y[i];
+        x[i] = newX;
+        y[i] = newY;
+    }
+}
+
+// Функция сдвига вершин на шаг фиксированной длины вдоль силы
+void ForceKernels::normalizedStepRange(float* x, float* y, float* fx, float* fy, int begin, int end, float step,
+                                       float minX, float minY, float maxX, float maxY) {
+    for (int i = begin; i < end; i++) {
+        float length = std::sqrt(fx[i] * fx[i] + fy[i] * fy[i]);
+        // Нулевая сила (например, у изолированной вершины) - вершина стоит
+        float scale = step / std::max(length, 1e-20f);
+        float newX = std::max(minX, std::min(maxX, x[i] + fx[i] * scale));
+        float newY = std::max(minY, std::min(maxY, y[i] + fy[i] * scale));
+        // Фактическое смещение (после ограничения границами)
+        fx[i] = newX - x[i];
+        fy[i] = newY - y[i];
+        x[i] = newX;
+        y[i] = newY;
+    }
+}
+
+// Функция проверки использования AVX2
+bool ForceKernels::hasAvx2() {
+#ifdef FORCE_KERNELS_X86
+    return activeRepulsionKernel() == repulsionRowsAvx2;
+#else
+    return false;
+#endif
+}
+
+// Функция возвращает название активного ядра
+const char* ForceKernels::activeKernelName() {
+    return hasAvx2() ? "avx2" : "scalar";
+}
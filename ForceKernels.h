@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Класс ForceKernels - вычислительные ядра force-directed алгоритма
+ * Не зависит от RayLib.
+ *
+ * Все ядра работают с координатами в виде структуры массивов (SoA):
+ * отдельные массивы X и Y, поэтому соседние вершины лежат в памяти подряд
+ * и обрабатываются векторными инструкциями. Для точного отталкивания есть
+ * скалярная версия и версия AVX2; нужная выбирается один раз при первом
+ * вызове по возможностям процессора.
+ */
+class ForceKernels {
+public:
+    /**
+     * Рассчитать точное отталкивание для строк [rowBegin, rowEnd)
+     * Для каждой вершины i суммируется сила от всех n вершин (F = k / r^2).
+     * Вершина i даёт себе нулевой вклад (dx = dy = 0), поэтому отдельной
+     * проверки j != i нет. Каждая строка пишет только в свои fx[i], fy[i],
+     * поэтому разные диапазоны строк можно считать в разных потоках.
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     * @param n - количество вершин
+     * @param rowBegin - первая строка
+     * @param rowEnd - строка после последней
+     * @param k - коэффициент силы отталкивания
+     * @param fx - накопитель силы по X (значения прибавляются)
+     * @param fy - накопитель силы по Y (значения прибавляются)
+     */
+    static void repulsionRows(const float* x, const float* y, int n, int rowBegin, int rowEnd,
+                              float k, float* fx, float* fy);
+
+    /**
+     * Скалярная версия repulsionRows (эталон для проверки векторной версии)
+     */
+    static void repulsionRowsScalar(const float* x, const float* y, int n, int rowBegin, int rowEnd,
+                                    float k, float* fx, float* fy);
+
+    /**
+     * Рассчитать притяжение вдоль рёбер для вершин [begin, end)
+     * Смежность задаётся в формате CSR: соседи вершины v - это
+     * neighbors[offsets[v]] ... neighbors[offsets[v + 1] - 1].
+     * Сила пружины: F = attraction * (r - optimal)
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     * @param offsets - смещения CSR (n + 1 элементов)
+     * @param neighbors - массив соседей CSR
+     * @param begin - первая вершина
+     * @param end - вершина после последней
+     * @param attraction - коэффициент силы притяжения
+     * @param optimal - оптимальная длина ребра
+     * @param fx - накопитель силы по X
+     * @param fy - накопитель силы по Y
+     */
+    static void attractionRange(const float* x, const float* y, const int64_t* offsets, const int* neighbors,
+                                int begin, int end, float attraction, float optimal, float* fx, float* fy);
+
+    /**
+     * Обновить позиции вершин [begin, end): скорость = сила * damping,
+     * позиция += скорость, позиция ограничивается прямоугольником
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     * @param vx - накопленные силы по X (заменяются фактическими смещениями)
+     * @param vy - накопленные силы по Y (заменяются фактическими смещениями)
+     * @param begin - первая вершина
+     * @param end - вершина после последней
+     * @param damping - коэффициент затухания
+     * @param minX, minY, maxX, maxY - границы области
+     */
+    static void integrateRange(float* x, float* y, float* vx, float* vy, int begin, int end, float damping,
+                               float minX, float minY, float maxX, float maxY);
+
+    /**
+     * Сдвинуть вершины [begin, end) на расстояние step вдоль направления силы
+     * (шаг схемы Hu / sfdp: длина смещения не зависит от величины силы,
+     * поэтому сходимость управляется только длиной шага)
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     * @param fx - накопленные силы по X (заменяются фактическими смещениями)
+     * @param fy - накопленные силы по Y (заменяются фактическими смещениями)
+     * @param begin - первая вершина
+     * @param end - вершина после последней
+     * @param step - длина шага
+     * @param minX, minY, maxX, maxY - границы области
+     */
+    static void normalizedStepRange(float* x, float* y, float* fx, float* fy, int begin, int end, float step,
+                                    float minX, float minY, float maxX, float maxY);
+
+    /**
+     * Проверить, используется ли векторная версия (AVX2)
+     * @return true если процессор поддерживает AVX2 и FMA
+     */
+    static bool hasAvx2();
+
+    /**
+     * Получить название активного ядра отталкивания
+     * @return "avx2" или "scalar"
+     */
+    static const char* activeKernelName();
+};
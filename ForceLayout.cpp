@@ -0,0 +1,699 @@
+// Подключаем заголовочный файл force-directed раскладки
+#include "ForceLayout.h"
+// Подключаем бинарный формат графа (для сохранения координат)
+#include "BinaryGraphFormat.h"
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем библиотеку для ввода-вывода (сообщения об ошибках)
+#include <iostream>
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем математические функции (sqrt, cos, sin)
+#include <cmath>
+// Подключаем пределы числовых типов (INT_MAX, FLT_MAX)
+#include <climits>
+#include <cfloat>
+// Подключаем генератор случайных чисел (начальная раскладка грубого уровня)
+#include <random>
+
+// Размеры порций для параллельного шага раскладки
+namespace {
+const int64_t EXACT_ROWS_GRAIN = 32;   // Строк точного отталкивания (каждая стоит O(n))
+const int64_t TREE_GRAIN = 256;        // Вершин для обхода дерева или сетки
+const int64_t VERTEX_GRAIN = 4096;     // Вершин для линейных проходов
+}
+
+// Определение математической константы Pi (если не определена)
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Конструктор раскладки
+// Параметры: g - ссылка на граф
+ForceLayout::ForceLayout(const Graph& g) : graph(g) {
+    // Устанавливаем параметры force-directed алгоритма
+    // Force-directed - физическая модель для красивого расположения графа
+    repulsionForce = 50000.0f;    // Сила отталкивания между вершинами (как заряженные частицы)
+    attractionForce = 0.01f;      // Сила притяжения вдоль рёбер (как пружины)
+    damping = 0.85f;              // Коэффициент затухания (для стабилизации)
+    optimalDistance = 150.0f;     // Оптимальная длина ребра в пикселях
+    repulsionMode = RepulsionMode::Auto;  // Barnes-Hut включается для больших графов
+    barnesHutTheta = 0.8f;        // Угол раскрытия (ошибка порядка 1-2% силы)
+    gridCutoffFactor = 2.0f;      // Радиус отсечения Grid - две оптимальные длины ребра
+    bounded = false;              // Раскладка на всей плоскости
+    boundMinX = boundMinY = -FLT_MAX;
+    boundMaxX = boundMaxY = FLT_MAX;
+    threadPool = &ThreadPool::shared();  // Все ядра машины
+    layoutGraph = &graph;                // Раскладка считается для исходного графа
+    stepLength = 0.0f;                   // Обычное интегрирование со скоростями
+    adaptiveCooling = true;              // Шаг по схеме Hu
+    convergenceTolerance = 0.01f;        // Сходимость - смещение меньше 1% длины ребра
+    maxStepLength = 0.0f;
+    previousEnergy = FLT_MAX;
+    progressCount = 0;
+    stepEnergy = 0.0f;
+    stepMaxDisplacement = 0.0f;
+    positionsVersion = 0;
+
+    // Выделяем массивы координат и скоростей
+    int n = graph.getNumVertices();
+    posX.assign(n, 0.0f);
+    posY.assign(n, 0.0f);
+    velX.assign(n, 0.0f);
+    velY.assign(n, 0.0f);
+}
+
+// Функция размещения вершин по кругу
+// Параметры: centerX, centerY - центр круга, radius - радиус
+void ForceLayout::initializeCircle(float centerX, float centerY, float radius) {
+    // Получаем количество вершин в графе
+    int n = graph.getNumVertices();
+
+    // Выделяем массивы координат и скоростей (скорости обнуляются)
+    posX.assign(n, 0.0f);
+    posY.assign(n, 0.0f);
+    velX.assign(n, 0.0f);
+    velY.assign(n, 0.0f);
+
+    // Проходим по каждой вершине
+    for (int i = 0; i < n; i++) {
+        // Вычисляем угол для i-той вершины (равномерно распределяем по кругу)
+        float angle = 2.0f * M_PI * i / n;
+        // Вычисляем X-координату вершины по формуле окружности
+        posX[i] = centerX + radius * std::cos(angle);
+        // Вычисляем Y-координату вершины по формуле окружности
+        posY[i] = centerY + radius * std::sin(angle);
+    }
+    positionsVersion++;
+}
+
+// Функция расчёта сил отталкивания между всеми парами вершин
+// Работает по закону Кулона: F = k / r^2 (сила обратно пропорциональна квадрату расстояния)
+// Для каждой вершины сумма по всем остальным считается векторным ядром
+// (AVX2, если процессор его поддерживает), запись идёт только в свою вершину,
+// поэтому блоки строк считаются в разных потоках без синхронизации
+void ForceLayout::applyExactRepulsion() {
+    int n = layoutGraph->getNumVertices();
+    threadPool->parallelFor(0, n, EXACT_ROWS_GRAIN, [&](int64_t begin, int64_t end, int) {
+        ForceKernels::repulsionRows(posX.data(), posY.data(), n, static_cast<int>(begin), static_cast<int>(end),
+                                    repulsionForce, velX.data(), velY.data());
+    });
+}
+
+// Функция расчёта сил притяжения вдоль рёбер
+// Работает как пружина: F = k * (текущая_длина - оптимальная_длина)
+// Каждая вершина суммирует силы от своих соседей по спискам CSR
+void ForceLayout::applyAttraction() {
+    int n = layoutGraph->getNumVertices();
+    const int64_t* offsets;
+    const int* neighbors;
+
+    const CSRStorage* csr = layoutGraph->getCSR();
+    if (csr) {
+        // Замороженный граф - берём его CSR без копирования
+        offsets = csr->offsets;
+        neighbors = csr->neighbors;
+    } else {
+        // Граф может меняться - собираем CSR из текущих списков смежности
+        adjOffsets.resize(n + 1);
+        adjNeighbors.clear();
+        adjOffsets[0] = 0;
+        for (int v = 0; v < n; v++) {
+            NeighborView adj = layoutGraph->getAdjList(v);
+            adjNeighbors.insert(adjNeighbors.end(), adj.begin(), adj.end());
+            adjOffsets[v + 1] = static_cast<int64_t>(adjNeighbors.size());
+        }
+        offsets = adjOffsets.data();
+        neighbors = adjNeighbors.data();
+    }
+
+    threadPool->parallelFor(0, n, VERTEX_GRAIN, [&](int64_t begin, int64_t end, int) {
+        ForceKernels::attractionRange(posX.data(), posY.data(), offsets, neighbors,
+                                      static_cast<int>(begin), static_cast<int>(end),
+                                      attractionForce, optimalDistance, velX.data(), velY.data());
+    });
+}
+
+// Функция расчёта сил отталкивания методом Barnes-Hut
+// Строим квадродерево по текущим позициям, затем для каждой вершины
+// обходим дерево, заменяя далёкие группы вершин их центром масс
+void ForceLayout::applyBarnesHutRepulsion() {
+    int n = layoutGraph->getNumVertices();
+
+    // Строим дерево заново на каждом шаге (позиции меняются)
+    quadTree.build(posX, posY);
+
+    // Накапливаем силу отталкивания для каждой вершины (обход дерева
+    // не изменяет его, поэтому блоки вершин обходятся параллельно)
+    threadPool->parallelFor(0, n, TREE_GRAIN, [&](int64_t begin, int64_t end, int) {
+        for (int64_t i = begin; i < end; i++) {
+            float fx = 0, fy = 0;
+            quadTree.accumulateRepulsion(static_cast<int>(i), barnesHutTheta, repulsionForce, fx, fy);
+            velX[i] += fx;
+            velY[i] += fy;
+        }
+    });
+}
+
+// Функция расчёта сил отталкивания через равномерную сетку
+// Вершины раскладываются по ячейкам со стороной, равной радиусу отсечения,
+// и каждая вершина отталкивается только от вершин в радиусе отсечения
+// (вариант Fruchterman-Reingold с сеткой). Далёкие вершины не учитываются,
+// поэтому для разреженных графов шаг выполняется почти за O(n)
+void ForceLayout::applyGridRepulsion() {
+    int n = layoutGraph->getNumVertices();
+    float cutoff = optimalDistance * gridCutoffFactor;
+
+    // Раскладываем вершины по ячейкам
+    spatialGrid.build(posX, posY, cutoff);
+
+    // Накапливаем силу отталкивания от соседних вершин
+    threadPool->parallelFor(0, n, TREE_GRAIN, [&](int64_t begin, int64_t end, int) {
+        for (int64_t i = begin; i < end; i++) {
+            float fx = 0, fy = 0;
+            spatialGrid.accumulateRepulsion(static_cast<int>(i), cutoff, repulsionForce, fx, fy);
+            velX[i] += fx;
+            velY[i] += fy;
+        }
+    });
+}
+
+// Функция выполнения одной итерации force-directed алгоритма
+// На каждой итерации пересчитываем силы и обновляем позиции вершин
+void ForceLayout::step() {
+    GRAPH_PROFILE_SCOPE(LayoutStep);
+    GRAPH_PROFILE_COUNT(LayoutSteps, 1);
+
+    // Получаем количество вершин
+    int n = layoutGraph->getNumVertices();
+
+    // Обнуляем скорости всех вершин перед новым расчётом
+    std::fill(velX.begin(), velX.end(), 0.0f);
+    std::fill(velY.begin(), velY.end(), 0.0f);
+
+    // Выбираем способ расчёта отталкивания
+    bool useBarnesHut = repulsionMode == RepulsionMode::BarnesHut ||
+                        (repulsionMode == RepulsionMode::Auto && n >= BARNES_HUT_THRESHOLD);
+
+    {
+        GRAPH_PROFILE_SCOPE(Repulsion);
+        if (repulsionMode == RepulsionMode::Grid) {
+            // Отсечение по расстоянию через равномерную сетку
+            applyGridRepulsion();
+        } else if (useBarnesHut) {
+            // Приближённый расчёт через квадродерево за O(n log n)
+            applyBarnesHutRepulsion();
+        } else {
+            // Каждая вершина отталкивает все остальные (как заряженные частицы)
+            applyExactRepulsion();
+        }
+    }
+
+    // Рассчитываем силы притяжения вдоль рёбер
+    // Рёбра работают как пружины, притягивая соединённые вершины
+    {
+        GRAPH_PROFILE_SCOPE(Attraction);
+        applyAttraction();
+    }
+
+    // Энергия системы - сумма квадратов сил (по порциям в фиксированном
+    // порядке, поэтому результат не зависит от количества потоков)
+    int64_t chunkCount = (n + VERTEX_GRAIN - 1) / VERTEX_GRAIN;
+    {
+        GRAPH_PROFILE_SCOPE(Energy);
+        std::vector<double> partialEnergy(chunkCount, 0.0);
+        threadPool->parallelFor(0, n, VERTEX_GRAIN, [&](int64_t begin, int64_t end, int) {
+            double sum = 0;
+            for (int64_t i = begin; i < end; i++) {
+                sum += static_cast<double>(velX[i]) * velX[i] + static_cast<double>(velY[i]) * velY[i];
+            }
+            partialEnergy[begin / VERTEX_GRAIN] = sum;
+        });
+        double energy = 0;
+        for (double part : partialEnergy) energy += part;
+        stepEnergy = static_cast<float>(energy);
+    }
+
+    // Обновляем позиции вершин на основе накопленных скоростей
+    {
+        GRAPH_PROFILE_SCOPE(UpdatePositions);
+        updatePositions();
+    }
+
+    // Максимальное смещение вершины за шаг (после шага в velX/velY
+    // лежат фактические смещения - с учётом границ области)
+    GRAPH_PROFILE_SCOPE(Displacement);
+    std::vector<float> partialDisplacement(chunkCount, 0.0f);
+    threadPool->parallelFor(0, n, VERTEX_GRAIN, [&](int64_t begin, int64_t end, int) {
+        float maxSq = 0;
+        for (int64_t i = begin; i < end; i++) {
+            maxSq = std::max(maxSq, velX[i] * velX[i] + velY[i] * velY[i]);
+        }
+        partialDisplacement[begin / VERTEX_GRAIN] = maxSq;
+    });
+    float maxSq = 0;
+    for (float part : partialDisplacement) maxSq = std::max(maxSq, part);
+    stepMaxDisplacement = std::sqrt(maxSq);
+    positionsVersion++;
+}
+
+// Функция сброса состояния охлаждения
+void ForceLayout::resetCooling(float startStep) {
+    stepLength = startStep;
+    maxStepLength = startStep;
+    previousEnergy = FLT_MAX;
+    progressCount = 0;
+}
+
+// Функция сброса охлаждения с длиной шага по умолчанию
+void ForceLayout::resetCooling() {
+    // Начальный шаг - одна оптимальная длина ребра (схема Hu)
+    resetCooling(adaptiveCooling ? optimalDistance : 0.0f);
+}
+
+// Функция одного шага с адаптивным охлаждением (Y. Hu, 2005)
+bool ForceLayout::coolingStep() {
+    step();
+
+    if (stepLength > 0) {
+        if (stepEnergy < previousEnergy) {
+            // Энергия уменьшается - после 5 удачных шагов подряд увеличиваем шаг
+            progressCount++;
+            if (progressCount >= 5) {
+                progressCount = 0;
+                stepLength = std::min(stepLength / COOLING_FACTOR, maxStepLength);
+            }
+        } else {
+            // Энергия выросла - раскладка "перескочила", уменьшаем шаг
+            progressCount = 0;
+            stepLength *= COOLING_FACTOR;
+        }
+        previousEnergy = stepEnergy;
+    }
+
+    // Раскладка стабильна, если ни одна вершина не сдвинулась заметно
+    return stepMaxDisplacement < convergenceTolerance * optimalDistance;
+}
+
+// Функция выполнения шагов до сходимости или до лимита
+LayoutResult ForceLayout::runUntilConverged(int maxIterations, float startStep) {
+    LayoutResult result;
+    resetCooling(startStep);
+    while (result.iterations < maxIterations && !result.converged) {
+        result.converged = coolingStep();
+        result.iterations++;
+    }
+    result.energy = stepEnergy;
+    result.maxDisplacement = stepMaxDisplacement;
+    return result;
+}
+
+// Функция обновления позиций вершин на основе их скоростей
+void ForceLayout::updatePositions() {
+    // Получаем количество вершин
+    int n = layoutGraph->getNumVertices();
+
+    if (stepLength > 0) {
+        // Адаптивное охлаждение: смещение фиксированной длины вдоль силы
+        threadPool->parallelFor(0, n, VERTEX_GRAIN, [&](int64_t begin, int64_t end, int) {
+            ForceKernels::normalizedStepRange(posX.data(), posY.data(), velX.data(), velY.data(),
+                                              static_cast<int>(begin), static_cast<int>(end), stepLength,
+                                              boundMinX, boundMinY, boundMaxX, boundMaxY);
+        });
+        return;
+    }
+
+    // Применяем демпфирование к скорости (без него вершины бесконечно колеблются),
+    // сдвигаем вершины и ограничиваем позиции границами области
+    threadPool->parallelFor(0, n, VERTEX_GRAIN, [&](int64_t begin, int64_t end, int) {
+        ForceKernels::integrateRange(posX.data(), posY.data(), velX.data(), velY.data(),
+                                     static_cast<int>(begin), static_cast<int>(end), damping,
+                                     boundMinX, boundMinY, boundMaxX, boundMaxY);
+    });
+}
+
+// Функция оптимизации расположения вершин
+// Выполняет итерации алгоритма, пока раскладка не стабилизируется
+// (или до лимита итераций)
+LayoutResult ForceLayout::optimize(int maxIterations) {
+    // Начальный шаг - одна оптимальная длина ребра (схема Hu)
+    return runUntilConverged(maxIterations, adaptiveCooling ? optimalDistance : 0.0f);
+}
+
+// Функция огрубления графа паросочетанием
+// Вершины обходятся по возрастанию степени; свободная вершина объединяется
+// с наименее связанным свободным соседом. Вершина, у которой все соседи уже
+// заняты, присоединяется к самой маленькой соседней группе (так за один
+// уровень схлопываются "звёзды", которые паросочетание уменьшает медленно)
+// Параметры: fine - исходный граф, coarseOf - номер группы каждой вершины
+// Возвращает огрублённый граф (вершина = группа)
+static Graph coarsenByMatching(const Graph& fine, std::vector<int>& coarseOf) {
+    int n = fine.getNumVertices();
+
+    // Порядок обхода - по возрастанию степени (при равенстве - по номеру)
+    std::vector<int> order(n);
+    for (int v = 0; v < n; v++) order[v] = v;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return fine.getDegree(a) < fine.getDegree(b);
+    });
+
+    coarseOf.assign(n, -1);
+    std::vector<int> groupSize;
+    for (int v : order) {
+        if (coarseOf[v] >= 0) continue;
+
+        // Ищем свободного соседа с минимальной степенью и
+        // самую маленькую из соседних групп
+        int freeNeighbor = -1, freeDegree = INT_MAX;
+        int nearGroup = -1;
+        for (int u : fine.getAdjList(v)) {
+            if (u == v) continue;
+            if (coarseOf[u] < 0) {
+                if (fine.getDegree(u) < freeDegree) {
+                    freeNeighbor = u;
+                    freeDegree = fine.getDegree(u);
+                }
+            } else if (nearGroup < 0 || groupSize[coarseOf[u]] < groupSize[nearGroup]) {
+                nearGroup = coarseOf[u];
+            }
+        }
+
+        if (freeNeighbor >= 0) {
+            // Новая группа из пары вершин
+            coarseOf[v] = coarseOf[freeNeighbor] = static_cast<int>(groupSize.size());
+            groupSize.push_back(2);
+        } else if (nearGroup >= 0) {
+            // Все соседи заняты - присоединяемся к соседней группе
+            coarseOf[v] = nearGroup;
+            groupSize[nearGroup]++;
+        } else {
+            // Изолированная вершина остаётся одна
+            coarseOf[v] = static_cast<int>(groupSize.size());
+            groupSize.push_back(1);
+        }
+    }
+
+    // Рёбра между разными группами (дубли удаляет fromEdgeList)
+    std::vector<std::pair<int, int>> coarseEdges;
+    for (const auto& edge : fine.getEdges()) {
+        int cu = coarseOf[edge.first];
+        int cv = coarseOf[edge.second];
+        if (cu != cv) coarseEdges.push_back({cu, cv});
+    }
+    return Graph::fromEdgeList(static_cast<int>(groupSize.size()), EdgeView(coarseEdges));
+}
+
+// Функция многоуровневой оптимизации расположения (в стиле FM^3 / sfdp)
+// 1) Огрубляем граф паросочетаниями, пока он не станет маленьким
+// 2) Раскладываем самый грубый уровень обычным force-directed алгоритмом
+// 3) Переносим позиции на более подробный уровень (вершины группы - рядом
+//    с позицией группы) и уточняем несколькими шагами алгоритма
+// Раскладка идёт на неограниченной плоскости (границы снимаются на время
+// расчёта и восстанавливаются в конце)
+LayoutResult ForceLayout::optimizeMultilevel(int refineIterations) {
+    LayoutResult total;
+    int n = graph.getNumVertices();
+    if (n == 0) return total;
+
+    // ===== ОГРУБЛЕНИЕ =====
+    // levels[0] - исходный граф, levels[l + 1] - огрубление levels[l]
+    std::vector<Graph> coarseLevels;
+    std::vector<std::vector<int>> coarseOf;
+    const Graph* current = &graph;
+    while (current->getNumVertices() > MULTILEVEL_COARSEST_SIZE) {
+        std::vector<int> mapping;
+        Graph coarse = coarsenByMatching(*current, mapping);
+        // Огрубление почти не уменьшает граф (например, много изолированных
+        // вершин) - дальше огрублять бессмысленно
+        if (coarse.getNumVertices() > current->getNumVertices() * 0.9) break;
+        coarseOf.push_back(std::move(mapping));
+        coarseLevels.push_back(std::move(coarse));
+        current = &coarseLevels.back();
+    }
+    int levelCount = static_cast<int>(coarseLevels.size());
+
+    // Раскладка идёт без ограничения границами
+    bool wasBounded = bounded;
+    float savedMinX = boundMinX, savedMinY = boundMinY;
+    float savedMaxX = boundMaxX, savedMaxY = boundMaxY;
+    clearBounds();
+
+    // ===== РАСКЛАДКА ГРУБОГО УРОВНЯ =====
+    // Начальное положение - случайные точки в квадрате, площадь которого
+    // растёт с числом вершин (генератор с фиксированным зерном -
+    // результат воспроизводим)
+    int coarsestSize = current->getNumVertices();
+    float side = optimalDistance * std::sqrt(static_cast<float>(coarsestSize));
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> coordinate(0.0f, side);
+    posX.resize(coarsestSize);
+    posY.resize(coarsestSize);
+    for (int i = 0; i < coarsestSize; i++) {
+        posX[i] = coordinate(random);
+        posY[i] = coordinate(random);
+    }
+    velX.assign(coarsestSize, 0.0f);
+    velY.assign(coarsestSize, 0.0f);
+    layoutGraph = current;
+    total = runUntilConverged(MULTILEVEL_COARSEST_ITERATIONS, side / 4);
+
+    // ===== ПЕРЕНОС И УТОЧНЕНИЕ =====
+    for (int level = levelCount - 1; level >= 0; level--) {
+        const Graph* fine = level == 0 ? &graph : &coarseLevels[level - 1];
+        const std::vector<int>& mapping = coarseOf[level];
+        int fineSize = fine->getNumVertices();
+
+        // Подробный уровень содержит больше вершин - растягиваем раскладку,
+        // чтобы плотность вершин на единицу площади не выросла
+        float scale = std::sqrt(static_cast<float>(fineSize) / layoutGraph->getNumVertices());
+
+        // Вершина получает позицию своей группы плюс небольшой сдвиг
+        // (по "золотому углу" от номера вершины - детерминированно и без совпадений)
+        std::vector<float> fineX(fineSize), fineY(fineSize);
+        for (int v = 0; v < fineSize; v++) {
+            float angle = 2.39996323f * v;
+            fineX[v] = posX[mapping[v]] * scale + optimalDistance * 0.1f * std::cos(angle);
+            fineY[v] = posY[mapping[v]] * scale + optimalDistance * 0.1f * std::sin(angle);
+        }
+        posX = std::move(fineX);
+        posY = std::move(fineY);
+        velX.assign(fineSize, 0.0f);
+        velY.assign(fineSize, 0.0f);
+        layoutGraph = fine;
+
+        // Маленькие уровни дёшевы - на них можно сделать больше шагов, но
+        // не больше MULTILEVEL_LEVEL_WORK работы: большие уровни получают
+        // refineIterations шагов, и их время убывает вдвое с каждым уровнем.
+        // Начальный шаг мал - раскладка уже почти готова
+        int iterations = std::min(MULTILEVEL_COARSEST_ITERATIONS,
+                                  std::max(refineIterations, MULTILEVEL_LEVEL_WORK / fineSize));
+        LayoutResult result = runUntilConverged(iterations, optimalDistance);
+        total.iterations += result.iterations;
+        total.energy = result.energy;
+        total.maxDisplacement = result.maxDisplacement;
+        total.converged = result.converged;
+    }
+
+    // Возвращаемся к исходному графу и прежним границам
+    layoutGraph = &graph;
+    stepLength = 0.0f;
+    if (wasBounded) setBounds(savedMinX, savedMinY, savedMaxX, savedMaxY);
+    positionsVersion++;
+    return total;
+}
+
+// Функция центрирования раскладки
+// Находит центр масс всех вершин и перемещает его в заданную точку
+void ForceLayout::center(float centerX, float centerY) {
+    // Получаем количество вершин
+    int n = graph.getNumVertices();
+    // Если вершин нет, ничего не делаем
+    if (n == 0) return;
+
+    // Находим центр масс графа (среднее всех координат)
+    float massX = 0, massY = 0;  // Инициализируем центр
+    for (int i = 0; i < n; i++) {
+        massX += posX[i];  // Суммируем X-координаты
+        massY += posY[i];  // Суммируем Y-координаты
+    }
+    massX /= n;  // Делим на количество вершин для получения среднего
+    massY /= n;  // Делим на количество вершин для получения среднего
+
+    // Вычисляем смещение для перемещения центра масс в заданную точку
+    float offsetX = centerX - massX;  // Смещение по X
+    float offsetY = centerY - massY;  // Смещение по Y
+
+    // Применяем смещение ко всем вершинам
+    for (int i = 0; i < n; i++) {
+        posX[i] += offsetX;  // Сдвигаем вершину по X
+        posY[i] += offsetY;  // Сдвигаем вершину по Y
+    }
+    positionsVersion++;
+}
+
+// Функция вписывания раскладки в прямоугольник
+// Равномерно масштабирует координаты так, чтобы все вершины
+// поместились в прямоугольник, и центрирует их
+void ForceLayout::fitToRect(float minX, float minY, float maxX, float maxY) {
+    int n = graph.getNumVertices();
+    if (n == 0) return;
+
+    // Ограничивающий прямоугольник вершин
+    float layoutMinX = *std::min_element(posX.begin(), posX.end());
+    float layoutMaxX = *std::max_element(posX.begin(), posX.end());
+    float layoutMinY = *std::min_element(posY.begin(), posY.end());
+    float layoutMaxY = *std::max_element(posY.begin(), posY.end());
+
+    // Масштаб выбираем по более "тесному" направлению
+    float scale = std::min((maxX - minX) / std::max(layoutMaxX - layoutMinX, 1.0f),
+                           (maxY - minY) / std::max(layoutMaxY - layoutMinY, 1.0f));
+
+    // Центр раскладки переходит в центр прямоугольника
+    float layoutCenterX = (layoutMinX + layoutMaxX) / 2.0f;
+    float layoutCenterY = (layoutMinY + layoutMaxY) / 2.0f;
+    float rectCenterX = (minX + maxX) / 2.0f;
+    float rectCenterY = (minY + maxY) / 2.0f;
+    for (int i = 0; i < n; i++) {
+        posX[i] = rectCenterX + (posX[i] - layoutCenterX) * scale;
+        posY[i] = rectCenterY + (posY[i] - layoutCenterY) * scale;
+    }
+    positionsVersion++;
+}
+
+// Установить прямоугольник, за который вершины не выходят
+void ForceLayout::setBounds(float minX, float minY, float maxX, float maxY) {
+    bounded = true;
+    boundMinX = minX;
+    boundMinY = minY;
+    boundMaxX = maxX;
+    boundMaxY = maxY;
+}
+
+// Снять ограничение позиций
+void ForceLayout::clearBounds() {
+    bounded = false;
+    boundMinX = boundMinY = -FLT_MAX;
+    boundMaxX = boundMaxY = FLT_MAX;
+}
+
+// Функция возвращает X-координаты вершин
+const std::vector<float>& ForceLayout::getX() const {
+    return posX;
+}
+
+// Функция возвращает Y-координаты вершин
+const std::vector<float>& ForceLayout::getY() const {
+    return posY;
+}
+
+// Функция задаёт координаты вершин
+bool ForceLayout::setPositions(std::vector<float> x, std::vector<float> y) {
+    int n = graph.getNumVertices();
+    if (static_cast<int>(x.size()) != n || static_cast<int>(y.size()) != n) {
+        std::cerr << "Ошибка: количество координат не совпадает с количеством вершин" << std::endl;
+        return false;
+    }
+    posX = std::move(x);
+    posY = std::move(y);
+    velX.assign(n, 0.0f);
+    velY.assign(n, 0.0f);
+    positionsVersion++;
+    return true;
+}
+
+// Функция возвращает номер версии координат
+uint64_t ForceLayout::getPositionsVersion() const {
+    return positionsVersion;
+}
+
+// Функция возвращает энергию последнего шага
+float ForceLayout::getEnergy() const {
+    return stepEnergy;
+}
+
+// Функция возвращает максимальное смещение вершины на последнем шаге
+float ForceLayout::getMaxDisplacement() const {
+    return stepMaxDisplacement;
+}
+
+// Функция возвращает оптимальное расстояние между вершинами
+float ForceLayout::getOptimalDistance() const {
+    return optimalDistance;
+}
+
+// Функция сохранения графа и координат вершин в бинарный файл
+bool ForceLayout::saveLayout(const std::string& filename) const {
+    // Координаты уже хранятся отдельными массивами X и Y (как в формате файла)
+    return BinaryGraphFormat::write(filename, graph, &posX, &posY);
+}
+
+// Функция загрузки координат вершин из бинарного файла
+bool ForceLayout::loadLayout(const std::string& filename) {
+    std::vector<float> x, y;
+    if (!BinaryGraphFormat::readLayout(filename, x, y)) {
+        return false;
+    }
+    // Координаты подходят, только если количество вершин совпадает
+    if (static_cast<int>(x.size()) != graph.getNumVertices()) {
+        std::cerr << "Ошибка: в файле " << filename << " другое количество вершин" << std::endl;
+        return false;
+    }
+    return setPositions(std::move(x), std::move(y));
+}
+
+// ===== СЕТТЕРЫ ДЛЯ ПАРАМЕТРОВ FORCE-DIRECTED АЛГОРИТМА =====
+
+// Установить силу отталкивания между вершинами
+// Большие значения - вершины отталкиваются сильнее
+void ForceLayout::setRepulsionForce(float force) {
+    repulsionForce = force;
+}
+
+// Установить силу притяжения вдоль рёбер
+// Большие значения - рёбра сильнее притягивают вершины
+void ForceLayout::setAttractionForce(float force) {
+    attractionForce = force;
+}
+
+// Установить коэффициент затухания (0-1)
+// Близко к 1 - медленное затухание, близко к 0 - быстрое
+void ForceLayout::setDamping(float d) {
+    damping = d;
+}
+
+// Установить оптимальное расстояние между соединёнными вершинами
+void ForceLayout::setOptimalDistance(float distance) {
+    optimalDistance = distance;
+}
+
+// Установить способ расчёта сил отталкивания
+void ForceLayout::setRepulsionMode(RepulsionMode mode) {
+    repulsionMode = mode;
+}
+
+// Установить угол раскрытия Barnes-Hut
+// Меньшие значения - точнее, но медленнее (0 - эквивалент точного расчёта)
+void ForceLayout::setBarnesHutTheta(float theta) {
+    barnesHutTheta = std::max(0.0f, theta);
+}
+
+// Установить радиус отсечения для режима Grid
+void ForceLayout::setGridCutoffFactor(float factor) {
+    // Радиус меньше половины оптимальной длины ребра ломает раскладку
+    gridCutoffFactor = std::max(0.5f, factor);
+}
+
+// Установить количество потоков для расчёта раскладки
+void ForceLayout::setThreadCount(int numThreads) {
+    threadPool = &ThreadPool::select(numThreads, ownThreadPool);
+}
+
+// Включить или выключить адаптивное охлаждение
+void ForceLayout::setAdaptiveCooling(bool enabled) {
+    adaptiveCooling = enabled;
+}
+
+// Установить порог сходимости (доля оптимальной длины ребра)
+void ForceLayout::setConvergenceTolerance(float tolerance) {
+    convergenceTolerance = std::max(0.0f, tolerance);
+}
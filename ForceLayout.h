@@ -0,0 +1,355 @@
+#pragma once
+
+#include "Graph.h"
+#include "QuadTree.h"
+#include "SpatialGrid.h"
+#include "ForceKernels.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <string>
+#include <memory>
+
+/**
+ * Способ расчёта сил отталкивания в force-directed алгоритме
+ */
+enum class RepulsionMode {
+    Exact,      // Точный расчёт по всем парам вершин, O(n^2)
+    BarnesHut,  // Приближение Barnes-Hut через квадродерево, O(n log n)
+    Grid,       // Отсечение по расстоянию через равномерную сетку, ~O(n) для разреженных графов
+    Auto        // Exact для маленьких графов, BarnesHut для больших
+};
+
+/**
+ * Результат оптимизации расположения вершин
+ */
+struct LayoutResult {
+    int iterations;          // Выполнено шагов
+    float energy;            // Энергия последнего шага (сумма квадратов сил)
+    float maxDisplacement;   // Максимальное смещение вершины на последнем шаге
+    bool converged;          // Раскладка стабилизировалась раньше лимита шагов
+
+    LayoutResult() : iterations(0), energy(0), maxDisplacement(0), converged(false) {}
+};
+
+/**
+ * Класс ForceLayout - force-directed раскладка неориентированного графа
+ * Не зависит от RayLib: используется визуализатором и консольной
+ * утилитой graph-layout (расчёт раскладки без окна и видеокарты).
+ *
+ * Координаты и скорости вершин хранятся структурой массивов (SoA),
+ * силы считаются ядрами ForceKernels, шаг выполняется параллельно
+ * на пуле потоков (результат не зависит от количества потоков).
+ */
+class ForceLayout {
+private:
+    const Graph& graph;
+
+    // Состояние раскладки в виде структуры массивов (SoA):
+    // координаты и скорости вершин лежат в отдельных непрерывных массивах
+    std::vector<float> posX, posY;   // Координаты вершин
+    std::vector<float> velX, velY;   // Скорости (для force-directed алгоритма)
+
+    // Параметры force-directed алгоритма
+    float repulsionForce;     // Сила отталкивания между вершинами
+    float attractionForce;    // Сила притяжения вдоль рёбер
+    float damping;            // Демпфирование (для затухания колебаний)
+    float optimalDistance;    // Оптимальное расстояние между вершинами
+    RepulsionMode repulsionMode;  // Способ расчёта отталкивания
+    float barnesHutTheta;     // Угол раскрытия для Barnes-Hut
+    float gridCutoffFactor;   // Радиус отсечения для Grid в долях optimalDistance
+
+    // Прямоугольник, за который вершины не выходят
+    bool bounded;
+    float boundMinX, boundMinY, boundMaxX, boundMaxY;
+
+    // Буферы для Barnes-Hut и Grid (переиспользуются между шагами)
+    QuadTree quadTree;
+    SpatialGrid spatialGrid;
+
+    // Граф, для которого считается шаг раскладки: исходный или
+    // (в многоуровневом режиме) один из огрублённых уровней
+    const Graph* layoutGraph;
+    float stepLength;         // Длина шага вдоль силы (0 - обычное интегрирование)
+
+    // Адаптивное охлаждение (схема Hu) и признак сходимости
+    bool adaptiveCooling;         // Шаг фиксированной длины с адаптивным охлаждением
+    float convergenceTolerance;   // Порог смещения в долях optimalDistance
+    float maxStepLength;          // Верхняя граница длины шага
+    float previousEnergy;         // Энергия предыдущего шага
+    int progressCount;            // Сколько шагов подряд энергия уменьшалась
+    float stepEnergy;             // Энергия последнего шага
+    float stepMaxDisplacement;    // Максимальное смещение на последнем шаге
+
+    // Номер версии координат (увеличивается при каждом их изменении)
+    uint64_t positionsVersion;
+
+    // Пул потоков для шага раскладки (общий или собственный)
+    ThreadPool* threadPool;
+    std::unique_ptr<ThreadPool> ownThreadPool;
+
+    // Списки смежности в формате CSR для незамороженного графа
+    std::vector<int64_t> adjOffsets;
+    std::vector<int> adjNeighbors;
+
+    /**
+     * Рассчитать силы отталкивания между всеми парами вершин
+     */
+    void applyExactRepulsion();
+
+    /**
+     * Рассчитать силы отталкивания для всех вершин через квадродерево
+     */
+    void applyBarnesHutRepulsion();
+
+    /**
+     * Рассчитать силы отталкивания только от вершин соседних ячеек сетки
+     */
+    void applyGridRepulsion();
+
+    /**
+     * Рассчитать силы притяжения вдоль рёбер
+     */
+    void applyAttraction();
+
+    /**
+     * Обновить позиции вершин на основе скоростей
+     */
+    void updatePositions();
+
+public:
+    /**
+     * Конструктор раскладки (вершины изначально в точке (0, 0) -
+     * перед расчётом нужно вызвать initializeCircle или setPositions)
+     * @param g - граф (должен жить дольше раскладки)
+     */
+    explicit ForceLayout(const Graph& g);
+
+    ForceLayout(const ForceLayout&) = delete;
+    ForceLayout& operator=(const ForceLayout&) = delete;
+
+    /**
+     * Разместить вершины по кругу и обнулить скорости
+     * @param centerX, centerY - центр круга
+     * @param radius - радиус круга
+     */
+    void initializeCircle(float centerX, float centerY, float radius);
+
+    /**
+     * Применить force-directed алгоритм для одной итерации
+     */
+    void step();
+
+    /**
+     * Начать охлаждение заново
+     * @param startStep - начальная длина шага (0 - обычное интегрирование
+     *                    со скоростями, без нормировки шага)
+     */
+    void resetCooling(float startStep);
+
+    /**
+     * Начать охлаждение заново с длины шага по умолчанию
+     * (одно ребро при адаптивном охлаждении, иначе обычное интегрирование)
+     */
+    void resetCooling();
+
+    /**
+     * Выполнить один шаг алгоритма и обновить длину шага по схеме Hu:
+     * энергия уменьшается 5 шагов подряд - шаг растёт, энергия выросла - шаг
+     * уменьшается (коэффициент COOLING_FACTOR)
+     * @return true если максимальное смещение меньше порога сходимости
+     */
+    bool coolingStep();
+
+    /**
+     * Выполнять шаги до сходимости или до лимита
+     * @param maxIterations - максимальное количество шагов
+     * @param startStep - начальная длина шага (см. resetCooling)
+     * @return количество шагов, энергия и признак сходимости
+     */
+    LayoutResult runUntilConverged(int maxIterations, float startStep);
+
+    /**
+     * Оптимизировать расположение вершин
+     * Останавливается раньше, когда максимальное смещение вершины за шаг
+     * становится меньше порога (см. setConvergenceTolerance)
+     * @param maxIterations - максимальное количество итераций
+     * @return количество итераций, конечная энергия и признак сходимости
+     */
+    LayoutResult optimize(int maxIterations = 1000);
+
+    /**
+     * Многоуровневая оптимизация для больших графов (огрубление - раскладка -
+     * уточнение): граф огрубляется паросочетаниями, самый грубый уровень
+     * раскладывается с нуля, затем позиции переносятся на подробные уровни
+     * и уточняются несколькими шагами. Раскладка идёт без границ.
+     * Уровень из n вершин уточняется max(refineIterations,
+     * MULTILEVEL_LEVEL_WORK / n) шагами (не больше MULTILEVEL_COARSEST_ITERATIONS)
+     * @param refineIterations - количество шагов уточнения на каждом уровне
+     * @return суммарное количество шагов по всем уровням, энергия
+     *         и признак сходимости последнего уровня
+     */
+    LayoutResult optimizeMultilevel(int refineIterations = 30);
+
+    /**
+     * Сдвинуть раскладку так, чтобы центр масс оказался в заданной точке
+     * @param centerX, centerY - новая позиция центра масс
+     */
+    void center(float centerX, float centerY);
+
+    /**
+     * Масштабировать и сдвинуть раскладку так, чтобы она поместилась
+     * в прямоугольник (пропорции сохраняются)
+     * @param minX, minY, maxX, maxY - прямоугольник
+     */
+    void fitToRect(float minX, float minY, float maxX, float maxY);
+
+    /**
+     * Ограничить позиции вершин прямоугольником
+     * @param minX, minY, maxX, maxY - прямоугольник
+     */
+    void setBounds(float minX, float minY, float maxX, float maxY);
+
+    /**
+     * Снять ограничение позиций (раскладка на всей плоскости)
+     */
+    void clearBounds();
+
+    /**
+     * Получить координаты вершин
+     * @return массив X-координат
+     */
+    const std::vector<float>& getX() const;
+
+    /**
+     * Получить координаты вершин
+     * @return массив Y-координат
+     */
+    const std::vector<float>& getY() const;
+
+    /**
+     * Задать координаты вершин (скорости обнуляются)
+     * @param x - X-координаты
+     * @param y - Y-координаты
+     * @return true если размеры массивов совпадают с количеством вершин
+     */
+    bool setPositions(std::vector<float> x, std::vector<float> y);
+
+    /**
+     * Получить номер версии координат
+     * Увеличивается при любом изменении координат (шаг, центрирование,
+     * загрузка...), поэтому по нему можно понять, устарели ли данные,
+     * построенные по координатам (например, геометрия для отрисовки)
+     * @return номер версии
+     */
+    uint64_t getPositionsVersion() const;
+
+    /**
+     * Получить энергию последнего шага (сумма квадратов сил)
+     * @return энергия
+     */
+    float getEnergy() const;
+
+    /**
+     * Получить максимальное смещение вершины на последнем шаге
+     * @return смещение
+     */
+    float getMaxDisplacement() const;
+
+    /**
+     * Получить оптимальное расстояние между вершинами
+     * @return оптимальная длина ребра
+     */
+    float getOptimalDistance() const;
+
+    /**
+     * Сохранить граф вместе с текущими координатами вершин в бинарный файл
+     * @param filename - имя файла (формат BinaryGraphFormat)
+     * @return true если файл записан
+     */
+    bool saveLayout(const std::string& filename) const;
+
+    /**
+     * Загрузить координаты вершин из бинарного файла
+     * @param filename - имя файла, сохранённого saveLayout
+     * @return true если координаты загружены (количество вершин совпадает)
+     */
+    bool loadLayout(const std::string& filename);
+
+    /**
+     * Установить параметры force-directed алгоритма
+     */
+    void setRepulsionForce(float force);
+    void setAttractionForce(float force);
+    void setDamping(float d);
+    void setOptimalDistance(float distance);
+
+    /**
+     * Установить способ расчёта сил отталкивания
+     * @param mode - Exact, BarnesHut, Grid или Auto
+     */
+    void setRepulsionMode(RepulsionMode mode);
+
+    /**
+     * Установить угол раскрытия для Barnes-Hut
+     * @param theta - 0 даёт точный результат, 0.5-1.0 - обычный компромисс
+     */
+    void setBarnesHutTheta(float theta);
+
+    /**
+     * Установить радиус отсечения для режима Grid
+     * Ячейка сетки равна радиусу, поэтому перебираются только 3x3 соседние ячейки
+     * @param factor - радиус в долях optimalDistance (по умолчанию 2.0)
+     */
+    void setGridCutoffFactor(float factor);
+
+    /**
+     * Включить или выключить адаптивное охлаждение (схема Hu)
+     * Включено: вершина сдвигается на длину шага вдоль своей силы, длина шага
+     * подстраивается по изменению энергии. Выключено: скорость = сила * damping
+     * @param enabled - true для адаптивного охлаждения
+     */
+    void setAdaptiveCooling(bool enabled);
+
+    /**
+     * Установить порог сходимости
+     * @param tolerance - максимальное смещение за шаг в долях optimalDistance
+     */
+    void setConvergenceTolerance(float tolerance);
+
+    /**
+     * Установить количество потоков для расчёта раскладки
+     * Каждая вершина накапливает силы только в свои элементы массивов,
+     * поэтому результат не зависит от количества потоков и планирования
+     * @param numThreads - количество потоков (0 - по числу ядер)
+     */
+    void setThreadCount(int numThreads);
+
+    /**
+     * Количество вершин, начиная с которого режим Auto включает Barnes-Hut
+     */
+    static constexpr int BARNES_HUT_THRESHOLD = 1000;
+
+    /**
+     * Коэффициент изменения длины шага в схеме Hu
+     */
+    static constexpr float COOLING_FACTOR = 0.9f;
+
+    /**
+     * Многоуровневый режим огрубляет граф до этого количества вершин
+     */
+    static constexpr int MULTILEVEL_COARSEST_SIZE = 50;
+
+    /**
+     * Количество шагов раскладки самого грубого уровня
+     * (и верхняя граница шагов для остальных уровней)
+     */
+    static constexpr int MULTILEVEL_COARSEST_ITERATIONS = 300;
+
+    /**
+     * Работа (шагов x вершин), которую промежуточный уровень может потратить
+     * сверх refineIterations шагов: маленькие уровни получают больше шагов,
+     * большие - ровно refineIterations, поэтому все уровни вместе стоят
+     * не больше ~2 * refineIterations шагов на исходном графе
+     */
+    static constexpr int MULTILEVEL_LEVEL_WORK = 300000;
+};
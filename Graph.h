@@ -8,16 +8,360 @@
 #include <set>
 #include <queue>
 #include <stack>
+#include <memory>
+#include <cstdint>
+#include "ArrayView.h"
+#include "TraversalContext.h"
+
+/**
+ * Неизменяемое представление графа в формате CSR (compressed sparse row)
+ * Соседи вершины v лежат в neighbors[offsets[v] .. offsets[v + 1])
+ * Все списки смежности хранятся в одном массиве, без отдельной
+ * аллокации на каждую вершину
+ * Массивы либо принадлежат структуре (*Storage), либо лежат во внешней
+ * памяти (например, в отображённом бинарном файле), которую держит owner
+ * Отдельного списка рёбер нет: рёбра восстанавливаются из соседей (EdgeView)
+ */
+struct CSRStorage {
+    std::vector<int64_t> offsetStorage;               // Смещения (numVertices + 1)
+    std::vector<int> neighborStorage;                 // Соседи всех вершин подряд
+    
+    std::shared_ptr<const void> owner;                // Владелец внешней памяти (отображённый файл)
+    
+    const int64_t* offsets;                           // Указатель на смещения
+    const int* neighbors;                             // Указатель на соседей
+    size_t numEdges;                                  // Количество рёбер
+    
+    CSRStorage() : offsets(nullptr), neighbors(nullptr), numEdges(0) {}
+};
+
+/**
+ * Результат параллельного обхода в ширину
+ */
+struct BFSResult {
+    std::vector<int> order;     // Достижимые вершины по уровням (внутри уровня - по возрастанию номера)
+    std::vector<int> levels;    // Расстояние от стартовой вершины (-1 - недостижима)
+    std::vector<int> parents;   // Родитель в дереве BFS (для старта - сам старт, -1 - недостижима)
+};
+
+/**
+ * Результат обхода в глубину с временами входа и выхода
+ * Входы и выходы нумеруются одними часами (0..2k-1 для k посещённых вершин):
+ * u - предок v в дереве DFS, если discovery[u] < discovery[v] < finish[u]
+ */
+struct DFSResult {
+    std::vector<int> order;       // Вершины в порядке входа (как depthFirstSearch)
+    std::vector<int> discovery;   // Время входа в вершину (-1 - не посещена)
+    std::vector<int> finish;      // Время выхода из вершины (-1 - не посещена)
+    std::vector<int> parents;     // Родитель в дереве DFS (для корня - сам корень, -1 - не посещена)
+};
+
+/**
+ * Точки сочленения, мосты и компоненты двусвязности графа
+ */
+struct BiconnectedComponents {
+    std::vector<int> articulationPoints;              // Точки сочленения (по возрастанию)
+    std::vector<std::pair<int, int>> bridges;         // Мосты (меньшая вершина первой, по возрастанию)
+    std::vector<int> componentStart;                  // Начала компонент в componentEdges (k + 1)
+    std::vector<std::pair<int, int>> componentEdges;  // Рёбра всех компонент подряд
+
+    /**
+     * Получить количество компонент двусвязности
+     * @return количество компонент (мост - отдельная компонента из одного ребра)
+     */
+    int getComponentCount() const {
+        return componentStart.empty() ? 0 : static_cast<int>(componentStart.size()) - 1;
+    }
+
+    /**
+     * Получить рёбра компоненты двусвязности
+     * @param component - номер компоненты
+     * @return представление рёбер
+     */
+    ArrayView<std::pair<int, int>> getComponent(int component) const {
+        return ArrayView<std::pair<int, int>>(componentEdges.data() + componentStart[component],
+                                              static_cast<size_t>(componentStart[component + 1] - componentStart[component]));
+    }
+};
+
+/**
+ * Результат обхода в ширину из многих вершин (Graph::multiSourceBreadthFirstSearch)
+ * Матрица расстояний: строка i - уровни вершин в обходе из sources[i]
+ */
+struct MultiSourceBFSResult {
+    static constexpr int NARROW_BATCH = 64;    // Обходов в узкой пачке (одно слово на вершину)
+    static constexpr int WIDE_BATCH = 256;     // Обходов в широкой пачке (четыре слова на вершину)
+
+    std::vector<int> sources;     // Стартовые вершины (в порядке запроса)
+    int numVertices;              // Длина строки матрицы
+    std::vector<int> distances;   // sources.size() x numVertices по строкам (-1 - недостижима)
+
+    MultiSourceBFSResult() : numVertices(0) {}
+
+    /**
+     * Уровни вершин в обходе из sources[source] (как BFSResult::levels)
+     * @param source - номер стартовой вершины в sources
+     * @return представление строки матрицы
+     */
+    ArrayView<int> levels(int source) const {
+        return ArrayView<int>(distances.data() + static_cast<size_t>(source) * numVertices,
+                              static_cast<size_t>(numVertices));
+    }
+
+    /**
+     * Расстояние от sources[source] до вершины
+     * @param source - номер стартовой вершины в sources
+     * @param vertex - вершина
+     * @return количество рёбер кратчайшего пути (-1 - недостижима)
+     */
+    int distance(int source, int vertex) const {
+        return distances[static_cast<size_t>(source) * numVertices + vertex];
+    }
+};
+
+/**
+ * Разметка вершин по компонентам связности
+ */
+struct ComponentLabels {
+    std::vector<int> labels;    // Номер компоненты каждой вершины (0..k-1, по возрастанию минимальной вершины)
+    std::vector<int> sizes;     // Количество вершин в каждой компоненте
+};
+
+/**
+ * Способ перенумерации вершин (Graph::computeOrdering)
+ * Соседние в графе вершины получают близкие номера, поэтому списки
+ * смежности и массивы координат читаются почти последовательно
+ */
+enum class VertexOrdering {
+    ReverseCuthillMcKee,  // Обратный Катхилл-Макки: минимальная ширина ленты матрицы смежности
+    Degree,               // По убыванию степени: "тяжёлые" вершины в начале массивов
+    BreadthFirst,         // Порядок обхода в ширину
+    Rabbit                // Сообщества (приближение Rabbit order): вершина сообщества - подряд
+};
+
+/**
+ * Перестановка вершин: новый номер вершины и обратное соответствие
+ */
+struct VertexPermutation {
+    std::vector<int> newToOld;    // Старый номер вершины с новым номером i
+    std::vector<int> oldToNew;    // Новый номер вершины со старым номером v
+
+    VertexPermutation() {}
+
+    /**
+     * Создать перестановку по новому порядку вершин
+     * @param order - старые номера вершин в новом порядке
+     */
+    explicit VertexPermutation(std::vector<int> order) : newToOld(std::move(order)), oldToNew(newToOld.size(), -1) {
+        for (size_t i = 0; i < newToOld.size(); i++) {
+            int v = newToOld[i];
+            if (v >= 0 && static_cast<size_t>(v) < oldToNew.size()) oldToNew[v] = static_cast<int>(i);
+        }
+    }
+
+    /**
+     * Проверить, что это перестановка numVertices вершин
+     * @param numVertices - количество вершин
+     * @return true если каждая вершина встречается ровно один раз
+     */
+    bool isValid(int numVertices) const {
+        if (newToOld.size() != static_cast<size_t>(numVertices)) return false;
+        for (int i = 0; i < numVertices; i++) {
+            if (oldToNew[i] < 0 || newToOld[oldToNew[i]] != i) return false;
+        }
+        return true;
+    }
+
+    /**
+     * Переставить массив данных вершин (координаты, цвета...) в новый порядок
+     * @param data - данные по старым номерам
+     * @return данные по новым номерам
+     */
+    template <typename T>
+    std::vector<T> apply(const std::vector<T>& data) const {
+        std::vector<T> result(newToOld.size());
+        for (size_t i = 0; i < newToOld.size(); i++) result[i] = data[newToOld[i]];
+        return result;
+    }
+
+    /**
+     * Вернуть массив данных вершин в исходный порядок
+     * @param data - данные по новым номерам
+     * @return данные по старым номерам
+     */
+    template <typename T>
+    std::vector<T> restore(const std::vector<T>& data) const {
+        std::vector<T> result(oldToNew.size());
+        for (size_t i = 0; i < newToOld.size(); i++) result[newToOld[i]] = data[i];
+        return result;
+    }
+};
+
+/**
+ * Представление списка соседей вершины (работает и для списков, и для CSR)
+ */
+typedef ArrayView<int> NeighborView;
+
+/**
+ * Представление списка рёбер графа (не владеет данными, копируется дёшево)
+ * Либо непрерывный массив пар (рёбра незамороженного графа или аргумент
+ * fromEdgeList), либо рёбра, восстановленные из CSR на ходу, без второй
+ * копии рёбер рядом с соседями: ребро (u, v) - запись v в списке u при
+ * u < v, петля (u, u) - первая из двух записей u в списке u.
+ * Рёбра CSR идут по возрастанию меньшего конца, меньший конец - первым.
+ */
+class EdgeView {
+public:
+    /**
+     * Итератор рёбер (только для чтения, ребро возвращается по значению)
+     */
+    class Iterator {
+    private:
+        const std::pair<int, int>* pairs;   // Массив пар (nullptr - рёбра из CSR)
+        const int64_t* offsets;             // Смещения CSR
+        const int* neighbors;               // Соседи CSR
+        int numVertices;                    // Количество вершин CSR
+        int vertex;                         // Текущая вершина (меньший конец ребра)
+        int64_t position;                   // Индекс в массиве пар или в neighbors
+        bool loopOpen;                      // Первая запись петли уже выдана
+
+        // Сдвинуться до ближайшей записи, которая является ребром
+        void settle() {
+            while (vertex < numVertices) {
+                if (position == offsets[vertex + 1]) {
+                    vertex++;
+                    loopOpen = false;
+                    continue;
+                }
+                int v = neighbors[position];
+                if (v > vertex) return;
+                if (v == vertex) {
+                    // Петля хранится двумя записями: выдаём первую, пропускаем вторую
+                    loopOpen = !loopOpen;
+                    if (loopOpen) return;
+                }
+                position++;
+            }
+        }
+
+    public:
+        Iterator(const std::pair<int, int>* data, int64_t index)
+            : pairs(data), offsets(nullptr), neighbors(nullptr), numVertices(0),
+              vertex(0), position(index), loopOpen(false) {}
+
+        Iterator(const int64_t* csrOffsets, const int* csrNeighbors, int vertices, int start)
+            : pairs(nullptr), offsets(csrOffsets), neighbors(csrNeighbors), numVertices(vertices),
+              vertex(start), position(csrOffsets[start]), loopOpen(false) {
+            settle();
+        }
+
+        std::pair<int, int> operator*() const {
+            return pairs ? pairs[position] : std::pair<int, int>(vertex, neighbors[position]);
+        }
+
+        Iterator& operator++() {
+            position++;
+            if (!pairs) settle();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return position == other.position; }
+        bool operator!=(const Iterator& other) const { return position != other.position; }
+    };
+
+private:
+    const std::pair<int, int>* pairs;   // Массив пар (nullptr - рёбра из CSR)
+    const int64_t* offsets;             // Смещения CSR
+    const int* neighbors;               // Соседи CSR
+    int numVertices;                    // Количество вершин CSR
+    size_t count;                       // Количество рёбер
+
+public:
+    /**
+     * Пустое представление
+     */
+    EdgeView() : pairs(nullptr), offsets(nullptr), neighbors(nullptr), numVertices(0), count(0) {}
+
+    /**
+     * Представление массива пар
+     * @param data - указатель на первое ребро
+     * @param size - количество рёбер
+     */
+    EdgeView(const std::pair<int, int>* data, size_t size)
+        : pairs(data), offsets(nullptr), neighbors(nullptr), numVertices(0), count(size) {}
+
+    /**
+     * Представление вектора пар
+     * @param v - вектор (должен жить дольше представления)
+     */
+    EdgeView(const std::vector<std::pair<int, int>>& v)
+        : pairs(v.data()), offsets(nullptr), neighbors(nullptr), numVertices(0), count(v.size()) {}
+
+    /**
+     * Представление рёбер CSR
+     * @param csr - CSR-представление (должно жить дольше представления)
+     * @param vertices - количество вершин
+     */
+    EdgeView(const CSRStorage& csr, int vertices)
+        : pairs(nullptr), offsets(csr.offsets), neighbors(csr.neighbors), numVertices(vertices), count(csr.numEdges) {}
+
+    Iterator begin() const {
+        return pairs || !offsets ? Iterator(pairs, 0) : Iterator(offsets, neighbors, numVertices, 0);
+    }
+    Iterator end() const {
+        return pairs || !offsets ? Iterator(pairs, static_cast<int64_t>(count)) : Iterator(offsets, neighbors, numVertices, numVertices);
+    }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
 
 /**
  * Класс Graph - представление неориентированного графа
  * Использует список смежности для хранения рёбер
+ * После вызова freeze() граф становится неизменяемым и хранится в формате CSR
  */
 class Graph {
 private:
     int numVertices;                              // Количество вершин
     std::vector<std::vector<int>> adjList;        // Список смежности
     std::vector<std::pair<int, int>> edges;       // Список рёбер для визуализации
+    std::shared_ptr<const CSRStorage> csr;        // CSR-представление (после freeze)
+    bool deferredInsert;                          // Режим пакетной вставки (без проверки дублей)
+    mutable std::shared_ptr<const ComponentLabels> componentCache;  // Кэш компонент связности
+    
+    // Система непересекающихся множеств, которая обновляется в addEdge
+    // (связность и число компонент доступны без обхода графа)
+    std::vector<int> connectivityParent;          // Родитель вершины в лесу union-find
+    std::vector<int> connectivitySize;            // Размер множества (для корней)
+    int connectivityComponents;                   // Текущее количество компонент
+    bool connectivityValid;                       // false после удаления рёбер / пакетной сборки
+    std::vector<int> originalIds;                 // Исходные номера вершин после relabel (пусто - совпадают)
+
+    /**
+     * Сбросить кэш компонент связности (вызывается при изменении рёбер)
+     */
+    void invalidateComponents();
+
+    /**
+     * Найти корень множества вершины (со сжатием пути)
+     * @param vertex - вершина
+     * @return корень множества
+     */
+    int findConnectivityRoot(int vertex);
+
+    /**
+     * Объединить множества концов нового ребра (O(α(n)) амортизированно)
+     * Если структура устарела, она сначала перестраивается
+     * @param u - первая вершина
+     * @param v - вторая вершина
+     */
+    void uniteConnectivity(int u, int v);
+
+    /**
+     * Построить разметку компонент из union-find за O(V)
+     * @return разметка компонент
+     */
+    std::shared_ptr<const ComponentLabels> labelsFromConnectivity() const;
 
 public:
     /**
@@ -33,6 +377,67 @@ public:
      */
     void addEdge(int u, int v);
 
+    /**
+     * Удалить ребро между вершинами u и v
+     * Стоимость: O(deg(u) + deg(v) + E) на само удаление (список рёбер
+     * сохраняет порядок). Удаление может разбить компоненту, поэтому
+     * union-find помечается устаревшим: запросы связности до следующего
+     * addEdge отвечают по параллельному пересчёту за O(V + E) (один раз,
+     * затем из кэша), а первый addEdge после пакета удалений перестраивает
+     * union-find за O(V + E). Таким образом пакет удалений стоит один пересчёт.
+     * @param u - первая вершина
+     * @param v - вторая вершина
+     * @return true если ребро было и удалено
+     */
+    bool removeEdge(int u, int v);
+
+    /**
+     * Перестроить union-find по текущему списку рёбер за O(V + E)
+     * После этого связность снова поддерживается инкрементально
+     */
+    void rebuildConnectivity();
+
+    /**
+     * Включить режим пакетной вставки
+     * В этом режиме addEdge работает за O(1): ребро только дописывается
+     * в список рёбер, проверка дублей и построение списков смежности
+     * откладываются до finalize(). До вызова finalize() списки смежности
+     * и алгоритмы обхода не видят добавленные рёбра.
+     */
+    void beginBulkInsert();
+
+    /**
+     * Завершить пакетную вставку
+     * Удаляет дубли (включая пары (u, v) / (v, u)) за O(E log E)
+     * и перестраивает списки смежности. Результат совпадает с тем,
+     * который дали бы последовательные вызовы addEdge.
+     */
+    void finalize();
+
+    /**
+     * Построить граф сразу из списка рёбер
+     * Рёбра проверяются, сортируются и очищаются от дублей за один проход,
+     * затем граф сразу упаковывается в CSR (результат заморожен)
+     * @param vertices - количество вершин
+     * @param edgeList - список рёбер (вектор пар или любое представление EdgeView)
+     * @return замороженный граф
+     */
+    static Graph fromEdgeList(int vertices, EdgeView edgeList);
+
+    /**
+     * Перевести граф в неизменяемый формат CSR
+     * Списки смежности упаковываются в два непрерывных массива,
+     * память списков освобождается. После этого addEdge недоступен.
+     * Порядок соседей каждой вершины сохраняется.
+     */
+    void freeze();
+
+    /**
+     * Проверить, переведён ли граф в формат CSR
+     * @return true если граф заморожен
+     */
+    bool isFrozen() const;
+
     /**
      * Получить количество вершин
      * @return количество вершин
@@ -42,15 +447,23 @@ public:
     /**
      * Получить список смежности для вершины
      * @param vertex - номер вершины
-     * @return вектор смежных вершин
+     * @return представление смежных вершин (действительно, пока жив граф)
      */
-    const std::vector<int>& getAdjList(int vertex) const;
+    NeighborView getAdjList(int vertex) const;
 
     /**
      * Получить все рёбра графа
-     * @return вектор пар вершин (рёбер)
+     * У замороженного графа рёбра восстанавливаются из CSR при обходе
+     * (меньший конец первым, по возрастанию меньшего конца)
+     * @return представление пар вершин (рёбер)
+     */
+    EdgeView getEdges() const;
+
+    /**
+     * Получить CSR-представление графа
+     * @return указатель на CSR или nullptr, если граф не заморожен
      */
-    const std::vector<std::pair<int, int>>& getEdges() const;
+    const CSRStorage* getCSR() const;
 
     /**
      * Получить степень вершины
@@ -66,6 +479,33 @@ public:
      */
     std::vector<int> depthFirstSearch(int start) const;
 
+    /**
+     * Обход графа в глубину (DFS) без выделения памяти
+     * (отметки, стек и результат берутся из контекста)
+     * @param start - начальная вершина
+     * @param context - рабочая память (переиспользуется между вызовами)
+     * @return вершины в порядке обхода (context.getOrder(), до следующего обхода)
+     */
+    const std::vector<int>& depthFirstSearch(int start, TraversalContext& context) const;
+
+    /**
+     * Обход в глубину с временами входа и выхода и деревом обхода
+     * Итеративный (стек - путь от корня, не длиннее числа вершин), поэтому
+     * не переполняет стек вызовов на графах с миллионами вершин
+     * @param start - начальная вершина; -1 - лес обходов из всех вершин
+     *                (корни - по возрастанию номера)
+     * @return порядок обхода, времена и родители (пустой, если start неверна)
+     */
+    DFSResult depthFirstSearchTree(int start) const;
+
+    /**
+     * Найти точки сочленения, мосты и компоненты двусвязности
+     * (алгоритм Хопкрофта-Тарьяна за один итеративный обход в глубину, O(V + E))
+     * Петли пропускаются. Изолированная вершина не входит ни в одну компоненту
+     * @return точки сочленения, мосты и рёбра компонент
+     */
+    BiconnectedComponents getBiconnectedComponents() const;
+
     /**
      * Обход графа в ширину (BFS)
      * @param start - начальная вершина
@@ -73,33 +513,194 @@ public:
      */
     std::vector<int> breadthFirstSearch(int start) const;
 
+    /**
+     * Обход графа в ширину (BFS) без выделения памяти
+     * (очередью служит сам результат обхода)
+     * @param start - начальная вершина
+     * @param context - рабочая память (переиспользуется между вызовами)
+     * @return вершины в порядке обхода (context.getOrder(), до следующего обхода)
+     */
+    const std::vector<int>& breadthFirstSearch(int start, TraversalContext& context) const;
+
+    /**
+     * Параллельный обход в ширину с переключением направления (Beamer)
+     * Небольшие фронты обрабатываются сверху вниз (от фронта к соседям),
+     * большие - снизу вверх (каждая непосещённая вершина ищет соседа во
+     * фронте, фронт хранится битовой картой). Работает по CSR; если граф
+     * не заморожен, CSR строится на временной копии.
+     * @param start - начальная вершина
+     * @param numThreads - количество потоков (0 - общий пул на все ядра)
+     * @return порядок обхода, уровни и родители вершин
+     */
+    BFSResult parallelBreadthFirstSearch(int start, int numThreads = 0) const;
+
+    /**
+     * Обход в ширину сразу из многих вершин (MS-BFS)
+     * Источники обходятся пачками по 256 (остаток до 64 - узкой пачкой):
+     * у каждой вершины - битовое множество обходов, и один просмотр списка
+     * соседей продвигает все обходы пачки. Направление шага выбирается
+     * как в parallelBreadthFirstSearch; шаги снизу вверх - на всех ядрах.
+     * Выигрыш - на графах с малым диаметром (Эрдёш-Реньи, Барабаши-Альберт,
+     * социальные сети): фронты обходов совпадают, и рёбра читаются один раз
+     * на пачку. На решётках и длинных циклах фронты разных источников почти
+     * не пересекаются, и отдельные обходы breadthFirstSearch быстрее.
+     * Работает по CSR; если граф не заморожен, CSR строится на временной копии.
+     * @param sources - стартовые вершины (могут повторяться)
+     * @param numThreads - количество потоков (0 - общий пул на все ядра)
+     * @return матрица расстояний (пустая, если есть неверная вершина)
+     */
+    MultiSourceBFSResult multiSourceBreadthFirstSearch(const std::vector<int>& sources, int numThreads = 0) const;
+
+    /**
+     * Полувнешний обход в ширину по файлу рёбер, который не помещается в память
+     * В памяти - только уровни вершин (O(V)); рёбра читаются последовательными
+     * проходами по файлу (см. EdgeStream). Каждый проход уменьшает уровни
+     * по всем рёбрам: level[v] = min(level[v], level[u] + 1), поэтому за
+     * проход фронт может продвинуться на несколько рёбер (если рёбра в файле
+     * идут вдоль путей). Обход заканчивается проходом без изменений;
+     * проходов не больше эксцентриситета стартовой вершины + 1
+     * @param filename - имя файла (текстовый формат loadFromFile или бинарный)
+     * @param start - начальная вершина
+     * @param numThreads - количество потоков (0 - общий пул на все ядра)
+     * @param reportErrors - выводить ли ошибки формата строк в cerr (false, если
+     *                       файл уже прочитан streamConnectedComponents с выводом)
+     * @return уровни вершин, как BFSResult::levels (пустой, если файл не прочитан)
+     */
+    static std::vector<int> streamBreadthFirstSearch(const std::string& filename, int start, int numThreads = 0,
+                                                     bool reportErrors = true);
+
     /**
      * Проверка связности графа
+     * Пока union-find актуален - O(1), иначе используется кэшированная
+     * разметка компонент (см. getComponentLabels)
      * @return true если граф связный, false иначе
      */
     bool isConnected() const;
 
     /**
      * Получить компоненты связности
-     * @return вектор компонент связности (каждая компонента - вектор вершин)
+     * Строится из разметки компонент за O(V) без обхода графа
+     * @return вектор компонент связности (каждая компонента - вектор вершин
+     *         по возрастанию; компоненты - по возрастанию минимальной вершины)
      */
     std::vector<std::vector<int>> getConnectedComponents() const;
 
+    /**
+     * Получить компоненты связности без выделения памяти на каждую компоненту
+     * Все компоненты лежат в контексте одним массивом (порядок тот же,
+     * что у getConnectedComponents), см. TraversalContext::getComponent
+     * @param context - рабочая память (переиспользуется между вызовами)
+     * @return количество компонент
+     */
+    int getConnectedComponents(TraversalContext& context) const;
+
+    /**
+     * Получить разметку вершин по компонентам связности
+     * Если union-find, поддерживаемый addEdge, актуален, разметка
+     * строится из него за O(V). Иначе считается параллельно за один проход
+     * по массиву рёбер с помощью неблокирующего union-find на CAS.
+     * Результат кэшируется до следующего изменения рёбер.
+     * @param numThreads - количество потоков (0 - общий пул на все ядра)
+     * @return разметка (общий неизменяемый объект)
+     */
+    std::shared_ptr<const ComponentLabels> getComponentLabels(int numThreads = 0) const;
+
+    /**
+     * Найти компоненты связности файла рёбер, который не помещается в память
+     * Файл читается один раз последовательно блоками (см. EdgeStream), рёбра
+     * объединяются неблокирующим union-find прямо в потоках разбора. В памяти -
+     * только union-find (O(V)) и два блока файла; граф не строится
+     * @param filename - имя файла (текстовый формат loadFromFile или бинарный)
+     * @param numThreads - количество потоков (0 - общий пул на все ядра)
+     * @return разметка, как у getComponentLabels (пустая, если файл не прочитан)
+     */
+    static ComponentLabels streamConnectedComponents(const std::string& filename, int numThreads = 0);
+
+    /**
+     * Получить количество компонент связности
+     * Пока union-find актуален - O(1)
+     * @return количество компонент (0 для пустого графа)
+     */
+    int getComponentCount() const;
+
+    /**
+     * Вычислить перенумерацию вершин для локальности памяти
+     * ReverseCuthillMcKee, Degree и BreadthFirst - O(V + E) (RCM ещё
+     * сортирует соседей по степени); Rabbit - один проход по вершинам
+     * в порядке возрастания степени со слиянием в соседнее сообщество
+     * с наибольшим приростом модулярности, затем обход дерева слияний
+     * (приближение: списки смежности сообществ не объединяются)
+     * @param ordering - способ перенумерации
+     * @return перестановка вершин
+     */
+    VertexPermutation computeOrdering(VertexOrdering ordering) const;
+
+    /**
+     * Построить граф с перенумерованными вершинами
+     * Вершина newToOld[i] получает номер i; списки соседей упорядочены
+     * по новым номерам, результат заморожен (CSR). Исходные номера
+     * сохраняются (см. getOriginalId) и переживают повторную перенумерацию.
+     * Координаты раскладки переставляются через VertexPermutation::apply
+     * @param permutation - перестановка (например, из computeOrdering)
+     * @return новый граф; пустой граф, если перестановка неверна
+     */
+    Graph relabel(const VertexPermutation& permutation) const;
+
+    /**
+     * Получить исходный номер вершины (до relabel) - для вывода и подписей
+     * @param vertex - номер вершины
+     * @return номер вершины во входных данных
+     */
+    int getOriginalId(int vertex) const;
+
+    /**
+     * Получить исходные номера всех вершин
+     * @return исходные номера (пусто, если граф не перенумерован)
+     */
+    const std::vector<int>& getOriginalIds() const;
+
     /**
      * Загрузить граф из файла
      * Формат файла:
-     * Первая строка: количество вершин
-     * Последующие строки: пары вершин (рёбра)
+     * Первое число: количество вершин
+     * Далее: номера вершин, попарно образующие рёбра (обычно по паре на
+     * строку; как и при чтении оператором >>, важны только числа, а не строки)
+     * Файл отображается в память и разбирается на нескольких потоках.
+     * Некорректные слова и рёбра пропускаются, о каждом сообщается в
+     * std::cerr с номером строки и смещением в байтах.
+     * @param filename - имя файла
+     * @param numThreads - количество потоков разбора (0 - по числу ядер)
+     * @return замороженный (CSR) граф; пустой граф, если файл не прочитан
+     */
+    static Graph loadFromFile(const std::string& filename, int numThreads = 0);
+
+    /**
+     * Сохранить граф в файл (текстовый формат loadFromFile)
+     * @param filename - имя файла
+     * @return true если файл записан
+     */
+    bool saveToFile(const std::string& filename) const;
+
+    /**
+     * Открыть граф из бинарного файла (см. BinaryGraphFormat.h)
+     * Файл отображается в память, массивы CSR используются напрямую
+     * без копирования. По умолчанию содержимое проверяется за O(V + E)
+     * (смещения не убывают, соседи и концы рёбер - в диапазоне), чтобы
+     * испорченный файл не приводил к чтению за пределами массивов;
+     * для доверенных файлов (только что записанных saveBinary) проверку
+     * можно отключить - тогда открытие занимает миллисекунды
      * @param filename - имя файла
-     * @return true если загрузка успешна, false иначе
+     * @param validate - проверять содержимое массивов
+     * @return замороженный граф; пустой граф, если файл некорректен
      */
-    static Graph loadFromFile(const std::string& filename);
+    static Graph openBinary(const std::string& filename, bool validate = true);
 
     /**
-     * Сохранить граф в файл
+     * Сохранить граф в бинарный файл (без координат вершин)
      * @param filename - имя файла
+     * @return true если файл записан
      */
-    void saveToFile(const std::string& filename) const;
+    bool saveBinary(const std::string& filename) const;
 
     /**
      * Вывести информацию о графе
@@ -0,0 +1,295 @@
+// Подключаем заголовочный файл парсера списка рёбер
+#include "EdgeListParser.h"
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем библиотеку для алгоритмов (min)
+#include <algorithm>
+// Подключаем быстрый разбор чисел без локали (from_chars)
+#include <charconv>
+// Подключаем поиск символа в памяти (memchr)
+#include <cstring>
+// Подключаем потоки
+#include <thread>
+
+// Вспомогательные функции разбора
+namespace {
+
+// Участки меньше этого размера не делим между потоками
+const size_t MIN_CHUNK_BYTES = 1 << 20;
+
+// Пробельный символ (как у оператора >>): разделяет числа
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Найти конец строки (позицию '\n' или конец текста)
+inline const char* findLineEnd(const char* p, const char* end) {
+    const void* found = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+// Прочитать слово [begin, end) как целое число
+// Как и оператор >>, допускается знак '+'; слово должно быть числом целиком
+inline bool parseNumber(const char* begin, const char* end, int& value) {
+    if (end - begin > 1 && *begin == '+' && begin[1] != '-') begin++;
+    auto parsed = std::from_chars(begin, end, value);
+    return parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+// Запомнить ошибку (подробно - только первые MAX_STORED_ERRORS)
+void addError(EdgeChunk& out, size_t offset, size_t line, const char* message) {
+    out.errorCount++;
+    if (out.errors.size() < EdgeListParser::MAX_STORED_ERRORS) {
+        out.errors.push_back({offset, line, message});
+    }
+}
+
+} // namespace
+
+// Функция чтения количества вершин (первое число текста)
+bool EdgeListParser::parseHeader(const char* data, size_t size, int& numVertices, size_t& bodyOffset, ParseError& error) {
+    const char* end = data + size;
+    const char* p = data;
+    size_t line = 1;
+    
+    // Пропускаем пробелы и пустые строки в начале файла (как это делает оператор >>)
+    while (p < end && isSpace(*p)) {
+        if (*p == '\n') line++;
+        p++;
+    }
+    
+    // В файле нет ни одного слова (в том числе файл нулевой длины)
+    if (p == end) {
+        error = {static_cast<size_t>(p - data), line, "файл пуст: нет количества вершин"};
+        return false;
+    }
+    
+    // Читаем количество вершин (первое слово)
+    const char* wordEnd = p;
+    while (wordEnd < end && !isSpace(*wordEnd)) wordEnd++;
+    int value = 0;
+    if (p == wordEnd || !parseNumber(p, wordEnd, value) || value < 0) {
+        error = {static_cast<size_t>(p - data), line, "ожидалось количество вершин"};
+        return false;
+    }
+    
+    // Рёбра начинаются сразу после числа (возможно, в той же строке)
+    numVertices = value;
+    bodyOffset = static_cast<size_t>(wordEnd - data);
+    return true;
+}
+
+// Функция разбора участка текста из целых строк
+// Числа читаются подряд, независимо от строк, и попарно образуют рёбра
+void EdgeListParser::parseChunk(const char* begin, const char* end, size_t baseOffset, int numVertices, EdgeChunk& out,
+                                const PendingVertex* carry) {
+    // Первая половина текущей пары (из предыдущего участка или этого)
+    PendingVertex pending;
+    bool pendingCarried = carry && carry->present;
+    if (pendingCarried) pending = *carry;
+    size_t line = 1;
+    const char* p = begin;
+    
+    while (true) {
+        // Пропускаем пробельные символы, считая строки
+        while (p < end && isSpace(*p)) {
+            if (*p == '\n') line++;
+            p++;
+        }
+        if (p >= end) break;
+        
+        // Очередное слово: обычно это число, и from_chars сразу находит его конец
+        const char* wordStart = p;
+        size_t offset = baseOffset + static_cast<size_t>(wordStart - begin);
+        int value = 0;
+        auto parsed = std::from_chars(p, end, value);
+        bool isNumber = parsed.ec == std::errc() && (parsed.ptr == end || isSpace(*parsed.ptr));
+        if (isNumber) {
+            p = parsed.ptr;
+        } else {
+            // Редкий случай ('+' перед числом или не число) - слово целиком
+            while (p < end && !isSpace(*p)) p++;
+            isNumber = parseNumber(wordStart, p, value);
+        }
+        
+        // Не число - ошибка; начатая пара отбрасывается, следующее число начинает новую
+        if (!isNumber) {
+            addError(out, offset, line, pending.present ? "ожидался номер вершины (пара \"u v\" не закончена)"
+                                                        : "ожидался номер вершины");
+            pending.present = false;
+            out.reset = true;
+            out.tokenCount = 0;
+            continue;
+        }
+        out.tokenCount++;
+        out.last.present = true;
+        out.last.value = value;
+        out.last.offset = offset;
+        out.last.line = line;
+        
+        // Первая половина ребра - запоминаем
+        if (!pending.present) {
+            pending = out.last;
+            pendingCarried = false;
+            continue;
+        }
+        pending.present = false;
+        
+        // Проверяем диапазон номеров вершин; ошибка указывает на начало пары
+        // (строка - текущая, если пара началась в предыдущем участке)
+        int u = pending.value;
+        if (u < 0 || u >= numVertices || value < 0 || value >= numVertices) {
+            addError(out, pending.offset, pendingCarried ? line : pending.line, "номер вершины вне диапазона");
+            continue;
+        }
+        
+        out.edges.push_back({u, value});
+    }
+    
+    // Строки участка: переводы строк плюс незаконченная последняя строка
+    out.lineCount = end > begin ? line - 1 + (end[-1] != '\n' ? 1 : 0) : 0;
+}
+
+// Функция связывания независимо разобранных участков
+std::vector<int> EdgeListParser::linkChunks(const std::vector<EdgeChunk>& chunks, int count, size_t firstLine,
+                                            PendingVertex& carry, std::vector<PendingVertex>& carries) {
+    std::vector<int> redo;
+    carries.assign(count, PendingVertex());
+    size_t linesBefore = firstLine;
+    for (int c = 0; c < count; c++) {
+        const EdgeChunk& chunk = chunks[c];
+        carries[c] = carry;
+        if (carry.present) redo.push_back(c);
+        
+        // Остаётся ли число без пары в конце участка: после нечислового
+        // слова чётность не зависит от начала участка
+        bool oddTokens = chunk.tokenCount % 2 == 1;
+        bool open = chunk.reset ? oddTokens : (carry.present != oddTokens);
+        if (!open) {
+            carry = PendingVertex();
+        } else if (chunk.reset || chunk.tokenCount > 0) {
+            carry = chunk.last;
+            carry.line += linesBefore;
+        }
+        // Участок без чисел пропускает половину пары дальше без изменений
+        linesBefore += chunk.lineCount;
+    }
+    return redo;
+}
+
+// Функция записи ошибки "число без пары"
+void EdgeListParser::addUnpairedError(const PendingVertex& carry, ParsedEdgeList& result) {
+    result.errorCount++;
+    if (result.errors.size() < MAX_STORED_ERRORS) {
+        result.errors.push_back({carry.offset, carry.line, "у номера вершины нет пары (нечётное количество номеров)"});
+    }
+}
+
+// Функция параллельного разбора всего текста
+bool EdgeListParser::parse(const char* data, size_t size, int numThreads, ParsedEdgeList& result) {
+    // Читаем первую строку
+    size_t bodyOffset = 0;
+    ParseError headerError;
+    if (!parseHeader(data, size, result.numVertices, bodyOffset, headerError)) {
+        result.errors.push_back(headerError);
+        result.errorCount = 1;
+        return false;
+    }
+    
+    // Количество строк до строки, в которой начинаются рёбра
+    size_t headerLines = static_cast<size_t>(std::count(data, data + bodyOffset, '\n'));
+    
+    // Выбираем количество потоков: не больше ядер и не меньше мегабайта на поток
+    size_t bodySize = size - bodyOffset;
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    size_t maxChunks = std::max<size_t>(1, bodySize / MIN_CHUNK_BYTES);
+    int chunkCount = static_cast<int>(std::min<size_t>(numThreads, maxChunks));
+    
+    // Делим текст на участки; каждая граница сдвигается вперёд к началу строки
+    const char* bodyBegin = data + bodyOffset;
+    const char* end = data + size;
+    std::vector<const char*> bounds(chunkCount + 1);
+    bounds[0] = bodyBegin;
+    for (int c = 1; c < chunkCount; c++) {
+        const char* guess = bodyBegin + bodySize / chunkCount * c;
+        guess = std::max(guess, bounds[c - 1]);
+        const char* lineEnd = findLineEnd(guess, end);
+        bounds[c] = lineEnd < end ? lineEnd + 1 : end;
+    }
+    bounds[chunkCount] = end;
+    
+    // Разбираем участки параллельно (первый - в текущем потоке)
+    std::vector<EdgeChunk> chunks(chunkCount);
+    std::vector<std::thread> workers;
+    for (int c = 1; c < chunkCount; c++) {
+        workers.emplace_back([&, c]() {
+            parseChunk(bounds[c], bounds[c + 1], static_cast<size_t>(bounds[c] - data),
+                       result.numVertices, chunks[c]);
+        });
+    }
+    parseChunk(bounds[0], bounds[1], bodyOffset, result.numVertices, chunks[0]);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    // Участки, которые начинаются с середины пары, разбираем заново
+    PendingVertex carry;
+    std::vector<PendingVertex> carries;
+    std::vector<int> redo = linkChunks(chunks, chunkCount, headerLines, carry, carries);
+    workers.clear();
+    for (size_t r = 1; r < redo.size(); r++) {
+        workers.emplace_back([&, r]() {
+            int c = redo[r];
+            chunks[c].clear();
+            parseChunk(bounds[c], bounds[c + 1], static_cast<size_t>(bounds[c] - data),
+                       result.numVertices, chunks[c], &carries[c]);
+        });
+    }
+    if (!redo.empty()) {
+        int c = redo[0];
+        chunks[c].clear();
+        parseChunk(bounds[c], bounds[c + 1], static_cast<size_t>(bounds[c] - data),
+                   result.numVertices, chunks[c], &carries[c]);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    // Склеиваем рёбра в порядке файла и переводим номера строк в абсолютные
+    size_t totalEdges = 0;
+    for (const auto& chunk : chunks) {
+        totalEdges += chunk.edges.size();
+    }
+    result.edges.reserve(totalEdges);
+    size_t linesBefore = headerLines;
+    for (auto& chunk : chunks) {
+        result.edges.insert(result.edges.end(), chunk.edges.begin(), chunk.edges.end());
+        std::vector<std::pair<int, int>>().swap(chunk.edges);
+        for (auto& error : chunk.errors) {
+            if (result.errors.size() < MAX_STORED_ERRORS) {
+                error.line += linesBefore;
+                result.errors.push_back(error);
+            }
+        }
+        result.errorCount += chunk.errorCount;
+        linesBefore += chunk.lineCount;
+    }
+    // Последнему числу файла не хватило пары
+    if (carry.present) addUnpairedError(carry, result);
+    return true;
+}
+
+// Функция вывода ошибок разбора
+void EdgeListParser::reportErrors(const std::string& filename, const ParsedEdgeList& parsed, size_t maxShown) {
+    size_t shown = std::min(maxShown, parsed.errors.size());
+    for (size_t i = 0; i < shown; i++) {
+        const ParseError& error = parsed.errors[i];
+        std::cerr << "Ошибка формата в " << filename << " (строка " << error.line
+                  << ", байт " << error.offset << "): " << error.message << std::endl;
+    }
+    if (parsed.errorCount > shown) {
+        std::cerr << "... и ещё " << (parsed.errorCount - shown) << " ошибок формата" << std::endl;
+    }
+}
@@ -0,0 +1,309 @@
+// Подключаем потоковое чтение списка рёбер
+#include "EdgeStream.h"
+// Подключаем разбор текстового формата
+#include "EdgeListParser.h"
+// Подключаем бинарный формат графа (заголовок и секция рёбер)
+#include "BinaryGraphFormat.h"
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем библиотеку для чтения файла
+#include <fstream>
+// Подключаем библиотеку для алгоритмов (min, max, count)
+#include <algorithm>
+// Подключаем функции работы с памятью (memcpy, memchr)
+#include <cstring>
+// Подключаем поток чтения
+#include <thread>
+
+// Вспомогательные функции потокового чтения
+namespace {
+
+// Часть текстового блока на один участок разбора не меньше мегабайта
+// (как у EdgeListParser::parse), участков - до 4 на поток пула
+const size_t MIN_PIECE_BYTES = 1 << 20;
+const int PIECES_PER_THREAD = 4;
+
+// Сколько байт начала файла читается для поиска количества вершин
+const size_t HEADER_BYTES = 1 << 16;
+
+// Порция бинарных рёбер для параллельной обработки
+const int64_t BINARY_GRAIN = 1 << 16;
+
+// Прочитать из файла до bytes байт в буфер
+// Возвращает количество прочитанных байт
+size_t readBlock(std::ifstream& file, char* buffer, size_t bytes) {
+    file.read(buffer, static_cast<std::streamsize>(bytes));
+    return static_cast<size_t>(file.gcount());
+}
+
+// Найти последний '\n' в буфере (nullptr, если его нет)
+const char* findLastNewline(const char* begin, const char* end) {
+    while (end > begin) {
+        if (*--end == '\n') return end;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+EdgeStream::EdgeStream()
+    : numVertices(0), binary(false), bodyBegin(0), bodyEnd(0), headerLines(0), edgeCount(0), errorCount(0) {}
+
+// Функция открытия файла и чтения заголовка
+bool EdgeStream::open(const std::string& name) {
+    filename = name;
+    numVertices = 0;
+    edgeCount = 0;
+    errorCount = 0;
+
+    // Бинарный формат: читается только секция рёбер
+    if (BinaryGraphFormat::isBinaryFile(name)) {
+        BinaryGraphHeader header;
+        if (!BinaryGraphFormat::readHeader(name, header)) return false;
+        binary = true;
+        numVertices = static_cast<int>(header.numVertices);
+        bodyBegin = header.edgesPos;
+        bodyEnd = header.edgesPos + static_cast<uint64_t>(header.numEdges) * sizeof(std::pair<int, int>);
+        return true;
+    }
+
+    std::ifstream file(name, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << name << std::endl;
+        return false;
+    }
+    binary = false;
+    bodyEnd = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    // Количество вершин - первое число файла
+    std::vector<char> head(static_cast<size_t>(std::min<uint64_t>(bodyEnd, HEADER_BYTES)));
+    head.resize(readBlock(file, head.data(), head.size()));
+    size_t bodyOffset = 0;
+    ParseError headerError;
+    if (!EdgeListParser::parseHeader(head.data(), head.size(), numVertices, bodyOffset, headerError)) {
+        ParsedEdgeList parsed;
+        parsed.errors.push_back(headerError);
+        parsed.errorCount = 1;
+        EdgeListParser::reportErrors(name, parsed);
+        return false;
+    }
+    bodyBegin = bodyOffset;
+    headerLines = static_cast<size_t>(std::count(head.begin(), head.begin() + bodyOffset, '\n'));
+    return true;
+}
+
+// Функция одного последовательного прохода по рёбрам файла
+bool EdgeStream::forEachEdge(ThreadPool& pool, const EdgeHandler& handler, bool reportErrors) {
+    GRAPH_PROFILE_SCOPE(StreamEdges);
+    edgeCount = 0;
+    errorCount = 0;
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open() || !file.seekg(static_cast<std::streamoff>(bodyBegin))) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    uint64_t remaining = bodyEnd - bodyBegin;
+    int threads = pool.getThreadCount();
+
+    // ===== БИНАРНЫЙ ФОРМАТ =====
+    // Блоки - массивы пар; рёбра вне диапазона пропускаются (порция
+    // обработчику - отрезок корректных рёбер между ними)
+    if (binary) {
+        const size_t blockEdges = BLOCK_BYTES / sizeof(std::pair<int, int>);
+        std::vector<std::pair<int, int>> buffers[2];
+        buffers[0].resize(blockEdges);
+        buffers[1].resize(blockEdges);
+        std::vector<uint64_t> localValid(threads, 0), localErrors(threads, 0);
+        auto readEdges = [&](std::vector<std::pair<int, int>>& buffer) {
+            size_t bytes = static_cast<size_t>(std::min<uint64_t>(remaining, blockEdges * sizeof(std::pair<int, int>)));
+            size_t got = readBlock(file, reinterpret_cast<char*>(buffer.data()), bytes);
+            remaining -= got;
+            return got / sizeof(std::pair<int, int>);
+        };
+
+        int current = 0;
+        size_t count = readEdges(buffers[0]);
+        while (count > 0) {
+            // Следующий блок читается, пока обрабатывается текущий
+            // (файл, укоротившийся во время чтения, даёт пустой блок - проход прерывается)
+            size_t nextCount = 0;
+            std::thread reader;
+            if (remaining > 0) {
+                reader = std::thread([&]() { nextCount = readEdges(buffers[1 - current]); });
+            }
+            const std::pair<int, int>* edges = buffers[current].data();
+            pool.parallelFor(0, static_cast<int64_t>(count), BINARY_GRAIN, [&](int64_t begin, int64_t end, int worker) {
+                int64_t run = begin;
+                for (int64_t i = begin; i < end; i++) {
+                    int u = edges[i].first, v = edges[i].second;
+                    if (u >= 0 && u < numVertices && v >= 0 && v < numVertices) continue;
+                    if (i > run) handler(edges + run, static_cast<size_t>(i - run), worker);
+                    localErrors[worker]++;
+                    run = i + 1;
+                }
+                if (end > run) handler(edges + run, static_cast<size_t>(end - run), worker);
+                localValid[worker] += static_cast<uint64_t>(end - begin);
+            });
+            if (reader.joinable()) reader.join();
+            current = 1 - current;
+            count = nextCount;
+        }
+        for (int w = 0; w < threads; w++) {
+            errorCount += localErrors[w];
+            edgeCount += localValid[w] - localErrors[w];
+        }
+        if (remaining > 0) {
+            std::cerr << "Ошибка: не удалось дочитать файл " << filename << std::endl;
+            return false;
+        }
+        if (reportErrors && errorCount > 0) {
+            std::cerr << "Ошибка формата в " << filename << ": " << errorCount
+                      << " рёбер с номером вершины вне диапазона" << std::endl;
+        }
+        return true;
+    }
+
+    // ===== ТЕКСТОВЫЙ ФОРМАТ =====
+    // Строки нумеруются с единицы; рёбра начинаются в строке заголовка
+    // (сразу после количества вершин) - до неё headerLines строк
+    size_t lineNumber = headerLines;
+
+    std::vector<char> buffers[2];
+    buffers[0].resize(BLOCK_BYTES);
+    std::vector<EdgeChunk> pieces;
+    std::vector<const char*> bounds;
+    ParsedEdgeList report;   // Только ошибки (для EdgeListParser::reportErrors)
+    PendingVertex carry;     // Число без пары в конце разобранной части файла
+    std::vector<PendingVertex> carries;
+    uint64_t blockOffset = bodyBegin;
+    size_t filled = readBlock(file, buffers[0].data(), static_cast<size_t>(std::min<uint64_t>(remaining, BLOCK_BYTES)));
+    remaining -= filled;
+    int current = 0;
+
+    while (filled > 0) {
+        // Разбираются только целые строки; хвост после последнего '\n'
+        // переносится в начало следующего блока (в последнем блоке - разбирается)
+        const char* data = buffers[current].data();
+        size_t parseSize = filled;
+        if (remaining > 0) {
+            const char* newline = findLastNewline(data, data + filled);
+            parseSize = newline ? static_cast<size_t>(newline - data) + 1 : 0;
+        }
+        size_t tail = filled - parseSize;
+
+        // Следующий блок: хвост плюс очередные BLOCK_BYTES байт файла (читаются
+        // отдельным потоком, пока пул разбирает текущий блок)
+        size_t nextFilled = 0;
+        size_t nextRead = 0;
+        std::thread reader;
+        if (remaining > 0) {
+            std::vector<char>& next = buffers[1 - current];
+            next.resize(tail + BLOCK_BYTES);
+            std::memcpy(next.data(), data + parseSize, tail);
+            reader = std::thread([&, tail]() {
+                size_t bytes = static_cast<size_t>(std::min<uint64_t>(remaining, BLOCK_BYTES));
+                size_t got = readBlock(file, buffers[1 - current].data() + tail, bytes);
+                remaining -= got;
+                nextRead = got;
+                nextFilled = tail + got;
+            });
+        }
+
+        // Делим разбираемую часть на участки по границам строк
+        int pieceCount = static_cast<int>(std::min<size_t>(static_cast<size_t>(threads) * PIECES_PER_THREAD,
+                                                           std::max<size_t>(1, parseSize / MIN_PIECE_BYTES)));
+        if (static_cast<int>(pieces.size()) < pieceCount) pieces.resize(pieceCount);
+        bounds.assign(pieceCount + 1, data);
+        const char* end = data + parseSize;
+        for (int p = 1; p < pieceCount; p++) {
+            const char* guess = std::max(data + parseSize / pieceCount * p, bounds[p - 1]);
+            const void* newline = guess < end ? std::memchr(guess, '\n', static_cast<size_t>(end - guess)) : nullptr;
+            bounds[p] = newline ? static_cast<const char*>(newline) + 1 : end;
+        }
+        bounds[pieceCount] = end;
+
+        // Участки разбираются параллельно, каждый - как будто с начала пары
+        auto parsePiece = [&](int p, const PendingVertex* pending) {
+            EdgeChunk& chunk = pieces[p];
+            chunk.clear();
+            EdgeListParser::parseChunk(bounds[p], bounds[p + 1], blockOffset + static_cast<size_t>(bounds[p] - data),
+                                       numVertices, chunk, pending);
+        };
+        pool.parallelFor(0, pieceCount, 1, [&](int64_t begin, int64_t finish, int) {
+            for (int64_t p = begin; p < finish; p++) parsePiece(static_cast<int>(p), nullptr);
+        });
+
+        // Участки, начинающиеся с середины пары (в том числе из прошлого блока),
+        // разбираются заново; затем рёбра участков уходят обработчику
+        std::vector<int> redo = EdgeListParser::linkChunks(pieces, pieceCount, lineNumber, carry, carries);
+        std::vector<char> needsRedo(pieceCount, 0);
+        for (int p : redo) needsRedo[p] = 1;
+        pool.parallelFor(0, pieceCount, 1, [&](int64_t begin, int64_t finish, int worker) {
+            for (int64_t p = begin; p < finish; p++) {
+                if (needsRedo[p]) parsePiece(static_cast<int>(p), &carries[p]);
+                const EdgeChunk& chunk = pieces[p];
+                if (!chunk.edges.empty()) handler(chunk.edges.data(), chunk.edges.size(), worker);
+            }
+        });
+
+        // Счётчики и ошибки с абсолютными номерами строк
+        for (int p = 0; p < pieceCount; p++) {
+            const EdgeChunk& chunk = pieces[p];
+            edgeCount += chunk.edges.size();
+            for (ParseError error : chunk.errors) {
+                if (report.errors.size() >= EdgeListParser::MAX_STORED_ERRORS) break;
+                error.line += lineNumber;
+                report.errors.push_back(error);
+            }
+            report.errorCount += chunk.errorCount;
+            lineNumber += chunk.lineCount;
+        }
+
+        if (reader.joinable()) {
+            reader.join();
+            // Файл укоротился во время чтения - иначе хвост разбирался бы бесконечно
+            if (nextRead == 0) break;
+        }
+        blockOffset += parseSize;
+        current = 1 - current;
+        filled = nextFilled;
+    }
+
+    // Последнему числу файла не хватило пары
+    if (carry.present) EdgeListParser::addUnpairedError(carry, report);
+    errorCount = report.errorCount;
+    if (reportErrors) EdgeListParser::reportErrors(filename, report);
+    if (remaining > 0) {
+        std::cerr << "Ошибка: не удалось дочитать файл " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция возвращает количество вершин
+int EdgeStream::getNumVertices() const {
+    return numVertices;
+}
+
+// Функция проверки формата файла
+bool EdgeStream::isBinary() const {
+    return binary;
+}
+
+// Функция возвращает количество рёбер последнего прохода
+uint64_t EdgeStream::getEdgeCount() const {
+    return edgeCount;
+}
+
+// Функция возвращает количество ошибок последнего прохода
+uint64_t EdgeStream::getErrorCount() const {
+    return errorCount;
+}
+
+// Функция возвращает объём рёбер в файле
+uint64_t EdgeStream::getBodyBytes() const {
+    return bodyEnd - bodyBegin;
+}
@@ -4,13 +4,122 @@
 #include <iostream>
 // Подключаем библиотеку для алгоритмов (find)
 #include <algorithm>
+// Подключаем отображение файла в память и разбор списка рёбер
+#include "MappedFile.h"
+#include "EdgeListParser.h"
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем быстрое форматирование чисел (to_chars)
+#include <charconv>
+
+// Вспомогательные структуры доступа к соседям вершины
+// Алгоритмы обхода написаны один раз как шаблоны и работают
+// как со списками смежности, так и с CSR-представлением
+namespace {
+
+// Доступ к соседям через список смежности (vector<vector<int>>)
+struct ListAdjacency {
+    const std::vector<std::vector<int>>& lists;
+    NeighborView operator()(int vertex) const {
+        return NeighborView(lists[vertex]);
+    }
+};
+
+// Доступ к соседям через CSR (два непрерывных массива)
+struct CSRAdjacency {
+    const int64_t* offsets;
+    const int* neighbors;
+    NeighborView operator()(int vertex) const {
+        return NeighborView(neighbors + offsets[vertex],
+                            static_cast<size_t>(offsets[vertex + 1] - offsets[vertex]));
+    }
+};
+
+// Обход в глубину (DFS) для любого способа доступа к соседям
+// Стек хранит путь от стартовой вершины и для каждой вершины пути - номер
+// следующего непроверенного соседа, поэтому он не длиннее числа вершин
+// (каждая вершина лежит в стеке не больше одного раза). Порядок обхода
+// тот же, что у рекурсивного DFS. Отметки, стек и результат - в контексте
+template <typename Adjacency>
+void depthFirstSearchImpl(int numVertices, Adjacency adjacency, int start, TraversalContext& context,
+                          std::vector<int>& stack, std::vector<size_t>& cursors, std::vector<int>& result) {
+    // Новый обход: отметки прошлых обходов перестают действовать
+    context.begin(numVertices);
+    
+    // Посещаем стартовую вершину и кладём её в стек
+    context.visit(start);
+    result.push_back(start);
+    stack.push_back(start);
+    cursors.push_back(0);
+    
+    // Пока стек не пуст, продолжаем обход
+    while (!stack.empty()) {
+        // Ищем следующего непосещённого соседа верхней вершины
+        NeighborView neighbors = adjacency(stack.back());
+        size_t i = cursors.back();
+        while (i < neighbors.size() && context.isVisited(neighbors[i])) i++;
+        
+        // Соседи закончились - возвращаемся к предыдущей вершине пути
+        if (i == neighbors.size()) {
+            stack.pop_back();
+            cursors.pop_back();
+            continue;
+        }
+        
+        // Запоминаем, с какого соседа продолжить, и спускаемся в найденного
+        cursors.back() = i + 1;
+        int neighbor = neighbors[i];
+        context.visit(neighbor);
+        result.push_back(neighbor);
+        stack.push_back(neighbor);
+        cursors.push_back(0);
+    }
+}
+
+// Обход в ширину (BFS) для любого способа доступа к соседям
+// Очередь - сам результат: вершины попадают в него в порядке
+// постановки в очередь, голова очереди - индекс head
+template <typename Adjacency>
+void breadthFirstSearchImpl(int numVertices, Adjacency adjacency, int start, TraversalContext& context,
+                            std::vector<int>& result) {
+    // Новый обход: отметки прошлых обходов перестают действовать
+    context.begin(numVertices);
+    
+    // Отмечаем стартовую вершину и помещаем её в очередь
+    context.visit(start);
+    result.push_back(start);
+    
+    // Пока очередь не пуста
+    for (size_t head = 0; head < result.size(); head++) {
+        // Берём первую вершину из очереди
+        int vertex = result[head];
+        
+        // Проходим по всем смежным вершинам
+        for (int neighbor : adjacency(vertex)) {
+            // Если сосед не посещён - отмечаем его и добавляем в очередь
+            if (context.visit(neighbor)) {
+                result.push_back(neighbor);
+            }
+        }
+    }
+}
+
+} // namespace
 
 // Конструктор класса Graph - создает граф с заданным количеством вершин
 // Параметр vertices - количество вершин в графе
-Graph::Graph(int vertices) : numVertices(vertices) {
+Graph::Graph(int vertices)
+    : numVertices(vertices), deferredInsert(false), connectivityComponents(vertices), connectivityValid(true) {
     // Изменяем размер вектора списков смежности под количество вершин
     // Каждая вершина получит свой пустой список смежных вершин
     adjList.resize(vertices);
+    
+    // Вначале каждая вершина - отдельная компонента связности
+    connectivityParent.resize(vertices);
+    connectivitySize.assign(vertices, 1);
+    for (int i = 0; i < vertices; i++) {
+        connectivityParent[i] = i;
+    }
 }
 
 // Функция добавления ребра между вершинами u и v
@@ -23,6 +132,21 @@ void Graph::addEdge(int u, int v) {
         return;
     }
     
+    // Замороженный (CSR) граф изменять нельзя
+    if (csr) {
+        std::cerr << "Ошибка: граф заморожен (freeze), добавление рёбер невозможно" << std::endl;
+        return;
+    }
+    
+    // В режиме пакетной вставки только запоминаем ребро (дубли уберёт finalize)
+    if (deferredInsert) {
+        edges.push_back({u, v});
+        // Дубли не мешают union-find, поэтому связность обновляем сразу
+        uniteConnectivity(u, v);
+        invalidateComponents();
+        return;
+    }
+    
     // Проверка на дублирование рёбер
     // Ищем вершину v в списке смежности вершины u
     if (std::find(adjList[u].begin(), adjList[u].end(), v) == adjList[u].end()) {
@@ -32,7 +156,96 @@ void Graph::addEdge(int u, int v) {
         adjList[v].push_back(u);
         // Сохраняем ребро в список всех рёбер для визуализации
         edges.push_back({u, v});
+        // Обновляем компоненты связности за O(α(n))
+        uniteConnectivity(u, v);
+        invalidateComponents();
+    }
+}
+
+// Функция удаления ребра между вершинами u и v
+bool Graph::removeEdge(int u, int v) {
+    // Проверяем корректность номеров вершин
+    if (u < 0 || u >= numVertices || v < 0 || v >= numVertices) {
+        std::cerr << "Ошибка: неверные номера вершин (" << u << ", " << v << ")" << std::endl;
+        return false;
+    }
+    
+    // Замороженный (CSR) граф изменять нельзя
+    if (csr) {
+        std::cerr << "Ошибка: граф заморожен (freeze), удаление рёбер невозможно" << std::endl;
+        return false;
+    }
+    
+    // Незавершённую пакетную вставку сначала завершаем (нужны списки смежности)
+    if (deferredInsert) finalize();
+    
+    // Ищем v в списке смежности u; если его нет, ребра нет
+    auto it = std::find(adjList[u].begin(), adjList[u].end(), v);
+    if (it == adjList[u].end()) return false;
+    
+    // Удаляем соседей из обоих списков (для петли - два вхождения из одного списка)
+    adjList[u].erase(it);
+    adjList[v].erase(std::find(adjList[v].begin(), adjList[v].end(), u));
+    
+    // Удаляем ребро из списка рёбер (в любом направлении), сохраняя порядок
+    for (auto e = edges.begin(); e != edges.end(); ++e) {
+        if ((e->first == u && e->second == v) || (e->first == v && e->second == u)) {
+            edges.erase(e);
+            break;
+        }
+    }
+    
+    // Удаление может разбить компоненту - union-find устарел
+    connectivityValid = false;
+    invalidateComponents();
+    return true;
+}
+
+// Функция перевода графа в формат CSR
+// Все списки смежности копируются подряд в один массив neighbors,
+// а offsets[v] указывает, где начинаются соседи вершины v
+void Graph::freeze() {
+    // Повторная заморозка ничего не делает
+    if (csr) return;
+    // Незавершённую пакетную вставку сначала завершаем
+    if (deferredInsert) finalize();
+    
+    auto storage = std::make_shared<CSRStorage>();
+    
+    // Считаем смещения: offsets[v + 1] = offsets[v] + степень(v)
+    storage->offsetStorage.resize(numVertices + 1);
+    storage->offsetStorage[0] = 0;
+    for (int v = 0; v < numVertices; v++) {
+        storage->offsetStorage[v + 1] = storage->offsetStorage[v] + adjList[v].size();
     }
+    
+    // Копируем соседей всех вершин в один массив (порядок сохраняется)
+    storage->neighborStorage.resize(storage->offsetStorage[numVertices]);
+    for (int v = 0; v < numVertices; v++) {
+        std::copy(adjList[v].begin(), adjList[v].end(),
+                  storage->neighborStorage.begin() + storage->offsetStorage[v]);
+    }
+    
+    // Настраиваем указатели на массивы; отдельный список рёбер не хранится -
+    // getEdges восстанавливает рёбра из соседей
+    storage->offsets = storage->offsetStorage.data();
+    storage->neighbors = storage->neighborStorage.data();
+    storage->numEdges = edges.size();
+    csr = storage;
+    
+    // Освобождаем память списков смежности и списка рёбер
+    std::vector<std::vector<int>>().swap(adjList);
+    std::vector<std::pair<int, int>>().swap(edges);
+}
+
+// Функция проверки, заморожен ли граф
+bool Graph::isFrozen() const {
+    return csr != nullptr;
+}
+
+// Функция возвращает CSR-представление (nullptr, если граф не заморожен)
+const CSRStorage* Graph::getCSR() const {
+    return csr.get();
 }
 
 // Функция возвращает количество вершин в графе
@@ -42,17 +255,25 @@ int Graph::getNumVertices() const {
     return numVertices;
 }
 
-// Функция возвращает константную ссылку на список смежности заданной вершины
-// Возвращаем ссылку (&), чтобы не копировать весь вектор
-const std::vector<int>& Graph::getAdjList(int vertex) const {
+// Функция возвращает представление списка смежности заданной вершины
+// Представление не копирует данные, а ссылается на память графа
+NeighborView Graph::getAdjList(int vertex) const {
+    // Для замороженного графа берём участок общего массива CSR
+    if (csr) {
+        return CSRAdjacency{csr->offsets, csr->neighbors}(vertex);
+    }
     // Возвращаем вектор смежных вершин для заданной вершины
-    return adjList[vertex];
+    return NeighborView(adjList[vertex]);
 }
 
-// Функция возвращает константную ссылку на список всех рёбер графа
-const std::vector<std::pair<int, int>>& Graph::getEdges() const {
+// Функция возвращает представление списка всех рёбер графа
+EdgeView Graph::getEdges() const {
+    // Для замороженного графа рёбра восстанавливаются из CSR без копии
+    if (csr) {
+        return EdgeView(*csr, numVertices);
+    }
     // Возвращаем вектор пар вершин (каждая пара - это ребро)
-    return edges;
+    return EdgeView(edges);
 }
 
 // Функция возвращает степень вершины (количество смежных вершин)
@@ -62,6 +283,10 @@ int Graph::getDegree(int vertex) const {
         // Возвращаем -1 в случае ошибки
         return -1;
     }
+    // Для CSR степень - разность соседних смещений
+    if (csr) {
+        return static_cast<int>(csr->offsets[vertex + 1] - csr->offsets[vertex]);
+    }
     // Возвращаем размер списка смежности (количество смежных вершин)
     return adjList[vertex].size();
 }
@@ -69,86 +294,48 @@ int Graph::getDegree(int vertex) const {
 // Функция обхода графа в глубину (Depth First Search - DFS)
 // Начинаем обход с вершины start
 std::vector<int> Graph::depthFirstSearch(int start) const {
-    // Вектор для хранения результата обхода (порядок посещения вершин)
-    std::vector<int> result;
-    // Вектор для отметки посещённых вершин (изначально все false - не посещены)
-    std::vector<bool> visited(numVertices, false);
-    // Стек для хранения вершин, которые нужно посетить (LIFO - Last In First Out)
-    std::stack<int> stack;
-    
-    // Помещаем стартовую вершину в стек
-    stack.push(start);
-    
-    // Пока стек не пуст, продолжаем обход
-    while (!stack.empty()) {
-        // Берём верхнюю вершину из стека
-        int vertex = stack.top();
-        // Удаляем её из стека
-        stack.pop();
-        
-        // Если вершина ещё не посещена
-        if (!visited[vertex]) {
-            // Отмечаем вершину как посещённую
-            visited[vertex] = true;
-            // Добавляем вершину в результат
-            result.push_back(vertex);
-            
-            // Добавляем смежные вершины в стек (в обратном порядке)
-            // Обратный порядок нужен для обхода в правильной последовательности
-            for (int i = adjList[vertex].size() - 1; i >= 0; i--) {
-                // Получаем соседнюю вершину
-                int neighbor = adjList[vertex][i];
-                // Если сосед не посещён, добавляем его в стек
-                if (!visited[neighbor]) {
-                    stack.push(neighbor);
-                }
-            }
-        }
+    // Одноразовый контекст; результат забирается из него без копирования
+    TraversalContext context;
+    depthFirstSearch(start, context);
+    return std::move(context.order);
+}
+
+// Обход в глубину с переиспользуемой рабочей памятью
+const std::vector<int>& Graph::depthFirstSearch(int start, TraversalContext& context) const {
+    GRAPH_PROFILE_SCOPE(DepthFirstSearch);
+    // Замороженный граф обходим по CSR, иначе - по спискам смежности
+    if (csr) {
+        depthFirstSearchImpl(numVertices, CSRAdjacency{csr->offsets, csr->neighbors}, start,
+                             context, context.stack, context.cursors, context.order);
+    } else {
+        depthFirstSearchImpl(numVertices, ListAdjacency{adjList}, start, context,
+                             context.stack, context.cursors, context.order);
     }
-    
-    // Возвращаем вектор с порядком посещения вершин
-    return result;
+    GRAPH_PROFILE_COUNT(VerticesVisited, context.order.size());
+    return context.order;
 }
 
 // Функция обхода графа в ширину (Breadth First Search - BFS)
 // Начинаем обход с вершины start
 std::vector<int> Graph::breadthFirstSearch(int start) const {
-    // Вектор для хранения результата обхода
-    std::vector<int> result;
-    // Вектор для отметки посещённых вершин
-    std::vector<bool> visited(numVertices, false);
-    // Очередь для хранения вершин (FIFO - First In First Out)
-    // BFS использует очередь (в отличие от DFS, который использует стек)
-    std::queue<int> queue;
-    
-    // Отмечаем стартовую вершину как посещённую
-    visited[start] = true;
-    // Помещаем стартовую вершину в очередь
-    queue.push(start);
-    
-    // Пока очередь не пуста
-    while (!queue.empty()) {
-        // Берём первую вершину из очереди
-        int vertex = queue.front();
-        // Удаляем её из очереди
-        queue.pop();
-        // Добавляем вершину в результат
-        result.push_back(vertex);
-        
-        // Проходим по всем смежным вершинам
-        for (int neighbor : adjList[vertex]) {
-            // Если сосед не посещён
-            if (!visited[neighbor]) {
-                // Отмечаем соседа как посещённого
-                visited[neighbor] = true;
-                // Добавляем соседа в очередь
-                queue.push(neighbor);
-            }
-        }
+    // Одноразовый контекст; результат забирается из него без копирования
+    TraversalContext context;
+    breadthFirstSearch(start, context);
+    return std::move(context.order);
+}
+
+// Обход в ширину с переиспользуемой рабочей памятью
+const std::vector<int>& Graph::breadthFirstSearch(int start, TraversalContext& context) const {
+    GRAPH_PROFILE_SCOPE(BreadthFirstSearch);
+    // Замороженный граф обходим по CSR, иначе - по спискам смежности
+    if (csr) {
+        breadthFirstSearchImpl(numVertices, CSRAdjacency{csr->offsets, csr->neighbors}, start,
+                               context, context.order);
+    } else {
+        breadthFirstSearchImpl(numVertices, ListAdjacency{adjList}, start, context, context.order);
     }
-    
-    // Возвращаем порядок посещения вершин
-    return result;
+    GRAPH_PROFILE_COUNT(VerticesVisited, context.order.size());
+    return context.order;
 }
 
 // Функция проверки связности графа
@@ -157,123 +344,135 @@ bool Graph::isConnected() const {
     // Пустой граф считаем связным
     if (numVertices == 0) return true;
     
-    // Запускаем BFS от вершины 0 и получаем все достижимые вершины
-    std::vector<int> reachable = breadthFirstSearch(0);
-    // Если количество достижимых вершин равно общему количеству,
-    // то граф связный (можем добраться до всех вершин)
-    return static_cast<int>(reachable.size()) == numVertices;
+    // Граф связный, если все вершины попали в одну компоненту
+    // (разметка берётся из кэша, повторный вызов не обходит граф)
+    return getComponentCount() == 1;
 }
 
 // Функция нахождения компонент связности графа
 // Компонента связности - максимальное подмножество вершин,
 // в котором любые две вершины соединены путём
 std::vector<std::vector<int>> Graph::getConnectedComponents() const {
-    // Вектор компонент (каждая компонента - вектор вершин)
-    std::vector<std::vector<int>> components;
-    // Вектор отметок посещённых вершин
-    std::vector<bool> visited(numVertices, false);
+    // Берём (или считаем) разметку вершин по компонентам
+    std::shared_ptr<const ComponentLabels> components = getComponentLabels();
     
-    // Проходим по всем вершинам графа
-    for (int i = 0; i < numVertices; i++) {
-        // Если вершина ещё не посещена (принадлежит новой компоненте)
-        if (!visited[i]) {
-            // Создаём новую компоненту
-            std::vector<int> component;
-            // Очередь для BFS внутри компоненты
-            std::queue<int> queue;
-            
-            // Отмечаем текущую вершину как посещённую
-            visited[i] = true;
-            // Добавляем её в очередь
-            queue.push(i);
-            
-            // Запускаем BFS для нахождения всех вершин компоненты
-            while (!queue.empty()) {
-                // Берём вершину из очереди
-                int vertex = queue.front();
-                queue.pop();
-                // Добавляем её в текущую компоненту
-                component.push_back(vertex);
-                
-                // Проходим по всем соседям
-                for (int neighbor : adjList[vertex]) {
-                    // Если сосед не посещён
-                    if (!visited[neighbor]) {
-                        // Отмечаем его как посещённого
-                        visited[neighbor] = true;
-                        // Добавляем в очередь
-                        queue.push(neighbor);
-                    }
-                }
-            }
-            
-            // Добавляем найденную компоненту в список всех компонент
-            components.push_back(component);
-        }
+    // Раскладываем вершины по компонентам; размеры известны заранее
+    std::vector<std::vector<int>> result(components->sizes.size());
+    for (size_t c = 0; c < result.size(); c++) {
+        result[c].reserve(components->sizes[c]);
+    }
+    for (int v = 0; v < numVertices; v++) {
+        result[components->labels[v]].push_back(v);
     }
     
     // Возвращаем вектор всех компонент связности
-    return components;
+    return result;
+}
+
+// Функция нахождения компонент связности в плоский массив контекста
+// Разметка берётся из кэша графа, раскладка по компонентам - сортировка
+// подсчётом: начала компонент - префиксные суммы размеров
+int Graph::getConnectedComponents(TraversalContext& context) const {
+    std::shared_ptr<const ComponentLabels> components = getComponentLabels();
+    const std::vector<int>& sizes = components->sizes;
+    int count = static_cast<int>(sizes.size());
+    
+    // Начала компонент (assign не выделяет память, если её хватает)
+    context.componentStart.assign(count + 1, 0);
+    for (int c = 0; c < count; c++) {
+        context.componentStart[c + 1] = context.componentStart[c] + sizes[c];
+    }
+    
+    // Вершины раскладываются по возрастанию - внутри компоненты тоже по возрастанию
+    // (курсоры заполнения - стек контекста, он между обходами свободен)
+    std::vector<int>& cursor = context.stack;
+    cursor.assign(context.componentStart.begin(), context.componentStart.end() - 1);
+    context.componentVertices.resize(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        context.componentVertices[cursor[components->labels[v]]++] = v;
+    }
+    cursor.clear();
+    return count;
 }
 
 // Статическая функция загрузки графа из файла
 // Формат файла: первая строка - количество вершин,
 // остальные строки - пары вершин (рёбра)
-Graph Graph::loadFromFile(const std::string& filename) {
-    // Открываем файл для чтения
-    std::ifstream file(filename);
+// Файл отображается в память и разбирается параллельно по участкам,
+// рёбра передаются в пакетный построитель fromEdgeList
+Graph Graph::loadFromFile(const std::string& filename, int numThreads) {
+    GRAPH_PROFILE_SCOPE(LoadFromFile);
+    // Отображаем файл в память (без копирования в буфер потока)
+    MappedFile file;
     // Проверяем, удалось ли открыть файл
-    if (!file.is_open()) {
+    if (!file.open(filename)) {
         // Выводим сообщение об ошибке
         std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
         // Возвращаем пустой граф
         return Graph(0);
     }
     
-    // Переменная для количества вершин
-    int numVertices;
-    // Считываем количество вершин из первой строки
-    file >> numVertices;
-    
-    // Создаём граф с заданным количеством вершин
-    Graph graph(numVertices);
-    
-    // Переменные для номеров вершин ребра
-    int u, v;
-    // Читаем пары вершин до конца файла
-    while (file >> u >> v) {
-        // Добавляем ребро в граф
-        graph.addEdge(u, v);
+    // Разбираем текст на всех ядрах
+    ParsedEdgeList parsed;
+    bool headerOk = EdgeListParser::parse(file.data(), file.size(), numThreads, parsed);
+    // Сообщаем о некорректных строках (с номером строки и смещением в байтах)
+    EdgeListParser::reportErrors(filename, parsed);
+    if (!headerOk) {
+        // Без количества вершин граф построить нельзя
+        return Graph(0);
     }
     
-    // Закрываем файл
-    file.close();
-    // Возвращаем созданный граф
-    return graph;
+    // Удаляем дубли и строим CSR за один проход
+    return fromEdgeList(parsed.numVertices, parsed.edges);
 }
 
 // Функция сохранения графа в файл
-void Graph::saveToFile(const std::string& filename) const {
+// Числа форматируются через to_chars в большой буфер, который
+// сбрасывается в файл целиком (без flush на каждой строке)
+bool Graph::saveToFile(const std::string& filename) const {
     // Открываем файл для записи
-    std::ofstream file(filename);
+    std::ofstream file(filename, std::ios::binary);
     // Проверяем, удалось ли открыть файл
     if (!file.is_open()) {
         // Выводим сообщение об ошибке
         std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
-        return;
+        return false;
     }
     
+    // Буфер вывода (1 МБ) и запас на одну строку
+    const size_t bufferSize = 1 << 20;
+    std::vector<char> buffer(bufferSize + 64);
+    size_t used = 0;
+    
     // Записываем количество вершин в первую строку
-    file << numVertices << std::endl;
+    used = std::to_chars(buffer.data(), buffer.data() + 64, numVertices).ptr - buffer.data();
+    buffer[used++] = '\n';
     
     // Проходим по всем рёбрам графа
-    for (const auto& edge : edges) {
-        // Записываем пару вершин (ребро) в файл
-        file << edge.first << " " << edge.second << std::endl;
+    for (const auto& edge : getEdges()) {
+        // Записываем пару вершин (ребро) в буфер
+        char* p = buffer.data() + used;
+        p = std::to_chars(p, p + 32, edge.first).ptr;
+        *p++ = ' ';
+        p = std::to_chars(p, p + 32, edge.second).ptr;
+        *p++ = '\n';
+        used = p - buffer.data();
+        
+        // Буфер заполнен - записываем его в файл
+        if (used >= bufferSize) {
+            file.write(buffer.data(), used);
+            used = 0;
+        }
     }
+    file.write(buffer.data(), used);
     
     // Закрываем файл
     file.close();
+    if (!file) {
+        std::cerr << "Ошибка: не удалось записать файл " << filename << std::endl;
+        return false;
+    }
+    return true;
 }
 
 // Функция вывода информации о графе в консоль
@@ -283,7 +482,7 @@ void Graph::printInfo() const {
     // Выводим количество вершин
     std::cout << "Количество вершин: " << numVertices << std::endl;
     // Выводим количество рёбер (размер вектора рёбер)
-    std::cout << "Количество рёбер: " << edges.size() << std::endl;
+    std::cout << "Количество рёбер: " << getEdges().size() << std::endl;
     
     // Выводим степень каждой вершины
     std::cout << "\nСтепени вершин:" << std::endl;
@@ -294,10 +493,11 @@ void Graph::printInfo() const {
     
     // Проверяем и выводим информацию о связности
     // Тернарный оператор: условие ? значение_если_true : значение_если_false
-    std::cout << "\nСвязность: " << (isConnected() ? "граф связный" : "граф несвязный") << std::endl;
+    bool connected = isConnected();
+    std::cout << "\nСвязность: " << (connected ? "граф связный" : "граф несвязный") << std::endl;
     
     // Если граф несвязный, выводим информацию о компонентах связности
-    if (!isConnected()) {
+    if (!connected) {
         // Получаем все компоненты связности
         auto components = getConnectedComponents();
         // Выводим количество компонент
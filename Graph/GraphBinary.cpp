@@ -0,0 +1,331 @@
+// Подключаем описание бинарного формата графа
+#include "BinaryGraphFormat.h"
+// Подключаем отображение файла в память
+#include "MappedFile.h"
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем библиотеку для работы с файлами
+#include <fstream>
+// Подключаем функции работы с памятью (memcmp, memcpy)
+#include <cstring>
+
+// Вспомогательные функции бинарного формата
+namespace {
+
+// Сигнатура формата (8 байт вместе с завершающим нулём)
+const char MAGIC[8] = {'L', 'G', 'R', 'A', 'P', 'H', 'B', '\0'};
+
+// Заголовок должен занимать ровно 64 байта на всех платформах
+static_assert(sizeof(BinaryGraphHeader) == 64, "BinaryGraphHeader должен занимать 64 байта");
+// Секция рёбер читается напрямую как массив std::pair<int, int>
+static_assert(sizeof(std::pair<int, int>) == 2 * sizeof(int32_t), "std::pair<int, int> должен состоять из двух int32");
+static_assert(sizeof(int) == sizeof(int32_t), "int должен быть 32-битным");
+
+// Рёбер в одной порции записи секции рёбер
+const size_t WRITE_BLOCK_EDGES = 1 << 16;
+
+// Округлить позицию вверх до кратной 8 байтам
+inline uint64_t align8(uint64_t position) {
+    return (position + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Дописать нули до выравнивания на 8 байт
+void writePadding(std::ofstream& file, uint64_t& position) {
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    uint64_t aligned = align8(position);
+    file.write(zeros, static_cast<std::streamsize>(aligned - position));
+    position = aligned;
+}
+
+// Записать массив и сдвинуть текущую позицию
+void writeArray(std::ofstream& file, uint64_t& position, const void* data, uint64_t bytes) {
+    if (bytes > 0) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+    position += bytes;
+}
+
+// Проверить заголовок и границы всех секций относительно размера файла
+bool validateHeader(const BinaryGraphHeader& header, uint64_t fileSize, std::string& message) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        message = "неверная сигнатура файла";
+        return false;
+    }
+    if (header.version != BinaryGraphFormat::VERSION) {
+        message = "неподдерживаемая версия формата " + std::to_string(header.version);
+        return false;
+    }
+    if (header.numVertices < 0 || header.numVertices > INT32_MAX || header.numEdges < 0) {
+        message = "некорректное количество вершин или рёбер";
+        return false;
+    }
+
+    // Ожидаемые размеры секций (огромное numEdges переполнило бы 2 * m * 4 -
+    // отсекаем его заранее: рёбра не могут занимать больше файла)
+    uint64_t n = static_cast<uint64_t>(header.numVertices);
+    uint64_t m = static_cast<uint64_t>(header.numEdges);
+    if (m > fileSize / (2 * sizeof(int32_t))) {
+        message = "секции выходят за пределы файла (файл повреждён или обрезан)";
+        return false;
+    }
+    uint64_t offsetsBytes = (n + 1) * sizeof(int64_t);
+    uint64_t adjacencyBytes = 2 * m * sizeof(int32_t);
+    uint64_t layoutBytes = 2 * n * sizeof(float);
+
+    // Каждая секция должна быть выровнена и целиком лежать внутри файла
+    auto fits = [&](uint64_t pos, uint64_t bytes) {
+        return pos % 8 == 0 && pos >= sizeof(BinaryGraphHeader) && pos <= fileSize && bytes <= fileSize - pos;
+    };
+    if (!fits(header.offsetsPos, offsetsBytes) || !fits(header.neighborsPos, adjacencyBytes) ||
+        !fits(header.edgesPos, adjacencyBytes) ||
+        ((header.flags & BinaryGraphFormat::FLAG_HAS_LAYOUT) && !fits(header.layoutPos, layoutBytes))) {
+        message = "секции выходят за пределы файла (файл повреждён или обрезан)";
+        return false;
+    }
+    return true;
+}
+
+// Проверить содержимое массивов за O(V + E): смещения не убывают и не
+// больше 2E, все соседи и концы рёбер - в диапазоне [0, n). Без этой
+// проверки испорченный файл приводит к чтению за пределами массивов
+// в обходах и раскладке
+bool validateContents(const BinaryGraphHeader& header, const char* base, std::string& message) {
+    int64_t n = header.numVertices;
+    int64_t adjacency = 2 * header.numEdges;
+    const int64_t* offsets = reinterpret_cast<const int64_t*>(base + header.offsetsPos);
+    if (offsets[0] != 0 || offsets[n] != adjacency) {
+        message = "некорректные смещения CSR";
+        return false;
+    }
+    for (int64_t v = 0; v < n; v++) {
+        if (offsets[v + 1] < offsets[v]) {
+            message = "смещения CSR убывают у вершины " + std::to_string(v);
+            return false;
+        }
+    }
+
+    // Номер вершины в диапазоне [0, n) - одно беззнаковое сравнение
+    uint32_t limit = static_cast<uint32_t>(n);
+    const int32_t* neighbors = reinterpret_cast<const int32_t*>(base + header.neighborsPos);
+    for (int64_t i = 0; i < adjacency; i++) {
+        if (static_cast<uint32_t>(neighbors[i]) >= limit) {
+            message = "номер соседа вне диапазона (позиция " + std::to_string(i) + ")";
+            return false;
+        }
+    }
+    const int32_t* edges = reinterpret_cast<const int32_t*>(base + header.edgesPos);
+    for (int64_t i = 0; i < adjacency; i++) {
+        if (static_cast<uint32_t>(edges[i]) >= limit) {
+            message = "конец ребра вне диапазона (ребро " + std::to_string(i / 2) + ")";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// Функция записи графа в бинарный файл
+bool BinaryGraphFormat::write(const std::string& filename, const Graph& graph,
+                              const std::vector<float>* layoutX, const std::vector<float>* layoutY) {
+    // Для записи нужен CSR; незамороженный граф замораживаем на копии
+    const Graph* source = &graph;
+    Graph frozenCopy(0);
+    if (!graph.isFrozen()) {
+        frozenCopy = graph;
+        frozenCopy.freeze();
+        source = &frozenCopy;
+    }
+    const CSRStorage* csr = source->getCSR();
+    int n = source->getNumVertices();
+
+    // Координаты записываем, только если их количество совпадает с числом вершин
+    bool hasLayout = layoutX && layoutY &&
+                     static_cast<int>(layoutX->size()) == n && static_cast<int>(layoutY->size()) == n;
+
+    // Открываем файл для записи
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    // Рассчитываем позиции секций
+    uint64_t offsetsBytes = (static_cast<uint64_t>(n) + 1) * sizeof(int64_t);
+    uint64_t adjacencyBytes = 2 * static_cast<uint64_t>(csr->numEdges) * sizeof(int32_t);
+    BinaryGraphHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = hasLayout ? FLAG_HAS_LAYOUT : 0;
+    header.numVertices = n;
+    header.numEdges = static_cast<int64_t>(csr->numEdges);
+    header.offsetsPos = sizeof(BinaryGraphHeader);
+    header.neighborsPos = align8(header.offsetsPos + offsetsBytes);
+    header.edgesPos = align8(header.neighborsPos + adjacencyBytes);
+    header.layoutPos = hasLayout ? align8(header.edgesPos + adjacencyBytes) : 0;
+
+    // Записываем заголовок и секции
+    uint64_t position = 0;
+    writeArray(file, position, &header, sizeof(header));
+    writeArray(file, position, csr->offsets, offsetsBytes);
+    writePadding(file, position);
+    writeArray(file, position, csr->neighbors, adjacencyBytes);
+    writePadding(file, position);
+    // Секция рёбер (для потокового чтения EdgeStream) восстанавливается из CSR порциями
+    std::vector<std::pair<int, int>> block;
+    block.reserve(WRITE_BLOCK_EDGES);
+    for (const auto& edge : source->getEdges()) {
+        block.push_back(edge);
+        if (block.size() == WRITE_BLOCK_EDGES) {
+            writeArray(file, position, block.data(), block.size() * sizeof(std::pair<int, int>));
+            block.clear();
+        }
+    }
+    writeArray(file, position, block.data(), block.size() * sizeof(std::pair<int, int>));
+    if (hasLayout) {
+        writePadding(file, position);
+        writeArray(file, position, layoutX->data(), n * sizeof(float));
+        writeArray(file, position, layoutY->data(), n * sizeof(float));
+    }
+
+    file.close();
+    if (!file) {
+        std::cerr << "Ошибка: не удалось записать файл " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция чтения сохранённых координат вершин
+bool BinaryGraphFormat::readLayout(const std::string& filename, std::vector<float>& x, std::vector<float>& y) {
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    if (file.size() < sizeof(BinaryGraphHeader)) {
+        std::cerr << "Ошибка: " << filename << ": файл короче заголовка" << std::endl;
+        return false;
+    }
+
+    BinaryGraphHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    std::string message;
+    if (!validateHeader(header, file.size(), message)) {
+        std::cerr << "Ошибка: " << filename << ": " << message << std::endl;
+        return false;
+    }
+    if (!(header.flags & FLAG_HAS_LAYOUT)) {
+        std::cerr << "Ошибка: в файле " << filename << " нет сохранённых координат" << std::endl;
+        return false;
+    }
+
+    // Копируем координаты (они нужны визуализатору в изменяемом виде)
+    size_t n = static_cast<size_t>(header.numVertices);
+    const float* layout = reinterpret_cast<const float*>(file.data() + header.layoutPos);
+    x.assign(layout, layout + n);
+    y.assign(layout + n, layout + 2 * n);
+    return true;
+}
+
+// Функция чтения и проверки заголовка бинарного файла
+bool BinaryGraphFormat::readHeader(const std::string& filename, BinaryGraphHeader& header) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Ошибка: " << filename << ": файл короче заголовка" << std::endl;
+        return false;
+    }
+    std::string message;
+    if (!validateHeader(header, fileSize, message)) {
+        std::cerr << "Ошибка: " << filename << ": " << message << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция проверки сигнатуры бинарного файла
+bool BinaryGraphFormat::isBinaryFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// Функция конвертации текстового файла в бинарный
+bool BinaryGraphFormat::convertTextToBinary(const std::string& textFile, const std::string& binaryFile, int numThreads) {
+    Graph graph = Graph::loadFromFile(textFile, numThreads);
+    if (graph.getNumVertices() == 0) {
+        std::cerr << "Ошибка: не удалось загрузить граф из " << textFile << std::endl;
+        return false;
+    }
+    return write(binaryFile, graph);
+}
+
+// Функция конвертации бинарного файла в текстовый
+bool BinaryGraphFormat::convertBinaryToText(const std::string& binaryFile, const std::string& textFile) {
+    Graph graph = Graph::openBinary(binaryFile);
+    if (graph.getNumVertices() == 0) {
+        std::cerr << "Ошибка: не удалось открыть граф из " << binaryFile << std::endl;
+        return false;
+    }
+    return graph.saveToFile(textFile);
+}
+
+// Статическая функция открытия бинарного файла графа
+// Массивы CSR берутся прямо из отображения файла, без копирования
+Graph Graph::openBinary(const std::string& filename, bool validate) {
+    // Отображаем файл в память; отображение живёт, пока жив CSR графа
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(filename)) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return Graph(0);
+    }
+    if (file->size() < sizeof(BinaryGraphHeader)) {
+        std::cerr << "Ошибка: " << filename << ": файл короче заголовка" << std::endl;
+        return Graph(0);
+    }
+
+    // Проверяем заголовок и границы секций, затем (если файл не доверенный)
+    // содержимое массивов
+    BinaryGraphHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    std::string message;
+    if (!validateHeader(header, file->size(), message) ||
+        (validate && !validateContents(header, file->data(), message))) {
+        std::cerr << "Ошибка: " << filename << ": " << message << std::endl;
+        return Graph(0);
+    }
+
+    // Крайние смещения проверяются всегда (O(1)): от них зависит размер массива соседей
+    const int64_t* offsets = reinterpret_cast<const int64_t*>(file->data() + header.offsetsPos);
+    if (offsets[0] != 0 || offsets[header.numVertices] != 2 * header.numEdges) {
+        std::cerr << "Ошибка: " << filename << ": некорректные смещения CSR" << std::endl;
+        return Graph(0);
+    }
+
+    // Настраиваем указатели CSR на секции файла
+    auto storage = std::make_shared<CSRStorage>();
+    storage->offsets = offsets;
+    storage->neighbors = reinterpret_cast<const int*>(file->data() + header.neighborsPos);
+    storage->numEdges = static_cast<size_t>(header.numEdges);
+    storage->owner = file;
+
+    Graph graph(0);
+    graph.numVertices = static_cast<int>(header.numVertices);
+    // Union-find не строится: связность посчитается параллельно при первом запросе
+    graph.connectivityValid = false;
+    graph.csr = storage;
+    return graph;
+}
+
+// Функция сохранения графа в бинарный файл
+bool Graph::saveBinary(const std::string& filename) const {
+    return BinaryGraphFormat::write(filename, *this);
+}
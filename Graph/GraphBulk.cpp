@@ -0,0 +1,147 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем библиотеку для алгоритмов (sort)
+#include <algorithm>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+
+// Пакетное построение графа: вставка за O(1) с отложенным удалением дублей
+// и построение CSR напрямую из списка рёбер
+namespace {
+
+// Ключ ребра без учёта направления: (min, max) упакованные в 64 бита
+// Рёбра (u, v) и (v, u) получают одинаковый ключ
+inline uint64_t edgeKey(const std::pair<int, int>& edge) {
+    uint32_t a = static_cast<uint32_t>(std::min(edge.first, edge.second));
+    uint32_t b = static_cast<uint32_t>(std::max(edge.first, edge.second));
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+// Удалить дубли рёбер, сохранив первое вхождение и исходный порядок
+// Сортируем пары (ключ, позиция), в каждой группе одинаковых ключей
+// оставляем минимальную позицию - это ровно то ребро, которое принял бы addEdge
+void deduplicateEdges(std::vector<std::pair<int, int>>& edges) {
+    size_t m = edges.size();
+    if (m < 2) return;
+    
+    // Пары (ключ ребра, позиция в исходном списке)
+    std::vector<std::pair<uint64_t, size_t>> keyed(m);
+    for (size_t i = 0; i < m; i++) {
+        keyed[i] = {edgeKey(edges[i]), i};
+    }
+    std::sort(keyed.begin(), keyed.end());
+    
+    // Отмечаем первые вхождения каждого ключа
+    std::vector<bool> keep(m, false);
+    for (size_t i = 0; i < m; i++) {
+        if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+            keep[keyed[i].second] = true;
+        }
+    }
+    
+    // Сжимаем список рёбер на месте, сохраняя порядок
+    size_t write = 0;
+    for (size_t i = 0; i < m; i++) {
+        if (keep[i]) {
+            edges[write++] = edges[i];
+        }
+    }
+    edges.resize(write);
+}
+
+// Построить CSR по списку рёбер без дублей
+// Соседи каждой вершины идут в порядке рёбер (как в списках смежности)
+std::shared_ptr<CSRStorage> buildCSR(int numVertices, std::vector<std::pair<int, int>>&& edges) {
+    auto storage = std::make_shared<CSRStorage>();
+    
+    // Считаем степени вершин (петля (u, u) даёт вершине u два соседа)
+    storage->offsetStorage.assign(numVertices + 1, 0);
+    for (const auto& edge : edges) {
+        storage->offsetStorage[edge.first + 1]++;
+        storage->offsetStorage[edge.second + 1]++;
+    }
+    // Префиксные суммы степеней дают смещения
+    for (int v = 0; v < numVertices; v++) {
+        storage->offsetStorage[v + 1] += storage->offsetStorage[v];
+    }
+    
+    // Раскладываем соседей по своим участкам массива
+    storage->neighborStorage.resize(storage->offsetStorage[numVertices]);
+    std::vector<int64_t> cursor(storage->offsetStorage.begin(), storage->offsetStorage.end() - 1);
+    for (const auto& edge : edges) {
+        storage->neighborStorage[cursor[edge.first]++] = edge.second;
+        storage->neighborStorage[cursor[edge.second]++] = edge.first;
+    }
+    
+    // Список рёбер больше не нужен: getEdges восстанавливает рёбра из соседей
+    storage->offsets = storage->offsetStorage.data();
+    storage->neighbors = storage->neighborStorage.data();
+    storage->numEdges = edges.size();
+    std::vector<std::pair<int, int>>().swap(edges);
+    return storage;
+}
+
+} // namespace
+
+// Функция включения режима пакетной вставки
+void Graph::beginBulkInsert() {
+    // Замороженный граф изменять нельзя
+    if (csr) {
+        std::cerr << "Ошибка: граф заморожен (freeze), добавление рёбер невозможно" << std::endl;
+        return;
+    }
+    deferredInsert = true;
+}
+
+// Функция завершения пакетной вставки
+void Graph::finalize() {
+    // Если пакетная вставка не включена, списки уже в порядке
+    if (!deferredInsert) return;
+    deferredInsert = false;
+    
+    // Удаляем дубли за O(E log E) вместо O(степень) на каждую вставку
+    deduplicateEdges(edges);
+    
+    // Считаем степени, чтобы выделить память под каждый список один раз
+    std::vector<int> degree(numVertices, 0);
+    for (const auto& edge : edges) {
+        degree[edge.first]++;
+        degree[edge.second]++;
+    }
+    // Перестраиваем списки смежности в порядке рёбер
+    for (int v = 0; v < numVertices; v++) {
+        adjList[v].clear();
+        adjList[v].reserve(degree[v]);
+    }
+    for (const auto& edge : edges) {
+        adjList[edge.first].push_back(edge.second);
+        adjList[edge.second].push_back(edge.first);
+    }
+}
+
+// Статическая функция построения графа из списка рёбер
+Graph Graph::fromEdgeList(int vertices, EdgeView edgeList) {
+    GRAPH_PROFILE_SCOPE(FromEdgeList);
+    Graph graph(0);
+    graph.numVertices = vertices;
+    // Union-find не строится: связность посчитается параллельно при первом запросе
+    graph.connectivityValid = false;
+    
+    // Копируем только корректные рёбра (вне диапазона - сообщаем об ошибке)
+    std::vector<std::pair<int, int>> valid;
+    valid.reserve(edgeList.size());
+    for (const auto& edge : edgeList) {
+        if (edge.first < 0 || edge.first >= vertices || edge.second < 0 || edge.second >= vertices) {
+            std::cerr << "Ошибка: неверные номера вершин (" << edge.first << ", " << edge.second << ")" << std::endl;
+            continue;
+        }
+        valid.push_back(edge);
+    }
+    
+    // Удаляем дубли и сразу строим CSR (списки смежности не создаются)
+    deduplicateEdges(valid);
+    graph.csr = buildCSR(vertices, std::move(valid));
+    return graph;
+}
@@ -0,0 +1,262 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем пул потоков
+#include "ThreadPool.h"
+// Подключаем потоковое чтение файла рёбер
+#include "EdgeStream.h"
+// Подключаем атомарные операции
+#include <atomic>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+
+// Параллельный поиск компонент связности через неблокирующий union-find
+// Каждое ребро объединяет множества своих концов; корнем множества
+// всегда становится вершина с меньшим номером, поэтому после прохода
+// корень компоненты - её минимальная вершина
+namespace {
+
+// Размер порции рёбер/вершин для параллельных циклов
+const int64_t GRAIN = 4096;
+
+// Найти корень множества с сокращением пути вдвое (path halving)
+// Родитель всегда имеет меньший номер, поэтому запись предка
+// вместо родителя безопасна при одновременной работе потоков
+inline int findRoot(std::vector<std::atomic<int>>& parent, int x) {
+    while (true) {
+        int p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        int grand = parent[p].load(std::memory_order_relaxed);
+        if (grand != p) {
+            parent[x].compare_exchange_weak(p, grand, std::memory_order_relaxed);
+        }
+        x = grand;
+    }
+}
+
+// Объединить множества вершин u и v
+// Больший корень подвешивается к меньшему через CAS; если за это время
+// корень изменился (его подвесил другой поток), повторяем поиск
+inline void unite(std::vector<std::atomic<int>>& parent, int u, int v) {
+    while (true) {
+        u = findRoot(parent, u);
+        v = findRoot(parent, v);
+        if (u == v) return;
+        if (u < v) std::swap(u, v);
+        int expected = u;
+        if (parent[u].compare_exchange_strong(expected, v, std::memory_order_relaxed)) return;
+    }
+}
+
+// Перевести лес union-find в разметку компонент: корни ищутся
+// параллельно, затем получают компактные номера 0..k-1 (по возрастанию корня)
+void labelsFromForest(std::vector<std::atomic<int>>& parent, ThreadPool& pool, ComponentLabels& components) {
+    int n = static_cast<int>(parent.size());
+
+    // Находим корень каждой вершины (корень - минимальная вершина компоненты)
+    components.labels.resize(n);
+    pool.parallelFor(0, n, GRAIN * 4, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) {
+            components.labels[v] = findRoot(parent, static_cast<int>(v));
+        }
+    });
+
+    // Переводим корни в компактные номера
+    // Корень меньше всех вершин своей компоненты, поэтому к моменту
+    // обработки вершины номер её корня уже назначен
+    for (int v = 0; v < n; v++) {
+        int root = components.labels[v];
+        if (root == v) {
+            components.labels[v] = static_cast<int>(components.sizes.size());
+            components.sizes.push_back(1);
+        } else {
+            int label = components.labels[root];
+            components.labels[v] = label;
+            components.sizes[label]++;
+        }
+    }
+}
+
+} // namespace
+
+// Функция сброса кэша компонент связности
+void Graph::invalidateComponents() {
+    std::atomic_store(&componentCache, std::shared_ptr<const ComponentLabels>());
+}
+
+// Функция поиска корня множества вершины со сжатием пути
+int Graph::findConnectivityRoot(int vertex) {
+    // Поднимаемся к корню
+    int root = vertex;
+    while (connectivityParent[root] != root) {
+        root = connectivityParent[root];
+    }
+    // Подвешиваем все вершины пути прямо к корню
+    while (connectivityParent[vertex] != root) {
+        int next = connectivityParent[vertex];
+        connectivityParent[vertex] = root;
+        vertex = next;
+    }
+    return root;
+}
+
+// Функция объединения множеств концов ребра (объединение по размеру)
+void Graph::uniteConnectivity(int u, int v) {
+    // После удалений структура устарела - перестраиваем её один раз
+    if (!connectivityValid) {
+        rebuildConnectivity();
+    }
+    int rootU = findConnectivityRoot(u);
+    int rootV = findConnectivityRoot(v);
+    if (rootU == rootV) return;
+    
+    // Меньшее дерево подвешиваем к большему
+    if (connectivitySize[rootU] < connectivitySize[rootV]) std::swap(rootU, rootV);
+    connectivityParent[rootV] = rootU;
+    connectivitySize[rootU] += connectivitySize[rootV];
+    connectivityComponents--;
+}
+
+// Функция перестроения union-find по текущему списку рёбер
+void Graph::rebuildConnectivity() {
+    // Каждая вершина - отдельное множество
+    connectivityParent.resize(numVertices);
+    connectivitySize.assign(numVertices, 1);
+    for (int i = 0; i < numVertices; i++) {
+        connectivityParent[i] = i;
+    }
+    connectivityComponents = numVertices;
+    connectivityValid = true;
+    
+    // Объединяем концы всех рёбер
+    for (const auto& edge : getEdges()) {
+        uniteConnectivity(edge.first, edge.second);
+    }
+}
+
+// Функция получения разметки вершин по компонентам связности
+std::shared_ptr<const ComponentLabels> Graph::getComponentLabels(int numThreads) const {
+    // Если разметка уже посчитана и рёбра не менялись - возвращаем её
+    std::shared_ptr<const ComponentLabels> cached = std::atomic_load(&componentCache);
+    if (cached) return cached;
+    GRAPH_PROFILE_SCOPE(ConnectedComponents);
+    
+    // Union-find актуален - разметка строится из него без обхода рёбер
+    if (connectivityValid) {
+        std::shared_ptr<const ComponentLabels> result = labelsFromConnectivity();
+        std::atomic_store(&componentCache, result);
+        return result;
+    }
+
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool& pool = ThreadPool::select(numThreads, ownPool);
+    int n = numVertices;
+
+    // Каждая вершина - отдельное множество
+    std::vector<std::atomic<int>> parent(n);
+    pool.parallelFor(0, n, GRAIN * 4, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) parent[v].store(static_cast<int>(v), std::memory_order_relaxed);
+    });
+
+    // Один параллельный проход по рёбрам: у замороженного графа - по
+    // соседям CSR (каждое ребро - из меньшего конца), иначе - по списку рёбер
+    if (csr) {
+        const int64_t* offsets = csr->offsets;
+        const int* neighbors = csr->neighbors;
+        pool.parallelFor(0, n, GRAIN, [&](int64_t begin, int64_t end, int) {
+            for (int64_t u = begin; u < end; u++) {
+                for (int64_t i = offsets[u]; i < offsets[u + 1]; i++) {
+                    if (neighbors[i] > u) unite(parent, static_cast<int>(u), neighbors[i]);
+                }
+            }
+        });
+    } else {
+        pool.parallelFor(0, static_cast<int64_t>(edges.size()), GRAIN, [&](int64_t begin, int64_t end, int) {
+            for (int64_t i = begin; i < end; i++) {
+                unite(parent, edges[i].first, edges[i].second);
+            }
+        });
+    }
+
+    // Разметка по корням леса
+    auto components = std::make_shared<ComponentLabels>();
+    labelsFromForest(parent, pool, *components);
+
+    // Сохраняем в кэш (при гонке двух потоков оба результата одинаковы)
+    std::shared_ptr<const ComponentLabels> result = components;
+    std::atomic_store(&componentCache, result);
+    return result;
+}
+
+// Функция построения разметки из union-find за O(V)
+// Корни ищутся без изменения структуры (метод константный): для каждой
+// вершины поднимаемся до вершины с уже известным корнем и запоминаем
+// корень для всего пройденного пути, поэтому каждое ребро леса проходится один раз
+std::shared_ptr<const ComponentLabels> Graph::labelsFromConnectivity() const {
+    int n = numVertices;
+    auto components = std::make_shared<ComponentLabels>();
+    std::vector<int> root(n, -1);
+    std::vector<int> path;
+    for (int v = 0; v < n; v++) {
+        if (root[v] >= 0) continue;
+        int x = v;
+        path.clear();
+        while (root[x] < 0 && connectivityParent[x] != x) {
+            path.push_back(x);
+            x = connectivityParent[x];
+        }
+        int r = root[x] >= 0 ? root[x] : x;
+        root[x] = r;
+        for (int p : path) root[p] = r;
+    }
+    
+    // Компактные номера в порядке первой (минимальной) вершины компоненты
+    std::vector<int> rootLabel(n, -1);
+    components->labels.resize(n);
+    for (int v = 0; v < n; v++) {
+        int& label = rootLabel[root[v]];
+        if (label < 0) {
+            label = static_cast<int>(components->sizes.size());
+            components->sizes.push_back(0);
+        }
+        components->labels[v] = label;
+        components->sizes[label]++;
+    }
+    return components;
+}
+
+// Функция возвращает количество компонент связности
+int Graph::getComponentCount() const {
+    // Пока union-find актуален, количество компонент известно сразу
+    if (connectivityValid) return connectivityComponents;
+    return static_cast<int>(getComponentLabels()->sizes.size());
+}
+
+// Функция потокового поиска компонент связности файла рёбер
+ComponentLabels Graph::streamConnectedComponents(const std::string& filename, int numThreads) {
+    ComponentLabels components;
+    EdgeStream stream;
+    if (!stream.open(filename)) return components;
+    GRAPH_PROFILE_SCOPE(ConnectedComponents);
+
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool& pool = ThreadPool::select(numThreads, ownPool);
+    int n = stream.getNumVertices();
+
+    // Каждая вершина - отдельное множество
+    std::vector<std::atomic<int>> parent(n);
+    pool.parallelFor(0, n, GRAIN * 4, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) parent[v].store(static_cast<int>(v), std::memory_order_relaxed);
+    });
+
+    // Один последовательный проход по файлу: рёбра объединяются сразу
+    // в потоках разбора и нигде не накапливаются
+    bool complete = stream.forEachEdge(pool, [&](const std::pair<int, int>* edges, size_t count, int) {
+        for (size_t i = 0; i < count; i++) {
+            unite(parent, edges[i].first, edges[i].second);
+        }
+    });
+    if (!complete) return components;
+
+    labelsFromForest(parent, pool, components);
+    return components;
+}
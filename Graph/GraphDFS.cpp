@@ -0,0 +1,150 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем библиотеку для алгоритмов (min, sort)
+#include <algorithm>
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+
+// Итеративный обход в глубину с явным стеком "вершина + следующий сосед"
+// Рекурсия заменена стеком в памяти кучи: путь от корня хранится массивом,
+// поэтому глубина обхода ограничена только памятью, а не стеком вызовов
+namespace {
+
+// Элемент стека обхода: вершина пути и номер следующего соседа
+struct DFSFrame {
+    int vertex;
+    size_t next;
+};
+
+} // namespace
+
+// Функция обхода в глубину с временами входа и выхода
+DFSResult Graph::depthFirstSearchTree(int start) const {
+    DFSResult result;
+    if (start < -1 || start >= numVertices) {
+        std::cerr << "Ошибка: неверная стартовая вершина " << start << std::endl;
+        return result;
+    }
+    GRAPH_PROFILE_SCOPE(DepthFirstSearch);
+
+    result.discovery.assign(numVertices, -1);
+    result.finish.assign(numVertices, -1);
+    result.parents.assign(numVertices, -1);
+    std::vector<DFSFrame> stack;
+    int clock = 0;
+
+    // Корни: одна стартовая вершина или все вершины по возрастанию
+    int firstRoot = start >= 0 ? start : 0;
+    int lastRoot = start >= 0 ? start : numVertices - 1;
+    for (int root = firstRoot; root <= lastRoot; root++) {
+        if (result.discovery[root] != -1) continue;
+        result.discovery[root] = clock++;
+        result.parents[root] = root;
+        result.order.push_back(root);
+        stack.push_back({root, 0});
+
+        while (!stack.empty()) {
+            DFSFrame& frame = stack.back();
+            NeighborView neighbors = getAdjList(frame.vertex);
+            // Пропускаем уже посещённых соседей
+            while (frame.next < neighbors.size() && result.discovery[neighbors[frame.next]] != -1) {
+                frame.next++;
+            }
+            if (frame.next == neighbors.size()) {
+                // Все соседи пройдены - выход из вершины
+                result.finish[frame.vertex] = clock++;
+                stack.pop_back();
+                continue;
+            }
+            // Вход в непосещённого соседа
+            int child = neighbors[frame.next++];
+            result.discovery[child] = clock++;
+            result.parents[child] = frame.vertex;
+            result.order.push_back(child);
+            stack.push_back({child, 0});
+        }
+    }
+    GRAPH_PROFILE_COUNT(VerticesVisited, result.order.size());
+    return result;
+}
+
+// Функция поиска точек сочленения, мостов и компонент двусвязности
+// low[v] - наименьшее время входа, достижимое из поддерева v одним обратным
+// ребром. Для ребра дерева (p, v): если low[v] >= discovery[p], то поддерево v
+// не связано с предками p в обход p - p точка сочленения (корень - если у него
+// больше одного ребёнка), а рёбра над ребром (p, v) в стеке рёбер образуют
+// компоненту двусвязности. Если low[v] > discovery[p], ребро (p, v) - мост.
+BiconnectedComponents Graph::getBiconnectedComponents() const {
+    GRAPH_PROFILE_SCOPE(BiconnectedComponents);
+    BiconnectedComponents result;
+    result.componentStart.push_back(0);
+
+    std::vector<int> discovery(numVertices, -1);
+    std::vector<int> low(numVertices, 0);
+    std::vector<int> parents(numVertices, -1);
+    std::vector<char> articulation(numVertices, 0);
+    std::vector<DFSFrame> stack;
+    std::vector<std::pair<int, int>> edgeStack;   // Рёбра текущей компоненты (и её предков)
+    int clock = 0;
+
+    for (int root = 0; root < numVertices; root++) {
+        if (discovery[root] != -1) continue;
+        discovery[root] = low[root] = clock++;
+        int rootChildren = 0;
+        stack.push_back({root, 0});
+
+        while (!stack.empty()) {
+            DFSFrame& frame = stack.back();
+            int u = frame.vertex;
+            NeighborView neighbors = getAdjList(u);
+
+            if (frame.next < neighbors.size()) {
+                int w = neighbors[frame.next++];
+                // Петли и ребро к родителю (граф без кратных рёбер) пропускаем
+                if (w == u || w == parents[u]) continue;
+                if (discovery[w] == -1) {
+                    // Ребро дерева - спускаемся
+                    parents[w] = u;
+                    discovery[w] = low[w] = clock++;
+                    edgeStack.push_back({u, w});
+                    stack.push_back({w, 0});
+                } else if (discovery[w] < discovery[u]) {
+                    // Обратное ребро к предку (со стороны потомка - один раз)
+                    low[u] = std::min(low[u], discovery[w]);
+                    edgeStack.push_back({u, w});
+                }
+                continue;
+            }
+
+            // Вершина u закончена - поднимаемся к родителю
+            stack.pop_back();
+            if (u == root) continue;
+            int p = parents[u];
+            low[p] = std::min(low[p], low[u]);
+            if (low[u] >= discovery[p]) {
+                if (p == root) rootChildren++;
+                else articulation[p] = 1;
+                // Компонента - рёбра стека до ребра (p, u) включительно
+                std::pair<int, int> edge;
+                do {
+                    edge = edgeStack.back();
+                    edgeStack.pop_back();
+                    result.componentEdges.push_back(edge);
+                } while (edge.first != p || edge.second != u);
+                result.componentStart.push_back(static_cast<int>(result.componentEdges.size()));
+            }
+            if (low[u] > discovery[p]) {
+                result.bridges.push_back({std::min(p, u), std::max(p, u)});
+            }
+        }
+        if (rootChildren > 1) articulation[root] = 1;
+    }
+
+    for (int v = 0; v < numVertices; v++) {
+        if (articulation[v]) result.articulationPoints.push_back(v);
+    }
+    std::sort(result.bridges.begin(), result.bridges.end());
+    return result;
+}
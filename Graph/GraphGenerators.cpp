@@ -0,0 +1,125 @@
+// Подключаем заголовочный файл генераторов графов
+#include "GraphGenerators.h"
+// Подключаем генератор случайных чисел
+#include <random>
+// Подключаем библиотеку для алгоритмов (find)
+#include <algorithm>
+
+// Функция генерации случайного графа G(n, m)
+GeneratedGraph GraphGenerators::erdosRenyi(int n, int64_t m, uint64_t seed) {
+    GeneratedGraph result;
+    result.numVertices = n;
+    // Без пары различных вершин рёбер быть не может
+    if (n < 2 || m <= 0) return result;
+
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    result.edges.reserve(static_cast<size_t>(m));
+    while (static_cast<int64_t>(result.edges.size()) < m) {
+        int u = vertex(random);
+        int v = vertex(random);
+        if (u == v) continue;  // Петли не создаём
+        result.edges.push_back({u, v});
+    }
+    return result;
+}
+
+// Функция генерации графа Барабаши-Альберт
+// Концы всех рёбер хранятся в одном массиве: случайный элемент этого
+// массива - вершина, выбранная с вероятностью, пропорциональной степени
+GeneratedGraph GraphGenerators::barabasiAlbert(int n, int edgesPerVertex, uint64_t seed) {
+    GeneratedGraph result;
+    result.numVertices = n;
+    if (n < 2 || edgesPerVertex <= 0) return result;
+
+    // Начальный полный граф на edgesPerVertex + 1 вершинах
+    int initial = std::min(n, edgesPerVertex + 1);
+    std::vector<int> endpoints;
+    endpoints.reserve(2 * static_cast<size_t>(n) * edgesPerVertex);
+    for (int i = 0; i < initial; i++) {
+        for (int j = i + 1; j < initial; j++) {
+            result.edges.push_back({i, j});
+            endpoints.push_back(i);
+            endpoints.push_back(j);
+        }
+    }
+
+    std::mt19937_64 random(seed);
+    std::vector<int> targets;
+    for (int v = initial; v < n; v++) {
+        // Выбираем edgesPerVertex разных вершин пропорционально степени
+        std::uniform_int_distribution<size_t> pick(0, endpoints.size() - 1);
+        targets.clear();
+        while (static_cast<int>(targets.size()) < edgesPerVertex) {
+            int u = endpoints[pick(random)];
+            if (std::find(targets.begin(), targets.end(), u) == targets.end()) {
+                targets.push_back(u);
+            }
+        }
+        for (int u : targets) {
+            result.edges.push_back({v, u});
+            endpoints.push_back(v);
+            endpoints.push_back(u);
+        }
+    }
+    return result;
+}
+
+// Функция генерации двумерной решётки
+GeneratedGraph GraphGenerators::grid2D(int rows, int cols) {
+    GeneratedGraph result;
+    if (rows <= 0 || cols <= 0) return result;
+    result.numVertices = rows * cols;
+    result.edges.reserve(2 * static_cast<size_t>(rows) * cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            int v = r * cols + c;
+            if (c + 1 < cols) result.edges.push_back({v, v + 1});      // Правый сосед
+            if (r + 1 < rows) result.edges.push_back({v, v + cols});   // Нижний сосед
+        }
+    }
+    return result;
+}
+
+// Функция генерации полного графа
+GeneratedGraph GraphGenerators::complete(int n) {
+    GeneratedGraph result;
+    result.numVertices = std::max(n, 0);
+    if (n > 1) result.edges.reserve(static_cast<size_t>(n) * (n - 1) / 2);
+    // j начинается с i+1 чтобы не дублировать рёбра
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            result.edges.push_back({i, j});
+        }
+    }
+    return result;
+}
+
+// Функция генерации графа-цикла
+GeneratedGraph GraphGenerators::cycle(int n) {
+    GeneratedGraph result;
+    result.numVertices = std::max(n, 0);
+    // Цикл существует начиная с трёх вершин
+    if (n < 3) return result;
+    result.edges.reserve(n);
+    for (int i = 0; i < n; i++) {
+        result.edges.push_back({i, (i + 1) % n});  // % n для замыкания цикла
+    }
+    return result;
+}
+
+// Функция генерации двудольного графа
+GeneratedGraph GraphGenerators::bipartite(int left, int right) {
+    GeneratedGraph result;
+    if (left <= 0 || right <= 0) return result;
+    result.numVertices = left + right;
+    result.edges.reserve(static_cast<size_t>(left) * right / 2 + 1);
+    for (int i = 0; i < left; i++) {                     // Проходим по первой доле
+        for (int j = left; j < left + right; j++) {      // Проходим по второй доле
+            if ((i + j) % 2 == 0) {                      // Соединяем через одну
+                result.edges.push_back({i, j});
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,272 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем пул потоков
+#include "ThreadPool.h"
+// Подключаем библиотеку для алгоритмов (min, swap)
+#include <algorithm>
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Обход в ширину из многих вершин одновременно (MS-BFS)
+// (M. Then et al., "The More the Merrier: Efficient Multi-Source Graph Traversal")
+// У каждой вершины - битовое множество обходов: бит i означает "обход из
+// источника i". Один просмотр списка соседей продвигает сразу все обходы,
+// которым нужна эта вершина, поэтому рёбра читаются один раз на пачку
+// источников, а не один раз на источник.
+namespace {
+
+// Параметр переключения направления: снизу вверх, когда рёбер у фронта
+// больше, чем (рёбра ещё не законченных вершин / ALPHA). В отличие от
+// обычного BFS, шаг снизу вверх не останавливается на первом соседе
+// во фронте (нужны биты всех обходов), поэтому он стоит почти все
+// оставшиеся рёбра, и порог выше, чем у parallelBreadthFirstSearch
+const int64_t ALPHA = 4;
+
+// Размер порции для параллельных циклов
+const int64_t GRAIN = 1024;
+
+// Номер младшего установленного бита (word != 0)
+inline int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Множество обходов одной вершины: WORDS слов по 64 обхода
+template <int WORDS>
+struct SourceBits {
+    uint64_t words[WORDS];
+
+    void clear() {
+        for (int w = 0; w < WORDS; w++) words[w] = 0;
+    }
+    bool any() const {
+        uint64_t all = 0;
+        for (int w = 0; w < WORDS; w++) all |= words[w];
+        return all != 0;
+    }
+    bool equals(const SourceBits& other) const {
+        for (int w = 0; w < WORDS; w++) {
+            if (words[w] != other.words[w]) return false;
+        }
+        return true;
+    }
+};
+
+// Пачка источников: до 64 * WORDS обходов за один проход
+template <int WORDS>
+class MultiSourceBatch {
+private:
+    typedef SourceBits<WORDS> Bits;
+
+    const CSRStorage& csr;
+    int n;
+    ThreadPool& pool;
+    std::vector<Bits> seen;         // Обходы, уже посетившие вершину
+    std::vector<Bits> frontier;     // Обходы, у которых вершина во фронте
+    std::vector<Bits> next;         // Фронт следующего уровня
+    std::vector<int> frontierList;  // Вершины с непустым frontier
+    std::vector<int> nextList;      // Вершины с непустым next
+    std::vector<std::vector<int>> localLists;  // Новые вершины фронта по потокам
+    std::vector<int64_t> localFinished;        // Рёбра законченных вершин по потокам
+    Bits full;                      // Все обходы пачки
+    int64_t unfinishedEdges;        // Сумма степеней вершин, которые посетили не все обходы
+
+    // Степень вершины
+    int64_t degree(int v) const {
+        return csr.offsets[v + 1] - csr.offsets[v];
+    }
+
+    // Записать расстояние level для всех обходов из bits
+    // Строка матрицы обхода i - rows[i * n .. (i + 1) * n): фронт обхода
+    // сдвигается по соседним вершинам, поэтому запись в строку почти
+    // последовательна
+    void record(int v, const Bits& bits, int level, int* rows) const {
+        for (int w = 0; w < WORDS; w++) {
+            uint64_t word = bits.words[w];
+            while (word) {
+                int source = w * 64 + lowestBit(word);
+                rows[static_cast<int64_t>(source) * n + v] = level;
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Шаг сверху вниз: фронт маленький, соседи вершин фронта получают его биты
+    // (последовательно - разные вершины фронта пишут в общих соседей)
+    void topDownStep(int level, int* rows) {
+        nextList.clear();
+        for (int u : frontierList) {
+            const Bits& bits = frontier[u];
+            for (int64_t k = csr.offsets[u]; k < csr.offsets[u + 1]; k++) {
+                int v = csr.neighbors[k];
+                Bits fresh;
+                bool any = false;
+                for (int w = 0; w < WORDS; w++) {
+                    fresh.words[w] = bits.words[w] & ~seen[v].words[w] & ~next[v].words[w];
+                    any |= fresh.words[w] != 0;
+                }
+                if (!any) continue;
+                if (!next[v].any()) nextList.push_back(v);
+                for (int w = 0; w < WORDS; w++) next[v].words[w] |= fresh.words[w];
+            }
+        }
+        // Новые биты становятся посещёнными только после шага,
+        // иначе вершина нового фронта продвинула бы обход дальше в этом же шаге
+        for (int v : nextList) {
+            for (int w = 0; w < WORDS; w++) seen[v].words[w] |= next[v].words[w];
+            record(v, next[v], level, rows);
+            if (seen[v].equals(full)) unfinishedEdges -= degree(v);
+        }
+    }
+
+    // Шаг снизу вверх: фронт большой, каждая вершина собирает биты фронта
+    // соседей. Вершина пишет только свои next и seen - без синхронизации
+    void bottomUpStep(int level, int* rows) {
+        for (auto& list : localLists) list.clear();
+        std::fill(localFinished.begin(), localFinished.end(), 0);
+        pool.parallelFor(0, n, GRAIN, [&](int64_t begin, int64_t end, int worker) {
+            std::vector<int>& list = localLists[worker];
+            int64_t finished = 0;
+            for (int64_t v = begin; v < end; v++) {
+                Bits& mine = seen[v];
+                // Вершину уже посетили все обходы пачки
+                if (mine.equals(full)) continue;
+                Bits gathered;
+                gathered.clear();
+                for (int64_t k = csr.offsets[v]; k < csr.offsets[v + 1]; k++) {
+                    const Bits& bits = frontier[csr.neighbors[k]];
+                    // Остальные соседи уже ничего не добавят
+                    bool complete = true;
+                    for (int w = 0; w < WORDS; w++) {
+                        gathered.words[w] |= bits.words[w];
+                        complete &= (gathered.words[w] | mine.words[w]) == full.words[w];
+                    }
+                    if (complete) break;
+                }
+                bool any = false;
+                for (int w = 0; w < WORDS; w++) {
+                    gathered.words[w] &= ~mine.words[w];
+                    any |= gathered.words[w] != 0;
+                }
+                if (!any) continue;
+                next[v] = gathered;
+                for (int w = 0; w < WORDS; w++) mine.words[w] |= gathered.words[w];
+                record(static_cast<int>(v), gathered, level, rows);
+                list.push_back(static_cast<int>(v));
+                if (mine.equals(full)) finished += degree(static_cast<int>(v));
+            }
+            localFinished[worker] += finished;
+        });
+        nextList.clear();
+        for (const auto& list : localLists) nextList.insert(nextList.end(), list.begin(), list.end());
+        for (int64_t finished : localFinished) unfinishedEdges -= finished;
+    }
+
+public:
+    MultiSourceBatch(const CSRStorage& storage, int numVertices, ThreadPool& threadPool)
+        : csr(storage), n(numVertices), pool(threadPool),
+          seen(numVertices), frontier(numVertices), next(numVertices),
+          localLists(threadPool.getThreadCount()), localFinished(threadPool.getThreadCount(), 0),
+          unfinishedEdges(0) {}
+
+    // Обойти граф из sources[0..count) и записать расстояния в строки rows
+    void run(const int* sources, int count, int* rows) {
+        // Битовые множества обнуляются параллельно (их 3 * n * WORDS слов)
+        pool.parallelFor(0, n, GRAIN * 16, [&](int64_t begin, int64_t end, int) {
+            for (int64_t v = begin; v < end; v++) {
+                seen[v].clear();
+                frontier[v].clear();
+                next[v].clear();
+            }
+        });
+        full.clear();
+        frontierList.clear();
+        for (int i = 0; i < count; i++) {
+            int s = sources[i];
+            uint64_t bit = uint64_t(1) << (i & 63);
+            full.words[i >> 6] |= bit;
+            if (!frontier[s].any()) frontierList.push_back(s);
+            frontier[s].words[i >> 6] |= bit;
+            seen[s].words[i >> 6] |= bit;
+            rows[static_cast<int64_t>(i) * n + s] = 0;
+        }
+        unfinishedEdges = csr.offsets[n];
+        for (int s : frontierList) {
+            if (seen[s].equals(full)) unfinishedEdges -= degree(s);
+        }
+
+        for (int level = 1; !frontierList.empty(); level++) {
+            // Рёбер у фронта мало - сверху вниз, иначе снизу вверх
+            int64_t scout = 0;
+            for (int u : frontierList) scout += degree(u);
+            if (scout > unfinishedEdges / ALPHA) {
+                bottomUpStep(level, rows);
+            } else {
+                topDownStep(level, rows);
+            }
+            // Старый фронт обнуляется (next снова пуст после обмена)
+            for (int u : frontierList) frontier[u].clear();
+            std::swap(frontier, next);
+            std::swap(frontierList, nextList);
+        }
+    }
+};
+
+} // namespace
+
+// Функция обхода в ширину из многих вершин
+MultiSourceBFSResult Graph::multiSourceBreadthFirstSearch(const std::vector<int>& sources, int numThreads) const {
+    MultiSourceBFSResult result;
+    for (int s : sources) {
+        if (s < 0 || s >= numVertices) {
+            std::cerr << "Ошибка: неверная стартовая вершина " << s << std::endl;
+            return result;
+        }
+    }
+
+    // Алгоритм работает по CSR; незамороженный граф замораживаем на копии
+    if (!csr) {
+        Graph frozenCopy = *this;
+        frozenCopy.freeze();
+        return frozenCopy.multiSourceBreadthFirstSearch(sources, numThreads);
+    }
+    GRAPH_PROFILE_SCOPE(MultiSourceBreadthFirstSearch);
+
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool& pool = ThreadPool::select(numThreads, ownPool);
+    int n = numVertices;
+    int count = static_cast<int>(sources.size());
+
+    result.sources = sources;
+    result.numVertices = n;
+    result.distances.resize(static_cast<size_t>(count) * n);
+    pool.parallelFor(0, static_cast<int64_t>(result.distances.size()), GRAIN * 16,
+        [&](int64_t begin, int64_t end, int) {
+            std::fill(result.distances.begin() + begin, result.distances.begin() + end, -1);
+        });
+
+    // Пачки по 256 источников; остаток до 64 - узкими множествами (одно слово)
+    int first = 0;
+    if (count - first > MultiSourceBFSResult::NARROW_BATCH) {
+        MultiSourceBatch<MultiSourceBFSResult::WIDE_BATCH / 64> batch(*csr, n, pool);
+        for (; count - first > MultiSourceBFSResult::NARROW_BATCH; first += MultiSourceBFSResult::WIDE_BATCH) {
+            int size = std::min(MultiSourceBFSResult::WIDE_BATCH, count - first);
+            batch.run(sources.data() + first, size, result.distances.data() + static_cast<int64_t>(first) * n);
+        }
+    }
+    if (first < count) {
+        MultiSourceBatch<MultiSourceBFSResult::NARROW_BATCH / 64> batch(*csr, n, pool);
+        batch.run(sources.data() + first, count - first, result.distances.data() + static_cast<int64_t>(first) * n);
+    }
+    return result;
+}
@@ -0,0 +1,303 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем пул потоков
+#include "ThreadPool.h"
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем атомарные операции
+#include <atomic>
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем потоковое чтение файла рёбер (полувнешний обход)
+#include "EdgeStream.h"
+// Подключаем предел int (уровень ещё не достигнутой вершины)
+#include <climits>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Параллельный обход в ширину с переключением направления
+// (S. Beamer, K. Asanović, D. Patterson, "Direction-Optimizing Breadth-First Search")
+namespace {
+
+// Параметры переключения направления из статьи Beamer et al.
+// Снизу вверх, когда рёбер у фронта больше, чем (непроверенные рёбра / ALPHA);
+// обратно сверху вниз, когда фронт меньше n / BETA вершин
+const int64_t ALPHA = 15;
+const int64_t BETA = 18;
+
+// Размер порции для параллельных циклов
+const int64_t GRAIN = 1024;
+
+// Битовая карта вершин (64 вершины в одном слове)
+struct Bitmap {
+    std::vector<uint64_t> words;
+
+    explicit Bitmap(int size) : words((size + 63) / 64, 0) {}
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+    bool get(int v) const { return (words[v >> 6] >> (v & 63)) & 1; }
+    void set(int v) { words[v >> 6] |= uint64_t(1) << (v & 63); }
+};
+
+// Шаг сверху вниз: соседи фронта, ещё не имеющие родителя, получают родителя
+// через атомарный CAS (выигрывает ровно один поток)
+// Возвращает сумму степеней нового фронта (для выбора направления)
+int64_t topDownStep(ThreadPool& pool, const CSRStorage& csr, int level,
+                    const std::vector<int>& frontier, std::vector<int>& next,
+                    std::vector<std::atomic<int>>& parents, std::vector<int>& levels,
+                    std::vector<std::vector<int>>& localQueues) {
+    std::vector<int64_t> localScout(pool.getThreadCount(), 0);
+    for (auto& queue : localQueues) queue.clear();
+
+    pool.parallelFor(0, static_cast<int64_t>(frontier.size()), GRAIN / 16,
+        [&](int64_t begin, int64_t end, int worker) {
+            std::vector<int>& queue = localQueues[worker];
+            int64_t scout = 0;
+            for (int64_t i = begin; i < end; i++) {
+                int u = frontier[i];
+                for (int64_t k = csr.offsets[u]; k < csr.offsets[u + 1]; k++) {
+                    int v = csr.neighbors[k];
+                    int expected = -1;
+                    // Дешёвая проверка перед CAS - большинство соседей уже посещены
+                    if (parents[v].load(std::memory_order_relaxed) == -1 &&
+                        parents[v].compare_exchange_strong(expected, u, std::memory_order_relaxed)) {
+                        levels[v] = level + 1;
+                        queue.push_back(v);
+                        scout += csr.offsets[v + 1] - csr.offsets[v];
+                    }
+                }
+            }
+            localScout[worker] += scout;
+        });
+
+    // Склеиваем локальные очереди потоков в новый фронт
+    next.clear();
+    int64_t scoutCount = 0;
+    for (size_t w = 0; w < localQueues.size(); w++) {
+        next.insert(next.end(), localQueues[w].begin(), localQueues[w].end());
+        scoutCount += localScout[w];
+    }
+    return scoutCount;
+}
+
+// Шаг снизу вверх: каждая вершина без родителя ищет соседа во фронте
+// Каждую вершину обрабатывает один поток, порции выровнены на 64 вершины,
+// поэтому слова битовой карты next не пишутся из разных потоков
+// Возвращает размер нового фронта
+int64_t bottomUpStep(ThreadPool& pool, const CSRStorage& csr, int numVertices, int level,
+                     const Bitmap& frontier, Bitmap& next,
+                     std::vector<std::atomic<int>>& parents, std::vector<int>& levels) {
+    std::vector<int64_t> localAwake(pool.getThreadCount(), 0);
+    next.clear();
+
+    pool.parallelFor(0, numVertices, GRAIN * 4,
+        [&](int64_t begin, int64_t end, int worker) {
+            int64_t awake = 0;
+            for (int64_t v = begin; v < end; v++) {
+                if (parents[v].load(std::memory_order_relaxed) != -1) continue;
+                for (int64_t k = csr.offsets[v]; k < csr.offsets[v + 1]; k++) {
+                    int u = csr.neighbors[k];
+                    if (frontier.get(u)) {
+                        parents[v].store(u, std::memory_order_relaxed);
+                        levels[v] = level + 1;
+                        next.set(static_cast<int>(v));
+                        awake++;
+                        break;
+                    }
+                }
+            }
+            localAwake[worker] += awake;
+        });
+
+    int64_t awakeCount = 0;
+    for (int64_t count : localAwake) awakeCount += count;
+    return awakeCount;
+}
+
+// Номер младшего установленного бита (word != 0)
+inline int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+// Преобразовать очередь фронта в битовую карту
+// Запись в общее слово из разных потоков требует атомарности, поэтому
+// делаем это последовательно: фронт в этот момент мал по сравнению с графом
+void queueToBitmap(const std::vector<int>& queue, Bitmap& bitmap) {
+    bitmap.clear();
+    for (int v : queue) bitmap.set(v);
+}
+
+// Преобразовать битовую карту фронта в очередь (вершины по возрастанию)
+void bitmapToQueue(const Bitmap& bitmap, std::vector<int>& queue) {
+    queue.clear();
+    for (size_t w = 0; w < bitmap.words.size(); w++) {
+        uint64_t word = bitmap.words[w];
+        while (word) {
+            queue.push_back(static_cast<int>(w * 64 + lowestBit(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+// Уменьшить уровень вершины до candidate (атомарный минимум)
+// Возвращает true, если уровень уменьшился
+inline bool relaxLevel(std::vector<std::atomic<int>>& level, int v, int candidate) {
+    int current = level[v].load(std::memory_order_relaxed);
+    while (candidate < current) {
+        if (level[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// Функция параллельного обхода в ширину
+BFSResult Graph::parallelBreadthFirstSearch(int start, int numThreads) const {
+    BFSResult result;
+    if (start < 0 || start >= numVertices) {
+        std::cerr << "Ошибка: неверная стартовая вершина " << start << std::endl;
+        return result;
+    }
+
+    // Алгоритм работает по CSR; незамороженный граф замораживаем на копии
+    if (!csr) {
+        Graph frozenCopy = *this;
+        frozenCopy.freeze();
+        return frozenCopy.parallelBreadthFirstSearch(start, numThreads);
+    }
+    GRAPH_PROFILE_SCOPE(ParallelBreadthFirstSearch);
+
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool& pool = ThreadPool::select(numThreads, ownPool);
+    const CSRStorage& storage = *csr;
+    int n = numVertices;
+
+    // Родители (атомарные - их пишут несколько потоков) и уровни
+    std::vector<std::atomic<int>> parents(n);
+    result.levels.assign(n, -1);
+    pool.parallelFor(0, n, GRAIN * 16, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) parents[v].store(-1, std::memory_order_relaxed);
+    });
+    parents[start].store(start);
+    result.levels[start] = 0;
+
+    // Фронт в двух представлениях: очередь (сверху вниз) и битовая карта (снизу вверх)
+    std::vector<int> frontier(1, start);
+    std::vector<int> nextFrontier;
+    std::vector<std::vector<int>> localQueues(pool.getThreadCount());
+    Bitmap frontierBits(n);
+    Bitmap nextBits(n);
+
+    // Рёбра, которые ещё предстоит проверить сверху вниз (для эвристики)
+    int64_t edgesToCheck = storage.offsets[n];
+    int64_t scoutCount = storage.offsets[start + 1] - storage.offsets[start];
+    int level = 0;
+
+    while (!frontier.empty()) {
+        if (scoutCount > edgesToCheck / ALPHA) {
+            // Фронт большой - переходим к шагам снизу вверх
+            queueToBitmap(frontier, frontierBits);
+            int64_t awakeCount = static_cast<int64_t>(frontier.size());
+            int64_t oldAwakeCount;
+            do {
+                oldAwakeCount = awakeCount;
+                awakeCount = bottomUpStep(pool, storage, n, level, frontierBits, nextBits,
+                                          parents, result.levels);
+                std::swap(frontierBits, nextBits);
+                level++;
+                // Остаёмся снизу вверх, пока фронт растёт или остаётся большим
+            } while (awakeCount > 0 && (awakeCount >= oldAwakeCount || awakeCount > n / BETA));
+            bitmapToQueue(frontierBits, frontier);
+            scoutCount = 1;
+        } else {
+            // Фронт маленький - обычный шаг сверху вниз
+            edgesToCheck -= scoutCount;
+            scoutCount = topDownStep(pool, storage, level, frontier, nextFrontier,
+                                     parents, result.levels, localQueues);
+            std::swap(frontier, nextFrontier);
+            level++;
+        }
+    }
+
+    // Копируем родителей в обычный массив
+    result.parents.resize(n);
+    pool.parallelFor(0, n, GRAIN * 16, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) result.parents[v] = parents[v].load(std::memory_order_relaxed);
+    });
+
+    // Порядок обхода: сортировка подсчётом по уровню, внутри уровня - по номеру
+    int maxLevel = 0;
+    for (int v = 0; v < n; v++) maxLevel = std::max(maxLevel, result.levels[v]);
+    std::vector<int64_t> levelStart(maxLevel + 2, 0);
+    for (int v = 0; v < n; v++) {
+        if (result.levels[v] >= 0) levelStart[result.levels[v] + 1]++;
+    }
+    for (int l = 0; l <= maxLevel; l++) levelStart[l + 1] += levelStart[l];
+    result.order.resize(levelStart[maxLevel + 1]);
+    for (int v = 0; v < n; v++) {
+        if (result.levels[v] >= 0) result.order[levelStart[result.levels[v]]++] = v;
+    }
+    GRAPH_PROFILE_COUNT(VerticesVisited, result.order.size());
+    return result;
+}
+
+// Функция полувнешнего обхода в ширину по файлу рёбер
+std::vector<int> Graph::streamBreadthFirstSearch(const std::string& filename, int start, int numThreads,
+                                                 bool reportErrors) {
+    std::vector<int> levels;
+    EdgeStream stream;
+    if (!stream.open(filename)) return levels;
+    int n = stream.getNumVertices();
+    if (start < 0 || start >= n) {
+        std::cerr << "Ошибка: неверная стартовая вершина " << start << std::endl;
+        return levels;
+    }
+    GRAPH_PROFILE_SCOPE(BreadthFirstSearch);
+
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool& pool = ThreadPool::select(numThreads, ownPool);
+
+    // INT_MAX - вершина ещё не достигнута
+    std::vector<std::atomic<int>> level(n);
+    pool.parallelFor(0, n, GRAIN * 16, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) level[v].store(INT_MAX, std::memory_order_relaxed);
+    });
+    level[start].store(0, std::memory_order_relaxed);
+
+    // Проходы по файлу до первого прохода без изменений. Уровни только
+    // уменьшаются и всегда равны длине какого-то пути, поэтому неподвижная
+    // точка - точные расстояния (порядок рёбер и потоков на результат не влияет)
+    std::atomic<bool> changed(true);
+    for (int pass = 0; changed.load(); pass++) {
+        changed.store(false);
+        bool complete = stream.forEachEdge(pool, [&](const std::pair<int, int>* edges, size_t count, int) {
+            bool any = false;
+            for (size_t i = 0; i < count; i++) {
+                int u = edges[i].first, v = edges[i].second;
+                int levelU = level[u].load(std::memory_order_relaxed);
+                int levelV = level[v].load(std::memory_order_relaxed);
+                if (levelU != INT_MAX && levelU + 1 < levelV) any |= relaxLevel(level, v, levelU + 1);
+                else if (levelV != INT_MAX && levelV + 1 < levelU) any |= relaxLevel(level, u, levelV + 1);
+            }
+            if (any && !changed.load(std::memory_order_relaxed)) changed.store(true);
+        }, reportErrors && pass == 0);
+        if (!complete) return levels;
+    }
+
+    levels.resize(n);
+    pool.parallelFor(0, n, GRAIN * 16, [&](int64_t begin, int64_t end, int) {
+        for (int64_t v = begin; v < end; v++) {
+            int value = level[v].load(std::memory_order_relaxed);
+            levels[v] = value == INT_MAX ? -1 : value;
+        }
+    });
+    return levels;
+}
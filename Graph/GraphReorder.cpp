@@ -0,0 +1,293 @@
+// Подключаем заголовочный файл класса Graph с объявлением класса
+#include "Graph.h"
+// Подключаем библиотеку для алгоритмов (sort, stable_sort, reverse)
+#include <algorithm>
+// Подключаем библиотеку для ввода-вывода (cerr)
+#include <iostream>
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+
+// Перенумерация вершин для локальности памяти
+// Номера вершин во входном файле обычно случайны относительно структуры
+// графа: соседи вершины разбросаны по всем массивам, и обходы и шаг
+// раскладки (координаты концов рёбер) почти каждое обращение берут из
+// новой строки кэша. После перенумерации соседние вершины получают
+// близкие номера.
+namespace {
+
+// Степени всех вершин
+std::vector<int> vertexDegrees(const Graph& graph) {
+    int n = graph.getNumVertices();
+    std::vector<int> degrees(n);
+    for (int v = 0; v < n; v++) degrees[v] = graph.getDegree(v);
+    return degrees;
+}
+
+// Вершины по возрастанию степени (сортировка подсчётом, при равной
+// степени - по возрастанию номера)
+std::vector<int> verticesByDegree(const std::vector<int>& degrees) {
+    int n = static_cast<int>(degrees.size());
+    int maxDegree = 0;
+    for (int d : degrees) maxDegree = std::max(maxDegree, d);
+    std::vector<int> start(static_cast<size_t>(maxDegree) + 2, 0);
+    for (int d : degrees) start[d + 1]++;
+    for (int d = 0; d <= maxDegree; d++) start[d + 1] += start[d];
+    std::vector<int> order(n);
+    for (int v = 0; v < n; v++) order[start[degrees[v]]++] = v;
+    return order;
+}
+
+// Порядок обхода в ширину: компоненты - по возрастанию минимальной
+// вершины, соседи - в порядке списков смежности
+std::vector<int> breadthFirstOrder(const Graph& graph) {
+    int n = graph.getNumVertices();
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+    for (int root = 0; root < n; root++) {
+        if (visited[root]) continue;
+        visited[root] = 1;
+        // Очередью служит сам результат
+        size_t head = order.size();
+        order.push_back(root);
+        while (head < order.size()) {
+            int u = order[head++];
+            for (int v : graph.getAdjList(u)) {
+                if (!visited[v]) {
+                    visited[v] = 1;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+// Поиск псевдопериферийной вершины (эвристика Джорджа-Лю): обход в
+// ширину из start, новая стартовая вершина - с наименьшей степенью на
+// последнем уровне; повторяем, пока растёт эксцентриситет.
+// stamp/epoch - отметки посещения без очистки массива между обходами
+int pseudoPeripheral(const Graph& graph, const std::vector<int>& degrees, int start,
+                     std::vector<int>& stamp, int& epoch, std::vector<int>& queue) {
+    int eccentricity = -1;
+    // Несколько повторов достаточно: дальше эксцентриситет почти не растёт
+    for (int attempt = 0; attempt < 4; attempt++) {
+        epoch++;
+        queue.clear();
+        queue.push_back(start);
+        stamp[start] = epoch;
+        size_t head = 0;
+        int depth = -1;
+        size_t levelBegin = 0;
+        // Обход по уровням: [levelBegin, end) - последний законченный уровень
+        while (head < queue.size()) {
+            size_t end = queue.size();
+            levelBegin = head;
+            depth++;
+            for (; head < end; head++) {
+                for (int v : graph.getAdjList(queue[head])) {
+                    if (stamp[v] != epoch) {
+                        stamp[v] = epoch;
+                        queue.push_back(v);
+                    }
+                }
+            }
+        }
+        if (depth <= eccentricity) break;
+        eccentricity = depth;
+        int best = queue[levelBegin];
+        for (size_t i = levelBegin; i < queue.size(); i++) {
+            if (degrees[queue[i]] < degrees[best]) best = queue[i];
+        }
+        start = best;
+    }
+    return start;
+}
+
+// Обратный порядок Катхилла-Макки: обход в ширину из псевдопериферийной
+// вершины, непосещённые соседи добавляются по возрастанию степени,
+// затем весь порядок переворачивается
+std::vector<int> reverseCuthillMcKeeOrder(const Graph& graph) {
+    int n = graph.getNumVertices();
+    std::vector<int> degrees = vertexDegrees(graph);
+    std::vector<int> byDegree = verticesByDegree(degrees);
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> visited(n, 0);
+    std::vector<int> stamp(n, 0);
+    std::vector<int> queue;
+    std::vector<int> fresh;
+    int epoch = 0;
+    // Компоненты начинаются с вершин наименьшей степени
+    for (int candidate : byDegree) {
+        if (visited[candidate]) continue;
+        int root = pseudoPeripheral(graph, degrees, candidate, stamp, epoch, queue);
+        visited[root] = 1;
+        size_t head = order.size();
+        order.push_back(root);
+        while (head < order.size()) {
+            int u = order[head++];
+            fresh.clear();
+            for (int v : graph.getAdjList(u)) {
+                if (!visited[v]) {
+                    visited[v] = 1;
+                    fresh.push_back(v);
+                }
+            }
+            std::sort(fresh.begin(), fresh.end(), [&](int a, int b) {
+                return degrees[a] != degrees[b] ? degrees[a] < degrees[b] : a < b;
+            });
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// Порядок по убыванию степени (при равной степени - по возрастанию номера)
+std::vector<int> degreeOrder(const Graph& graph) {
+    std::vector<int> degrees = vertexDegrees(graph);
+    std::vector<int> order(degrees.size());
+    for (size_t v = 0; v < order.size(); v++) order[v] = static_cast<int>(v);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return degrees[a] > degrees[b];
+    });
+    return order;
+}
+
+// Найти корень сообщества (сокращение пути вдвое)
+inline int findCommunity(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// Приближение Rabbit order (J. Arai et al., "Rabbit Order: Just-in-time
+// Parallel Reordering for Fast Graph Analysis"): вершины по возрастанию
+// степени сливаются с соседним сообществом, дающим наибольший прирост
+// модулярности dQ ~ w(u, c) * 2m - deg(u) * deg(c). В отличие от
+// оригинала, учитываются только рёбра самой вершины, а не всего её
+// сообщества (списки смежности не объединяются) - один проход O(E α(V)).
+// Новые номера - обход в глубину дерева слияний: сообщество целиком
+// (и каждое вложенное сообщество) получает номера подряд
+std::vector<int> rabbitOrder(const Graph& graph) {
+    int n = graph.getNumVertices();
+    std::vector<int> degrees = vertexDegrees(graph);
+    int64_t twiceEdges = 0;
+    for (int d : degrees) twiceEdges += d;
+
+    std::vector<int> parent(n);
+    std::vector<int64_t> communityDegree(n);
+    for (int v = 0; v < n; v++) {
+        parent[v] = v;
+        communityDegree[v] = degrees[v];
+    }
+    // Дерево слияний: дети вершины - в порядке слияния
+    std::vector<int> firstChild(n, -1), lastChild(n, -1), nextSibling(n, -1);
+    // Количество рёбер вершины в каждое соседнее сообщество
+    std::vector<int> weight(n, 0);
+    std::vector<int> touched;
+
+    if (twiceEdges > 0) {
+        for (int u : verticesByDegree(degrees)) {
+            // u ещё ни с кем не слита, поэтому она - корень своего сообщества
+            touched.clear();
+            for (int v : graph.getAdjList(u)) {
+                int c = findCommunity(parent, v);
+                if (c == u) continue;
+                if (weight[c]++ == 0) touched.push_back(c);
+            }
+            int best = -1;
+            double bestGain = 0;
+            for (int c : touched) {
+                double gain = static_cast<double>(weight[c]) * static_cast<double>(twiceEdges) -
+                              static_cast<double>(communityDegree[u]) * static_cast<double>(communityDegree[c]);
+                if (gain > bestGain) {
+                    bestGain = gain;
+                    best = c;
+                }
+                weight[c] = 0;
+            }
+            if (best < 0) continue;
+            parent[u] = best;
+            communityDegree[best] += communityDegree[u];
+            if (lastChild[best] < 0) firstChild[best] = u;
+            else nextSibling[lastChild[best]] = u;
+            lastChild[best] = u;
+        }
+    }
+
+    // Обход в глубину дерева слияний от корней (по возрастанию номера)
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<int> stack;
+    for (int root = 0; root < n; root++) {
+        if (parent[root] != root) continue;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            order.push_back(v);
+            // Дети кладутся так, чтобы первым снимался первый слитый
+            size_t mark = stack.size();
+            for (int c = firstChild[v]; c >= 0; c = nextSibling[c]) stack.push_back(c);
+            std::reverse(stack.begin() + mark, stack.end());
+        }
+    }
+    return order;
+}
+
+} // namespace
+
+// Функция вычисления перенумерации вершин
+VertexPermutation Graph::computeOrdering(VertexOrdering ordering) const {
+    GRAPH_PROFILE_SCOPE(ReorderVertices);
+    switch (ordering) {
+        case VertexOrdering::ReverseCuthillMcKee:
+            return VertexPermutation(reverseCuthillMcKeeOrder(*this));
+        case VertexOrdering::Degree:
+            return VertexPermutation(degreeOrder(*this));
+        case VertexOrdering::BreadthFirst:
+            return VertexPermutation(breadthFirstOrder(*this));
+        case VertexOrdering::Rabbit:
+            return VertexPermutation(rabbitOrder(*this));
+    }
+    return VertexPermutation();
+}
+
+// Функция построения графа с перенумерованными вершинами
+Graph Graph::relabel(const VertexPermutation& permutation) const {
+    if (!permutation.isValid(numVertices)) {
+        std::cerr << "Ошибка: перестановка вершин не соответствует графу" << std::endl;
+        return Graph(0);
+    }
+    std::vector<std::pair<int, int>> mapped;
+    {
+        GRAPH_PROFILE_SCOPE(ReorderVertices);
+        EdgeView edgeList = getEdges();
+        mapped.reserve(edgeList.size());
+        for (const auto& edge : edgeList) {
+            mapped.emplace_back(permutation.oldToNew[edge.first], permutation.oldToNew[edge.second]);
+        }
+    }
+    // fromEdgeList сортирует рёбра, поэтому соседи в CSR - по новым номерам
+    Graph result = fromEdgeList(numVertices, EdgeView(mapped));
+    // Исходные номера - через прежнее соответствие, если граф уже перенумерован
+    result.originalIds.resize(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        result.originalIds[i] = getOriginalId(permutation.newToOld[i]);
+    }
+    return result;
+}
+
+// Функция возвращает исходный номер вершины
+int Graph::getOriginalId(int vertex) const {
+    return originalIds.empty() ? vertex : originalIds[vertex];
+}
+
+// Функция возвращает исходные номера всех вершин
+const std::vector<int>& Graph::getOriginalIds() const {
+    return originalIds;
+}
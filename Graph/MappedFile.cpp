@@ -0,0 +1,140 @@
+// Подключаем заголовочный файл отображения файла в память
+#include "MappedFile.h"
+
+// Системные заголовки для отображения файлов
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Содержимое пустого файла (отображения у него нет)
+const char EMPTY[1] = {0};
+
+} // namespace
+
+// Конструктор - файл ещё не открыт
+#ifdef _WIN32
+MappedFile::MappedFile() : ptr(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : ptr(nullptr), length(0), fd(-1) {}
+#endif
+
+// Деструктор - освобождаем отображение
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Функция отображения файла в память
+bool MappedFile::open(const std::string& filename) {
+    // Закрываем предыдущий файл, если он был открыт
+    close();
+
+#ifdef _WIN32
+    // Открываем файл только для чтения
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    // Узнаём размер файла
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    // Пустой файл отобразить нельзя: он открыт, но содержимого нет
+    if (fileSize.QuadPart == 0) {
+        fileHandle = file;
+        ptr = EMPTY;
+        return true;
+    }
+
+    // Создаём отображение и проецируем его целиком
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    ptr = static_cast<const char*>(view);
+    length = static_cast<size_t>(fileSize.QuadPart);
+#else
+    // Открываем файл только для чтения
+    int handle = ::open(filename.c_str(), O_RDONLY);
+    if (handle < 0) return false;
+
+    // Узнаём размер файла
+    struct stat info;
+    if (fstat(handle, &info) != 0) {
+        ::close(handle);
+        return false;
+    }
+    // Пустой файл отобразить нельзя: он открыт, но содержимого нет
+    if (info.st_size == 0) {
+        fd = handle;
+        ptr = EMPTY;
+        return true;
+    }
+
+    // Отображаем файл целиком
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, handle, 0);
+    if (view == MAP_FAILED) {
+        ::close(handle);
+        return false;
+    }
+    // Подсказываем ядру, что файл будет читаться последовательно
+    madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+    fd = handle;
+    ptr = static_cast<const char*>(view);
+    length = static_cast<size_t>(info.st_size);
+#endif
+    return true;
+}
+
+// Функция закрытия отображения
+void MappedFile::close() {
+#ifdef _WIN32
+    if (length > 0) UnmapViewOfFile(ptr);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    if (length > 0) munmap(const_cast<char*>(ptr), length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    ptr = nullptr;
+    length = 0;
+}
+
+// Функция проверки, открыт ли файл
+bool MappedFile::isOpen() const {
+    return ptr != nullptr;
+}
+
+// Функция возвращает указатель на содержимое файла
+const char* MappedFile::data() const {
+    return ptr;
+}
+
+// Функция возвращает размер файла в байтах
+size_t MappedFile::size() const {
+    return length;
+}
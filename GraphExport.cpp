@@ -0,0 +1,807 @@
+// Подключаем заголовочный файл экспорта картинок
+#include "GraphExport.h"
+// Подключаем пул потоков для параллельной растеризации полос
+#include "ThreadPool.h"
+// Подключаем библиотеку для ввода-вывода
+#include <iostream>
+// Подключаем библиотеку для записи файлов
+#include <fstream>
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем математические функции (sqrt, floor, ceil)
+#include <cmath>
+// Подключаем форматирование чисел (snprintf)
+#include <cstdio>
+// Подключаем целочисленные типы фиксированного размера
+#include <cstdint>
+// Подключаем умный указатель для собственного пула потоков
+#include <memory>
+
+// Внутренние функции растеризации и записи файлов
+namespace {
+
+// Цифры 0-9 растрового шрифта 5x7: по строке на байт, старший из 5 бит - левый пиксель
+const unsigned char DIGIT_FONT[10][7] = {
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}   // 9
+};
+const int GLYPH_WIDTH = 5;     // Ширина цифры в точках шрифта
+const int GLYPH_HEIGHT = 7;    // Высота цифры в точках шрифта
+const float FONT_CELL = 10.0f; // Высота строки шрифта в точках (размер шрифта / FONT_CELL = точка)
+
+// Номер вершины цифрами (с младшей); возвращает количество цифр
+int digitsOf(int value, int digits[12]) {
+    int count = 0;
+    do {
+        digits[count++] = value % 10;
+        value /= 10;
+    } while (value > 0);
+    return count;
+}
+
+// Сцена в пикселях картинки и списки элементов каждой полосы
+struct Scene {
+    const std::vector<float>& x;
+    const std::vector<float>& y;
+    const VisibleSet& visible;
+    const ExportView& view;
+    const ExportStyle& style;
+
+    float radius;              // Радиус вершины в пикселях
+    float halfWidth;           // Половина толщины ребра в пикселях
+    float fontPixels;          // Размер шрифта в пикселях
+    bool labels;               // Рисовать номера
+
+    int firstRow;              // Первая строка картинки, покрытая полосами
+    int stripRows;             // Высота полосы
+    int stripCount;            // Количество полос
+    std::vector<int> edgeStart, edgeItems;       // Рёбра полос (CSR)
+    std::vector<int> vertexStart, vertexItems;   // Вершины полос (CSR)
+
+    Scene(const std::vector<float>& px, const std::vector<float>& py, const VisibleSet& v,
+          const ExportView& w, const ExportStyle& s)
+        : x(px), y(py), visible(v), view(w), style(s),
+          radius(s.vertexRadius * w.scale), halfWidth(s.edgeWidth * w.scale / 2),
+          fontPixels(s.fontSize * w.scale), labels(s.drawLabels),
+          firstRow(0), stripRows(1), stripCount(0) {}
+
+    float screenX(int v) const { return x[v] * view.scale + view.offsetX; }
+    float screenY(int v) const { return y[v] * view.scale + view.offsetY; }
+
+    // Номер, который подписывается у вершины
+    int labelOf(int v) const { return style.labels ? (*style.labels)[v] : v; }
+
+    // Ширина подписи вершины в пикселях
+    float labelWidth(int v) const {
+        int digits[12];
+        int count = digitsOf(labelOf(v), digits);
+        float dot = fontPixels / FONT_CELL;
+        return count * GLYPH_WIDTH * dot + (count - 1) * dot;
+    }
+};
+
+// Разложить элементы по полосам (пропуская элементы за краями картинки)
+// Списки CSR: сначала количества, затем префиксные суммы, затем номера
+void addToStrips(const Scene& scene, float top, float bottom, std::vector<int>& start, int item,
+                 std::vector<int>* items) {
+    int first = static_cast<int>(std::floor((top - scene.firstRow) / scene.stripRows));
+    int last = static_cast<int>(std::floor((bottom - scene.firstRow) / scene.stripRows));
+    first = std::max(first, 0);
+    last = std::min(last, scene.stripCount - 1);
+    for (int s = first; s <= last; s++) {
+        if (items) (*items)[start[s]++] = item;
+        else start[s + 1]++;
+    }
+}
+
+// Собрать списки рёбер и вершин для полос [firstRow, firstRow + stripRows * stripCount)
+void buildStrips(Scene& scene, int firstRow, int stripRows, int stripCount) {
+    scene.firstRow = firstRow;
+    scene.stripRows = stripRows;
+    scene.stripCount = stripCount;
+    const float width = static_cast<float>(scene.view.width);
+    const float reach = scene.halfWidth + 1.0f;
+
+    // Проход 0 - подсчёт, проход 1 - заполнение
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 0) {
+            scene.edgeStart.assign(stripCount + 1, 0);
+            scene.vertexStart.assign(stripCount + 1, 0);
+        } else {
+            for (int s = 0; s < stripCount; s++) {
+                scene.edgeStart[s + 1] += scene.edgeStart[s];
+                scene.vertexStart[s + 1] += scene.vertexStart[s];
+            }
+            scene.edgeItems.resize(scene.edgeStart[stripCount]);
+            scene.vertexItems.resize(scene.vertexStart[stripCount]);
+        }
+        // Курсоры заполнения (начала полос сдвигаются, потом восстанавливаются)
+        std::vector<int> edgeCursor(scene.edgeStart.begin(), scene.edgeStart.end());
+        std::vector<int> vertexCursor(scene.vertexStart.begin(), scene.vertexStart.end());
+        std::vector<int>* edgeItems = pass == 1 ? &scene.edgeItems : nullptr;
+        std::vector<int>* vertexItems = pass == 1 ? &scene.vertexItems : nullptr;
+
+        for (size_t e = 0; e < scene.visible.edges.size(); e++) {
+            int u = scene.visible.edges[e].first;
+            int v = scene.visible.edges[e].second;
+            float ax = scene.screenX(u), bx = scene.screenX(v);
+            if (std::max(ax, bx) < -reach || std::min(ax, bx) > width + reach) continue;
+            float ay = scene.screenY(u), by = scene.screenY(v);
+            addToStrips(scene, std::min(ay, by) - reach, std::max(ay, by) + reach,
+                        pass == 0 ? scene.edgeStart : edgeCursor, static_cast<int>(e), edgeItems);
+        }
+        for (size_t k = 0; k < scene.visible.vertices.size(); k++) {
+            int v = scene.visible.vertices[k];
+            float cx = scene.screenX(v), cy = scene.screenY(v);
+            // Вершина занимает круг с обводкой и, возможно, подпись
+            float halfX = scene.radius + 1.0f, halfY = scene.radius + 1.0f;
+            if (scene.labels) {
+                halfX = std::max(halfX, scene.labelWidth(v) / 2 + 1.0f);
+                halfY = std::max(halfY, scene.fontPixels / 2 + 1.0f);
+            }
+            if (cx + halfX < 0 || cx - halfX > width) continue;
+            addToStrips(scene, cy - halfY, cy + halfY,
+                        pass == 0 ? scene.vertexStart : vertexCursor, static_cast<int>(k), vertexItems);
+        }
+    }
+}
+
+// Смешать цвет с пикселем с заданным покрытием (0..1)
+inline void blend(unsigned char* pixel, ExportColor color, float coverage) {
+    float alpha = coverage * color.a / 255.0f;
+    if (alpha <= 0) return;
+    pixel[0] = static_cast<unsigned char>(pixel[0] + (color.r - pixel[0]) * alpha + 0.5f);
+    pixel[1] = static_cast<unsigned char>(pixel[1] + (color.g - pixel[1]) * alpha + 0.5f);
+    pixel[2] = static_cast<unsigned char>(pixel[2] + (color.b - pixel[2]) * alpha + 0.5f);
+}
+
+// Полоса пикселей [rowBegin, rowEnd) картинки шириной width
+struct Band {
+    unsigned char* rgb;
+    int width;
+    int rowBegin, rowEnd;
+
+    unsigned char* pixel(int px, int py) const {
+        return rgb + (static_cast<size_t>(py - rowBegin) * width + px) * 3;
+    }
+};
+
+// Закрасить прямоугольник (край пикселя - по доле площади)
+void fillRect(const Band& band, float x0, float y0, float x1, float y1, ExportColor color) {
+    int px0 = std::max(0, static_cast<int>(std::floor(x0)));
+    int px1 = std::min(band.width - 1, static_cast<int>(std::ceil(x1)) - 1);
+    int py0 = std::max(band.rowBegin, static_cast<int>(std::floor(y0)));
+    int py1 = std::min(band.rowEnd - 1, static_cast<int>(std::ceil(y1)) - 1);
+    for (int py = py0; py <= py1; py++) {
+        float coverY = std::min(y1, py + 1.0f) - std::max(y0, static_cast<float>(py));
+        for (int px = px0; px <= px1; px++) {
+            float coverX = std::min(x1, px + 1.0f) - std::max(x0, static_cast<float>(px));
+            blend(band.pixel(px, py), color, coverX * coverY);
+        }
+    }
+}
+
+// Нарисовать отрезок толщиной 2 * halfWidth
+// В каждой строке перебираются только пиксели полосы вокруг прямой
+void drawSegment(const Band& band, float ax, float ay, float bx, float by, float halfWidth, ExportColor color) {
+    float dx = bx - ax, dy = by - ay;
+    float lengthSq = dx * dx + dy * dy;
+    float reach = halfWidth + 0.5f;
+    int py0 = std::max(band.rowBegin, static_cast<int>(std::floor(std::min(ay, by) - reach)));
+    int py1 = std::min(band.rowEnd - 1, static_cast<int>(std::ceil(std::max(ay, by) + reach)));
+    float boxX0 = std::min(ax, bx) - reach, boxX1 = std::max(ax, bx) + reach;
+    float length = std::sqrt(lengthSq);
+
+    for (int py = py0; py <= py1; py++) {
+        float cy = py + 0.5f;
+        // Пиксели строки, которые ближе reach к прямой
+        float left = boxX0, right = boxX1;
+        if (length > 0 && std::fabs(dy) > 1e-6f) {
+            float atRow = ax + (cy - ay) * dx / dy;
+            float spread = reach * length / std::fabs(dy);
+            left = std::max(left, atRow - spread);
+            right = std::min(right, atRow + spread);
+        }
+        int px0 = std::max(0, static_cast<int>(std::floor(left)));
+        int px1 = std::min(band.width - 1, static_cast<int>(std::ceil(right)));
+        for (int px = px0; px <= px1; px++) {
+            float cx = px + 0.5f;
+            // Расстояние от центра пикселя до отрезка
+            float t = lengthSq > 0 ? ((cx - ax) * dx + (cy - ay) * dy) / lengthSq : 0.0f;
+            t = std::min(1.0f, std::max(0.0f, t));
+            float ex = cx - (ax + t * dx), ey = cy - (ay + t * dy);
+            float coverage = reach - std::sqrt(ex * ex + ey * ey);
+            if (coverage > 0) blend(band.pixel(px, py), color, std::min(1.0f, coverage));
+        }
+    }
+}
+
+// Нарисовать круг вершины с обводкой толщиной в пиксель
+void drawVertex(const Band& band, float cx, float cy, float radius, ExportColor fill, ExportColor outline) {
+    float reach = radius + 1.0f;
+    int py0 = std::max(band.rowBegin, static_cast<int>(std::floor(cy - reach)));
+    int py1 = std::min(band.rowEnd - 1, static_cast<int>(std::ceil(cy + reach)));
+    int px0 = std::max(0, static_cast<int>(std::floor(cx - reach)));
+    int px1 = std::min(band.width - 1, static_cast<int>(std::ceil(cx + reach)));
+    for (int py = py0; py <= py1; py++) {
+        float ey = py + 0.5f - cy;
+        for (int px = px0; px <= px1; px++) {
+            float ex = px + 0.5f - cx;
+            float distance = std::sqrt(ex * ex + ey * ey);
+            unsigned char* pixel = band.pixel(px, py);
+            float inside = radius + 0.5f - distance;
+            if (inside > 0) blend(pixel, fill, std::min(1.0f, inside));
+            float ring = 1.0f - std::fabs(distance - radius);
+            if (ring > 0) blend(pixel, outline, ring);
+        }
+    }
+}
+
+// Нарисовать номер вершины по центру точки
+void drawLabel(const Scene& scene, const Band& band, int v, float cx, float cy) {
+    int digits[12];
+    int count = digitsOf(scene.labelOf(v), digits);
+    float dot = scene.fontPixels / FONT_CELL;
+    float left = cx - scene.labelWidth(v) / 2;
+    // Цифра высотой 7 точек посередине строки высотой 10 точек
+    float top = cy - scene.fontPixels / 2 + (FONT_CELL - GLYPH_HEIGHT) / 2 * dot;
+    for (int k = count - 1; k >= 0; k--) {
+        const unsigned char* glyph = DIGIT_FONT[digits[k]];
+        for (int row = 0; row < GLYPH_HEIGHT; row++) {
+            float y0 = top + row * dot;
+            if (y0 + dot < band.rowBegin || y0 > band.rowEnd) continue;
+            for (int col = 0; col < GLYPH_WIDTH; col++) {
+                if (glyph[row] & (0x10 >> col)) {
+                    float x0 = left + col * dot;
+                    fillRect(band, x0, y0, x0 + dot, y0 + dot, scene.style.textColor);
+                }
+            }
+        }
+        left += (GLYPH_WIDTH + 1) * dot;
+    }
+}
+
+// Растеризовать полосу strip сцены в буфер rgb
+void rasterizeStrip(const Scene& scene, int strip, std::vector<unsigned char>& rgb) {
+    Band band;
+    band.width = scene.view.width;
+    band.rowBegin = scene.firstRow + strip * scene.stripRows;
+    band.rowEnd = std::min(scene.view.height, band.rowBegin + scene.stripRows);
+    rgb.resize(static_cast<size_t>(band.rowEnd - band.rowBegin) * band.width * 3);
+    band.rgb = rgb.data();
+
+    // Фон
+    const ExportColor background = scene.style.backgroundColor;
+    for (size_t i = 0; i < rgb.size(); i += 3) {
+        rgb[i] = background.r;
+        rgb[i + 1] = background.g;
+        rgb[i + 2] = background.b;
+    }
+
+    // Плотные области (их мало - проверяются все)
+    for (const DensityTile& tile : scene.visible.tiles) {
+        float x0 = tile.x * scene.view.scale + scene.view.offsetX;
+        float y0 = tile.y * scene.view.scale + scene.view.offsetY;
+        float size = tile.size * scene.view.scale;
+        if (y0 + size < band.rowBegin || y0 > band.rowEnd) continue;
+        ExportColor color = scene.style.vertexColor;
+        color.a = static_cast<unsigned char>(64 + 191 * scene.visible.tileDensity(tile));
+        fillRect(band, x0, y0, x0 + size, y0 + size, color);
+    }
+
+    // Рёбра, затем вершины, затем номера (тот же порядок слоёв, что в draw())
+    for (int i = scene.edgeStart[strip]; i < scene.edgeStart[strip + 1]; i++) {
+        const auto& edge = scene.visible.edges[scene.edgeItems[i]];
+        drawSegment(band, scene.screenX(edge.first), scene.screenY(edge.first),
+                    scene.screenX(edge.second), scene.screenY(edge.second),
+                    scene.halfWidth, scene.style.edgeColor);
+    }
+    for (int i = scene.vertexStart[strip]; i < scene.vertexStart[strip + 1]; i++) {
+        int v = scene.visible.vertices[scene.vertexItems[i]];
+        drawVertex(band, scene.screenX(v), scene.screenY(v), scene.radius,
+                   scene.style.vertexColor, scene.style.outlineColor);
+    }
+    if (scene.labels) {
+        for (int i = scene.vertexStart[strip]; i < scene.vertexStart[strip + 1]; i++) {
+            int v = scene.visible.vertices[scene.vertexItems[i]];
+            drawLabel(scene, band, v, scene.screenX(v), scene.screenY(v));
+        }
+    }
+}
+
+// ===== DEFLATE =====
+
+// Основания длин совпадений для кодов 257-285 и количество дополнительных бит
+const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+// Основания расстояний для кодов 0-29 и количество дополнительных бит
+const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                    8193, 12289, 16385, 24577};
+const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Окно deflate, самое длинное совпадение и глубина поиска по цепочке хэша
+const int DEFLATE_WINDOW = 32768;
+const int DEFLATE_MAX_MATCH = 258;
+const int DEFLATE_MAX_CHAIN = 32;
+const int DEFLATE_HASH_BITS = 15;
+
+// Запись битового потока deflate (младший бит байта - первый)
+class BitWriter {
+private:
+    std::vector<unsigned char>& out;
+    uint64_t bits;   // Накопленные, ещё не записанные биты
+    int count;       // Количество накопленных бит
+
+public:
+    explicit BitWriter(std::vector<unsigned char>& o) : out(o), bits(0), count(0) {}
+
+    // Записать n младших бит value (числа и дополнительные биты)
+    void put(uint32_t value, int n) {
+        bits |= static_cast<uint64_t>(value) << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back(static_cast<unsigned char>(bits));
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+
+    // Записать код Хаффмана длины n (коды пишутся старшим битом вперёд)
+    void putCode(uint32_t code, int n) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < n; i++) reversed |= ((code >> i) & 1) << (n - 1 - i);
+        put(reversed, n);
+    }
+
+    // Дописать неполный байт нулями
+    void align() {
+        if (count > 0) put(0, 8 - count);
+    }
+};
+
+// Записать символ фиксированного кода литералов и длин (RFC 1951, 3.2.6)
+void putFixedSymbol(BitWriter& writer, int symbol) {
+    if (symbol < 144) writer.putCode(0x30 + symbol, 8);
+    else if (symbol < 256) writer.putCode(0x190 + symbol - 144, 9);
+    else if (symbol < 280) writer.putCode(symbol - 256, 7);
+    else writer.putCode(0xC0 + symbol - 280, 8);
+}
+
+// Записать совпадение: код длины, код расстояния и их дополнительные биты
+void putMatch(BitWriter& writer, int length, int distance) {
+    int l = 28;
+    while (LENGTH_BASE[l] > length) l--;
+    putFixedSymbol(writer, 257 + l);
+    writer.put(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+    int d = 29;
+    while (DISTANCE_BASE[d] > distance) d--;
+    writer.putCode(d, 5);
+    writer.put(distance - DISTANCE_BASE[d], DISTANCE_EXTRA[d]);
+}
+
+// Сжать данные одним блоком deflate с фиксированными кодами Хаффмана
+// (жадный поиск повторов LZ77 по цепочкам хэша трёх байт). Повторы ищутся
+// только внутри data, поэтому полосы сжимаются независимо и параллельно.
+// Если блок не последний (final = false), за ним идёт пустой несжатый блок:
+// поток выравнивается на байт и следующую полосу можно дописать следом
+void deflateFixed(const unsigned char* data, size_t size, bool final, std::vector<unsigned char>& out) {
+    out.clear();
+    BitWriter writer(out);
+    writer.put(final ? 1 : 0, 1);
+    writer.put(1, 2);   // Фиксированные коды Хаффмана
+
+    std::vector<int> head(size_t(1) << DEFLATE_HASH_BITS, -1);
+    std::vector<int> previous(size);
+    auto hashAt = [&](size_t i) {
+        uint32_t key = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        return (key * 2654435761u) >> (32 - DEFLATE_HASH_BITS);
+    };
+    auto insert = [&](size_t i) {
+        if (i + 3 > size) return;
+        uint32_t h = hashAt(i);
+        previous[i] = head[h];
+        head[h] = static_cast<int>(i);
+    };
+
+    size_t i = 0;
+    while (i < size) {
+        int bestLength = 0, bestDistance = 0;
+        if (i + 3 <= size) {
+            int limit = static_cast<int>(std::min<size_t>(DEFLATE_MAX_MATCH, size - i));
+            int candidate = head[hashAt(i)];
+            for (int chain = 0; candidate >= 0 && chain < DEFLATE_MAX_CHAIN; chain++) {
+                int distance = static_cast<int>(i) - candidate;
+                if (distance > DEFLATE_WINDOW) break;
+                int length = 0;
+                while (length < limit && data[candidate + length] == data[i + length]) length++;
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = distance;
+                    if (length == limit) break;
+                }
+                candidate = previous[candidate];
+            }
+        }
+        if (bestLength >= 3) {
+            putMatch(writer, bestLength, bestDistance);
+            for (int k = 0; k < bestLength; k++) insert(i + k);
+            i += bestLength;
+        } else {
+            putFixedSymbol(writer, data[i]);
+            insert(i);
+            i++;
+        }
+    }
+    putFixedSymbol(writer, 256);   // Конец блока
+
+    if (!final) {
+        // Пустой несжатый блок: заголовок, выравнивание, длина 0 и её дополнение
+        writer.put(0, 3);
+        writer.align();
+        out.push_back(0x00);
+        out.push_back(0x00);
+        out.push_back(0xFF);
+        out.push_back(0xFF);
+    }
+    writer.align();
+}
+
+// ===== PNG =====
+
+// Таблица CRC-32 (многочлен 0xEDB88320), строится при первом обращении
+const uint32_t* crcTable() {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+        ready = true;
+    }
+    return table;
+}
+
+// Продолжить CRC-32 (crc - значение после предыдущих байтов, в начале 0)
+uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+    const uint32_t* table = crcTable();
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Записать 32-битное число старшим байтом вперёд
+void putBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// Полоса PNG, подготовленная к записи
+struct PngStrip {
+    std::vector<unsigned char> rgb;      // Пиксели полосы
+    std::vector<unsigned char> raw;      // Строки с байтами фильтров (несжатые данные)
+    std::vector<unsigned char> packed;   // Сжатые данные deflate
+};
+
+// Оценка отфильтрованной строки: сумма модулей байтов как чисел со знаком
+// (чем меньше, тем лучше строка сжимается - эвристика libpng)
+uint32_t filterCost(const unsigned char* row, size_t size) {
+    uint32_t cost = 0;
+    for (size_t i = 0; i < size; i++) cost += row[i] < 128 ? row[i] : 256 - row[i];
+    return cost;
+}
+
+// Добавить к строкам PNG байт фильтра: для каждой строки выбирается лучший
+// из фильтров None, Sub и Up (первая строка полосы - без Up: строка выше
+// принадлежит другой полосе)
+void filterRows(const std::vector<unsigned char>& rgb, int width, int rows, std::vector<unsigned char>& raw) {
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    raw.resize((rowBytes + 1) * rows);
+    std::vector<unsigned char> candidate(rowBytes);
+    for (int r = 0; r < rows; r++) {
+        const unsigned char* row = rgb.data() + r * rowBytes;
+        unsigned char* out = raw.data() + r * (rowBytes + 1);
+        out[0] = 0;
+        std::copy(row, row + rowBytes, out + 1);
+        uint32_t best = filterCost(out + 1, rowBytes);
+
+        for (size_t i = 0; i < rowBytes; i++) {
+            candidate[i] = static_cast<unsigned char>(row[i] - (i >= 3 ? row[i - 3] : 0));
+        }
+        uint32_t cost = filterCost(candidate.data(), rowBytes);
+        if (cost < best) {
+            best = cost;
+            out[0] = 1;
+            std::copy(candidate.begin(), candidate.end(), out + 1);
+        }
+
+        if (r > 0) {
+            const unsigned char* above = row - rowBytes;
+            for (size_t i = 0; i < rowBytes; i++) candidate[i] = static_cast<unsigned char>(row[i] - above[i]);
+            if (filterCost(candidate.data(), rowBytes) < best) {
+                out[0] = 2;
+                std::copy(candidate.begin(), candidate.end(), out + 1);
+            }
+        }
+    }
+}
+
+// Подготовить полосу strip: растеризовать, отфильтровать строки и сжать
+void preparePngStrip(const Scene& scene, int strip, bool last, PngStrip& out) {
+    rasterizeStrip(scene, strip, out.rgb);
+    int rows = std::min(scene.stripRows, scene.view.height - scene.firstRow - strip * scene.stripRows);
+    filterRows(out.rgb, scene.view.width, rows, out.raw);
+    deflateFixed(out.raw.data(), out.raw.size(), last, out.packed);
+}
+
+// Потоковая запись PNG: сжатые данные - поток zlib из блоков deflate
+// (по блоку на полосу), разбитый на чанки IDAT (по чанку на полосу)
+class PngStream {
+private:
+    std::ofstream& file;
+    uint32_t adlerA, adlerB;             // Контрольная сумма Adler-32 несжатых данных
+    bool headerWritten;                  // Заголовок zlib уже записан
+    std::vector<unsigned char> chunk;    // Буфер чанка
+
+    // Записать чанк: длина, тип, данные, CRC(тип + данные)
+    void writeChunk(const char* type, const std::vector<unsigned char>& data) {
+        std::vector<unsigned char> out;
+        out.reserve(data.size() + 12);
+        putBigEndian(out, static_cast<uint32_t>(data.size()));
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        putBigEndian(out, crc32(0, out.data() + 4, data.size() + 4));
+        file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    }
+
+    // Добавить байты к Adler-32 (остаток берётся не реже раза в 5552 байта)
+    void updateAdler(const unsigned char* data, size_t size) {
+        while (size > 0) {
+            size_t block = std::min<size_t>(size, 5552);
+            for (size_t i = 0; i < block; i++) {
+                adlerA += data[i];
+                adlerB += adlerA;
+            }
+            adlerA %= 65521;
+            adlerB %= 65521;
+            data += block;
+            size -= block;
+        }
+    }
+
+public:
+    explicit PngStream(std::ofstream& f) : file(f), adlerA(1), adlerB(0), headerWritten(false) {}
+
+    // Сигнатура и заголовок IHDR (8 бит на канал, RGB, без чересстрочности)
+    void writeHeader(int width, int height) {
+        static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        file.write(reinterpret_cast<const char*>(signature), 8);
+        std::vector<unsigned char> header;
+        putBigEndian(header, static_cast<uint32_t>(width));
+        putBigEndian(header, static_cast<uint32_t>(height));
+        header.push_back(8);   // Бит на канал
+        header.push_back(2);   // Тип цвета: RGB
+        header.push_back(0);   // Сжатие deflate
+        header.push_back(0);   // Фильтрация: стандартная
+        header.push_back(0);   // Без чересстрочности
+        writeChunk("IHDR", header);
+    }
+
+    // Записать подготовленную полосу (last - последняя полоса картинки)
+    void writeStrip(const PngStrip& strip, bool last) {
+        updateAdler(strip.raw.data(), strip.raw.size());
+
+        chunk.clear();
+        if (!headerWritten) {
+            // Заголовок zlib: deflate, окно 32 КБ, без словаря (0x7801 кратно 31)
+            chunk.push_back(0x78);
+            chunk.push_back(0x01);
+            headerWritten = true;
+        }
+        chunk.insert(chunk.end(), strip.packed.begin(), strip.packed.end());
+        if (last) putBigEndian(chunk, (adlerB << 16) | adlerA);
+        writeChunk("IDAT", chunk);
+    }
+
+    // Завершающий чанк
+    void finish() {
+        writeChunk("IEND", std::vector<unsigned char>());
+    }
+};
+
+// ===== SVG =====
+
+// Цвет в виде #rrggbb
+void colorHex(ExportColor color, char* out) {
+    std::snprintf(out, 8, "#%02x%02x%02x", color.r, color.g, color.b);
+}
+
+} // namespace
+
+// Функция вписывания раскладки в картинку
+ExportView ExportView::fit(const std::vector<float>& x, const std::vector<float>& y,
+                           int width, int height, float margin) {
+    ExportView view;
+    view.width = width;
+    view.height = height;
+    if (x.empty()) return view;
+    float minX = *std::min_element(x.begin(), x.end()), maxX = *std::max_element(x.begin(), x.end());
+    float minY = *std::min_element(y.begin(), y.end()), maxY = *std::max_element(y.begin(), y.end());
+    float spanX = std::max(maxX - minX, 1e-6f), spanY = std::max(maxY - minY, 1e-6f);
+    view.scale = std::min((width - 2 * margin) / spanX, (height - 2 * margin) / spanY);
+    if (view.scale <= 0) view.scale = 1.0f;
+    // Центр раскладки - в центр картинки
+    view.offsetX = width / 2.0f - (minX + maxX) / 2 * view.scale;
+    view.offsetY = height / 2.0f - (minY + maxY) / 2 * view.scale;
+    return view;
+}
+
+// Функция растеризации полосы в память
+void GraphExport::rasterize(const std::vector<float>& x, const std::vector<float>& y, const VisibleSet& visible,
+                            const ExportView& view, const ExportStyle& style, int firstRow, int rows,
+                            std::vector<unsigned char>& rgb) {
+    rgb.clear();
+    if (view.width <= 0 || rows <= 0 || firstRow < 0 || firstRow + rows > view.height) return;
+    Scene scene(x, y, visible, view, style);
+    // Полоса - одна "полоса" сцены нужной высоты
+    buildStrips(scene, firstRow, rows, 1);
+    rasterizeStrip(scene, 0, rgb);
+}
+
+// Функция записи PNG
+bool GraphExport::writePng(const std::string& filename, const std::vector<float>& x, const std::vector<float>& y,
+                           const VisibleSet& visible, const ExportView& view, const ExportStyle& style,
+                           int numThreads) {
+    if (view.width <= 0 || view.height <= 0) {
+        std::cerr << "Ошибка: некорректный размер картинки " << view.width << "x" << view.height << std::endl;
+        return false;
+    }
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось создать файл " << filename << std::endl;
+        return false;
+    }
+
+    Scene scene(x, y, visible, view, style);
+    int strips = (view.height + STRIP_ROWS - 1) / STRIP_ROWS;
+    buildStrips(scene, 0, STRIP_ROWS, strips);
+
+    PngStream png(file);
+    png.writeHeader(view.width, view.height);
+
+    // Пачка полос растеризуется и сжимается параллельно (по полосе на
+    // порцию), затем полосы записываются по порядку; в памяти - только пачка
+    std::unique_ptr<ThreadPool> ownPool;
+    ThreadPool* pool = numThreads == 1 ? nullptr : &ThreadPool::select(numThreads, ownPool);
+    int batch = pool ? 2 * pool->getThreadCount() : 1;
+    std::vector<PngStrip> buffers(batch);
+
+    for (int first = 0; first < strips; first += batch) {
+        int count = std::min(batch, strips - first);
+        if (pool && count > 1) {
+            pool->parallelFor(0, count, 1, [&](int64_t begin, int64_t end, int) {
+                for (int64_t k = begin; k < end; k++) {
+                    int strip = first + static_cast<int>(k);
+                    preparePngStrip(scene, strip, strip == strips - 1, buffers[k]);
+                }
+            });
+        } else {
+            for (int k = 0; k < count; k++) preparePngStrip(scene, first + k, first + k == strips - 1, buffers[k]);
+        }
+        for (int k = 0; k < count; k++) png.writeStrip(buffers[k], first + k == strips - 1);
+    }
+    png.finish();
+
+    if (!file) {
+        std::cerr << "Ошибка записи файла " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция записи SVG
+bool GraphExport::writeSvg(const std::string& filename, const std::vector<float>& x, const std::vector<float>& y,
+                           const VisibleSet& visible, const ExportView& view, const ExportStyle& style) {
+    if (view.width <= 0 || view.height <= 0) {
+        std::cerr << "Ошибка: некорректный размер картинки " << view.width << "x" << view.height << std::endl;
+        return false;
+    }
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось создать файл " << filename << std::endl;
+        return false;
+    }
+
+    Scene scene(x, y, visible, view, style);
+    const float width = static_cast<float>(view.width), height = static_cast<float>(view.height);
+    char line[256];
+    char color[8], outline[8];
+
+    // Заголовок и фон
+    colorHex(style.backgroundColor, color);
+    std::snprintf(line, sizeof(line),
+                  "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n"
+                  "<rect width=\"100%%\" height=\"100%%\" fill=\"%s\"/>\n",
+                  view.width, view.height, view.width, view.height, color);
+    file << line;
+
+    // Плотные области (общий цвет в группе, насыщенность - у каждого квадрата)
+    colorHex(style.vertexColor, color);
+    std::snprintf(line, sizeof(line), "<g fill=\"%s\">\n", color);
+    file << line;
+    for (const DensityTile& tile : visible.tiles) {
+        std::snprintf(line, sizeof(line), "<rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"%.1f\" fill-opacity=\"%.2f\"/>\n",
+                      tile.x * view.scale + view.offsetX, tile.y * view.scale + view.offsetY,
+                      tile.size * view.scale, tile.size * view.scale,
+                      (64 + 191 * visible.tileDensity(tile)) / 255.0f);
+        file << line;
+    }
+    file << "</g>\n";
+
+    // Рёбра за краем картинки пропускаются
+    colorHex(style.edgeColor, color);
+    std::snprintf(line, sizeof(line), "<g stroke=\"%s\" stroke-opacity=\"%.2f\" stroke-width=\"%.2f\">\n",
+                  color, style.edgeColor.a / 255.0f, 2 * scene.halfWidth);
+    file << line;
+    for (const auto& edge : visible.edges) {
+        float ax = scene.screenX(edge.first), ay = scene.screenY(edge.first);
+        float bx = scene.screenX(edge.second), by = scene.screenY(edge.second);
+        if (std::max(ax, bx) < 0 || std::min(ax, bx) > width || std::max(ay, by) < 0 || std::min(ay, by) > height) continue;
+        std::snprintf(line, sizeof(line), "<line x1=\"%.1f\" y1=\"%.1f\" x2=\"%.1f\" y2=\"%.1f\"/>\n", ax, ay, bx, by);
+        file << line;
+    }
+    file << "</g>\n";
+
+    // Вершины
+    colorHex(style.vertexColor, color);
+    colorHex(style.outlineColor, outline);
+    std::snprintf(line, sizeof(line), "<g fill=\"%s\" fill-opacity=\"%.2f\" stroke=\"%s\" stroke-width=\"1\">\n",
+                  color, style.vertexColor.a / 255.0f, outline);
+    file << line;
+    for (int v : visible.vertices) {
+        float cx = scene.screenX(v), cy = scene.screenY(v);
+        if (cx + scene.radius < 0 || cx - scene.radius > width || cy + scene.radius < 0 || cy - scene.radius > height) continue;
+        std::snprintf(line, sizeof(line), "<circle cx=\"%.1f\" cy=\"%.1f\" r=\"%.1f\"/>\n", cx, cy, scene.radius);
+        file << line;
+    }
+    file << "</g>\n";
+
+    // Номера вершин
+    if (scene.labels) {
+        colorHex(style.textColor, color);
+        std::snprintf(line, sizeof(line),
+                      "<g fill=\"%s\" font-family=\"monospace\" font-size=\"%.1f\" text-anchor=\"middle\" "
+                      "dominant-baseline=\"central\">\n",
+                      color, scene.fontPixels);
+        file << line;
+        for (int v : visible.vertices) {
+            float cx = scene.screenX(v), cy = scene.screenY(v);
+            if (cx < 0 || cx > width || cy < 0 || cy > height) continue;
+            std::snprintf(line, sizeof(line), "<text x=\"%.1f\" y=\"%.1f\">%d</text>\n", cx, cy, scene.labelOf(v));
+            file << line;
+        }
+        file << "</g>\n";
+    }
+    file << "</svg>\n";
+
+    if (!file) {
+        std::cerr << "Ошибка записи файла " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
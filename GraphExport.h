@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ViewportIndex.h"
+#include <vector>
+#include <string>
+
+/**
+ * Цвет RGBA (аналог Color из RayLib, чтобы экспорт не зависел от RayLib)
+ */
+struct ExportColor {
+    unsigned char r, g, b, a;
+};
+
+/**
+ * Оформление картинки (размеры - в координатах раскладки, как в draw())
+ */
+struct ExportStyle {
+    float vertexRadius;          // Радиус вершины
+    float edgeWidth;             // Толщина ребра
+    int fontSize;                // Размер шрифта номеров вершин
+    bool drawLabels;             // Рисовать номера вершин
+    const std::vector<int>* labels;  // Номера для подписей (Graph::getOriginalIds; nullptr - номер вершины)
+    ExportColor vertexColor;     // Цвет вершин
+    ExportColor outlineColor;    // Цвет обводки вершин (в пикселях толщиной 1)
+    ExportColor edgeColor;       // Цвет рёбер
+    ExportColor textColor;       // Цвет номеров
+    ExportColor backgroundColor; // Цвет фона (картинка без прозрачности)
+
+    ExportStyle()
+        : vertexRadius(25.0f), edgeWidth(2.0f), fontSize(20), drawLabels(true), labels(nullptr),
+          vertexColor{100, 150, 255, 255}, outlineColor{0, 0, 0, 255}, edgeColor{80, 80, 80, 255},
+          textColor{255, 255, 255, 255}, backgroundColor{245, 245, 245, 255} {}
+};
+
+/**
+ * Размер картинки и перевод координат раскладки в пиксели:
+ * пиксель = координата * scale + offset
+ */
+struct ExportView {
+    int width, height;
+    float scale;
+    float offsetX, offsetY;
+
+    ExportView() : width(0), height(0), scale(1.0f), offsetX(0), offsetY(0) {}
+
+    /**
+     * Вписать раскладку в картинку с отступом
+     * @param x - X-координаты вершин
+     * @param y - Y-координаты вершин
+     * @param width - ширина картинки
+     * @param height - высота картинки
+     * @param margin - отступ от краёв в пикселях
+     * @return вид
+     */
+    static ExportView fit(const std::vector<float>& x, const std::vector<float>& y,
+                          int width, int height, float margin);
+};
+
+/**
+ * Класс GraphExport - картинки графа без окна и видеокарты
+ * Не зависит от RayLib.
+ *
+ * Рисуется видимая часть графа (VisibleSet, как в draw()): квадраты
+ * плотности, рёбра, круги вершин с обводкой и номера вершин (встроенный
+ * растровый шрифт цифр 5x7). Растеризатор на CPU сглаживает края по
+ * покрытию пикселя.
+ *
+ * PNG пишется полосами по STRIP_ROWS строк: для каждой полосы заранее
+ * собраны списки пересекающих её рёбер и вершин, полоса растеризуется
+ * в свой буфер, строки фильтруются (None / Sub / Up) и сжимаются своим
+ * блоком deflate с фиксированными кодами Хаффмана, поэтому картинка
+ * целиком в памяти не хранится. В параллельном режиме пул потоков
+ * готовит пачку полос одновременно, запись идёт по порядку.
+ * SVG пишется потоково, элемент за элементом.
+ */
+class GraphExport {
+public:
+    /**
+     * Высота полосы растеризации в пикселях
+     */
+    static constexpr int STRIP_ROWS = 64;
+
+    /**
+     * Растеризовать полосу картинки в память
+     * @param x - X-координаты вершин
+     * @param y - Y-координаты вершин
+     * @param visible - что рисовать (см. ViewportIndex::query)
+     * @param view - размер картинки и перевод координат
+     * @param style - оформление
+     * @param firstRow - первая строка полосы
+     * @param rows - количество строк (полоса целиком - все строки картинки)
+     * @param rgb - результат: rows * width пикселей по 3 байта (R, G, B)
+     */
+    static void rasterize(const std::vector<float>& x, const std::vector<float>& y, const VisibleSet& visible,
+                          const ExportView& view, const ExportStyle& style, int firstRow, int rows,
+                          std::vector<unsigned char>& rgb);
+
+    /**
+     * Записать картинку в PNG
+     * @param filename - имя файла
+     * @param x, y - координаты вершин
+     * @param visible - что рисовать
+     * @param view - размер картинки и перевод координат
+     * @param style - оформление
+     * @param numThreads - потоков растеризации (1 - последовательно, 0 - все ядра)
+     * @return true если файл записан
+     */
+    static bool writePng(const std::string& filename, const std::vector<float>& x, const std::vector<float>& y,
+                         const VisibleSet& visible, const ExportView& view, const ExportStyle& style,
+                         int numThreads = 0);
+
+    /**
+     * Записать картинку в SVG (векторный формат)
+     * @param filename - имя файла
+     * @param x, y - координаты вершин
+     * @param visible - что рисовать
+     * @param view - размер картинки и перевод координат
+     * @param style - оформление
+     * @return true если файл записан
+     */
+    static bool writeSvg(const std::string& filename, const std::vector<float>& x, const std::vector<float>& y,
+                         const VisibleSet& visible, const ExportView& view, const ExportStyle& style);
+};
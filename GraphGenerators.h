@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Сгенерированный граф: количество вершин и список рёбер
+ * (граф строится через Graph::fromEdgeList или addEdge)
+ */
+struct GeneratedGraph {
+    int numVertices;                          // Количество вершин
+    std::vector<std::pair<int, int>> edges;   // Рёбра (u, v)
+
+    GeneratedGraph() : numVertices(0) {}
+};
+
+/**
+ * Класс GraphGenerators - синтетические графы для бенчмарков и тестов
+ * Случайные генераторы детерминированы: одинаковое зерно даёт одинаковый граф.
+ * Генераторы не строят Graph сами, поэтому одни и те же рёбра можно
+ * подать и в addEdge, и в fromEdgeList, и записать в файл.
+ */
+class GraphGenerators {
+public:
+    /**
+     * Случайный граф Эрдёша-Реньи G(n, m): m рёбер между случайными парами вершин
+     * Петли не создаются; повторные пары возможны (для разреженных графов
+     * их доля мала, дубли удаляет fromEdgeList / addEdge)
+     * @param n - количество вершин
+     * @param m - количество рёбер
+     * @param seed - зерно генератора
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph erdosRenyi(int n, int64_t m, uint64_t seed = 1);
+
+    /**
+     * Граф Барабаши-Альберт (предпочтительное присоединение)
+     * Начинается с полного графа на edgesPerVertex + 1 вершинах, каждая новая
+     * вершина соединяется с edgesPerVertex разными вершинами, выбранными
+     * с вероятностью, пропорциональной степени (степени - степенной закон)
+     * @param n - количество вершин
+     * @param edgesPerVertex - рёбер у каждой новой вершины
+     * @param seed - зерно генератора
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph barabasiAlbert(int n, int edgesPerVertex, uint64_t seed = 1);
+
+    /**
+     * Двумерная решётка rows x cols (вершина r * cols + c соединена
+     * с правым и нижним соседом)
+     * @param rows - количество строк
+     * @param cols - количество столбцов
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph grid2D(int rows, int cols);
+
+    /**
+     * Полный граф K_n (как граф K5 в меню)
+     * @param n - количество вершин
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph complete(int n);
+
+    /**
+     * Граф-цикл на n вершинах
+     * @param n - количество вершин
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph cycle(int n);
+
+    /**
+     * Двудольный граф как в меню: доли [0, left) и [left, left + right),
+     * вершины i и j разных долей соединены, если i + j чётно
+     * @param left - размер первой доли
+     * @param right - размер второй доли
+     * @return сгенерированный граф
+     */
+    static GeneratedGraph bipartite(int left, int right);
+};
@@ -0,0 +1,380 @@
+// Подключаем заголовочный файл пакетной отрисовки
+#include "GraphRenderer.h"
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем низкоуровневый интерфейс RayLib (сброс пакета, отсечение граней)
+#include <rlgl.h>
+// Подключаем матрицы RayLib (единичная матрица для DrawMesh)
+#include <raymath.h>
+// Подключаем библиотеку для алгоритмов (max)
+#include <algorithm>
+// Подключаем математические функции (sqrt, ceil)
+#include <cmath>
+
+// Параметры подписей
+namespace {
+const int LABEL_FONT_SIZE = 20;                     // Размер шрифта номеров вершин
+const int LABEL_SPACING = LABEL_FONT_SIZE / 10;     // Интервал между символами (как в DrawText)
+const float EDGE_HALF_WIDTH = 1.0f;                 // Половина толщины ребра (толщина 2 пикселя)
+
+// Сравнение цветов
+bool sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Записать квадрат из двух треугольников в массив координат (x, y, 0)
+// Углы: (left, top) - (right, bottom)
+inline void writeQuad(float* out, float left, float top, float right, float bottom) {
+    const float corners[6][2] = {
+        {left, top}, {left, bottom}, {right, bottom},
+        {left, top}, {right, bottom}, {right, top}
+    };
+    for (int k = 0; k < 6; k++) {
+        out[3 * k] = corners[k][0];
+        out[3 * k + 1] = corners[k][1];
+        out[3 * k + 2] = 0.0f;
+    }
+}
+
+// Записать текстурные координаты квадрата (порядок углов как в writeQuad)
+inline void writeQuadTexcoords(float* out, float u0, float v0, float u1, float v1) {
+    const float corners[6][2] = {
+        {u0, v0}, {u0, v1}, {u1, v1},
+        {u0, v0}, {u1, v1}, {u1, v0}
+    };
+    for (int k = 0; k < 6; k++) {
+        out[2 * k] = corners[k][0];
+        out[2 * k + 1] = corners[k][1];
+    }
+}
+
+// Заполнить массив цветов одним цветом
+void fillColors(std::vector<unsigned char>& colors, int vertexCount, Color color) {
+    colors.resize(4 * static_cast<size_t>(vertexCount));
+    for (int i = 0; i < vertexCount; i++) {
+        colors[4 * i] = color.r;
+        colors[4 * i + 1] = color.g;
+        colors[4 * i + 2] = color.b;
+        colors[4 * i + 3] = color.a;
+    }
+}
+
+// Загрузить сетку в видеокарту (буфер координат - динамический)
+// Массивы на CPU принадлежат вызывающему, поэтому после загрузки
+// указатели обнуляются (UnloadMesh не должен их освобождать)
+void uploadMesh(Mesh& mesh, std::vector<float>& vertices, std::vector<float>& texcoords,
+                std::vector<unsigned char>& colors) {
+    if (mesh.vertexCount == 0) return;
+    mesh.vertices = vertices.data();
+    mesh.texcoords = texcoords.data();
+    mesh.colors = colors.data();
+    UploadMesh(&mesh, true);
+    mesh.vertices = nullptr;
+    mesh.texcoords = nullptr;
+    mesh.colors = nullptr;
+}
+
+// Нарисовать первые quads квадратов сетки с заданной текстурой
+// (DrawMesh получает копию сетки, поэтому количество вершин можно уменьшить)
+void drawMesh(Mesh mesh, int quads, Material& material, Texture2D texture) {
+    if (quads == 0) return;
+    mesh.vertexCount = 6 * quads;
+    mesh.triangleCount = 2 * quads;
+    material.maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+    DrawMesh(mesh, material, MatrixIdentity());
+}
+}
+
+// Конструктор пакетной отрисовки
+GraphRenderer::GraphRenderer()
+    : edgeMesh(), vertexMesh(), labelMesh(), meshesLoaded(false),
+      material(), defaultTexture(), materialLoaded(false),
+      circleTexture(), digitAtlas(), texturesLoaded(false), digitCellWidth(0),
+      vertexRadius(25.0f), vertexColor{100, 150, 255, 255}, edgeColor{80, 80, 80, 255},
+      textColor{255, 255, 255, 255}, builtVertices(0), builtEdges(0), builtVersion(0),
+      geometryValid(false), drawnEdges(0), drawnVertices(0), drawnGlyphs(0) {
+    std::fill(digitWidth, digitWidth + 10, 0);
+}
+
+// Функция проверки поддержки буферов вершин
+bool GraphRenderer::isAvailable() {
+    return rlGetVersion() != RL_OPENGL_11;
+}
+
+// Установить оформление графа
+void GraphRenderer::setStyle(float radius, Color vertex, Color edge, Color text) {
+    if (radius == vertexRadius && sameColor(vertex, vertexColor) &&
+        sameColor(edge, edgeColor) && sameColor(text, textColor)) {
+        return;
+    }
+    vertexRadius = radius;
+    vertexColor = vertex;
+    edgeColor = edge;
+    textColor = text;
+    // Текстуры и цвета сеток строятся заново при следующей отрисовке
+    // (освобождать ресурсы можно только при живом окне)
+    geometryValid = false;
+    builtVertices = -1;
+}
+
+// Отметить координаты как устаревшие
+void GraphRenderer::invalidate() {
+    geometryValid = false;
+}
+
+// Функция рисования текстуры круга и атласа цифр
+// Текстуры рисуются один раз средствами RayLib (тот же вид, что у DrawCircleV /
+// DrawCircleLines / DrawText), дальше используются как готовые картинки
+void GraphRenderer::loadTextures() {
+    // Круг вершины с чёрной обводкой (по 2 пикселя запаса с каждой стороны)
+    int size = static_cast<int>(std::ceil(2 * vertexRadius)) + 4;
+    circleTexture = LoadRenderTexture(size, size);
+    BeginTextureMode(circleTexture);
+    ClearBackground(BLANK);
+    DrawCircleV({size / 2.0f, size / 2.0f}, vertexRadius, vertexColor);
+    DrawCircleLines(size / 2, size / 2, vertexRadius, BLACK);
+    EndTextureMode();
+    SetTextureFilter(circleTexture.texture, TEXTURE_FILTER_BILINEAR);
+
+    // Атлас цифр 0-9 белым цветом (цвет подписей задаётся цветами вершин сетки)
+    digitCellWidth = 0;
+    for (int d = 0; d < 10; d++) {
+        const char text[2] = {static_cast<char>('0' + d), '\0'};
+        digitWidth[d] = MeasureText(text, LABEL_FONT_SIZE);
+        digitCellWidth = std::max(digitCellWidth, digitWidth[d] + 2);
+    }
+    digitAtlas = LoadRenderTexture(digitCellWidth * 10, LABEL_FONT_SIZE);
+    BeginTextureMode(digitAtlas);
+    ClearBackground(BLANK);
+    for (int d = 0; d < 10; d++) {
+        const char text[2] = {static_cast<char>('0' + d), '\0'};
+        DrawText(text, d * digitCellWidth, 0, LABEL_FONT_SIZE, WHITE);
+    }
+    EndTextureMode();
+
+    texturesLoaded = true;
+}
+
+// Функция освобождения текстур
+void GraphRenderer::unloadTextures() {
+    if (!texturesLoaded) return;
+    UnloadRenderTexture(circleTexture);
+    UnloadRenderTexture(digitAtlas);
+    texturesLoaded = false;
+}
+
+// Функция создания сеток
+// Цвета (и текстурные координаты рёбер и вершин) не зависят от положения,
+// поэтому загружаются один раз; координаты заполняет updateGeometry
+void GraphRenderer::loadMeshes(const Graph& graph) {
+    int n = graph.getNumVertices();
+    EdgeView edges = graph.getEdges();
+    std::vector<float> texcoords;
+    std::vector<unsigned char> colors;
+
+    // Рёбра: 6 вершин на ребро, текстура не используется (белая по умолчанию)
+    edgeMesh = Mesh();
+    edgeMesh.vertexCount = static_cast<int>(6 * edges.size());
+    edgeMesh.triangleCount = static_cast<int>(2 * edges.size());
+    edgeVertices.assign(3 * static_cast<size_t>(edgeMesh.vertexCount), 0.0f);
+    texcoords.assign(2 * static_cast<size_t>(edgeMesh.vertexCount), 0.0f);
+    fillColors(colors, edgeMesh.vertexCount, edgeColor);
+    uploadMesh(edgeMesh, edgeVertices, texcoords, colors);
+
+    // Вершины: квадрат с текстурой круга (картинка уже цветная - цвет вершин белый)
+    // Текстура, нарисованная в RenderTexture, перевёрнута по вертикали
+    vertexMesh = Mesh();
+    vertexMesh.vertexCount = 6 * n;
+    vertexMesh.triangleCount = 2 * n;
+    vertexVertices.assign(3 * static_cast<size_t>(vertexMesh.vertexCount), 0.0f);
+    texcoords.resize(2 * static_cast<size_t>(vertexMesh.vertexCount));
+    for (int i = 0; i < n; i++) {
+        writeQuadTexcoords(&texcoords[12 * static_cast<size_t>(i)], 0.0f, 1.0f, 1.0f, 0.0f);
+    }
+    fillColors(colors, vertexMesh.vertexCount, WHITE);
+    uploadMesh(vertexMesh, vertexVertices, texcoords, colors);
+
+    // Подписи: по квадрату на каждую цифру номера вершины
+    labelStart.assign(1, 0);
+    labelOffsetX.clear();
+    labelWidth.clear();
+    labelDigit.clear();
+    for (int i = 0; i < n; i++) {
+        // Цифры исходного номера (с младшей): у перенумерованного графа
+        // подписи совпадают с номерами во входном файле
+        char digits[12];
+        int count = 0;
+        int value = graph.getOriginalId(i);
+        do {
+            digits[count++] = static_cast<char>(value % 10);
+            value /= 10;
+        } while (value > 0);
+        // Ширина подписи как у MeasureText: сумма ширин цифр и интервалов
+        int total = -LABEL_SPACING;
+        for (int k = 0; k < count; k++) total += digitWidth[static_cast<int>(digits[k])] + LABEL_SPACING;
+        float left = -total / 2.0f;
+        for (int k = count - 1; k >= 0; k--) {
+            int d = digits[k];
+            labelOffsetX.push_back(left);
+            labelWidth.push_back(static_cast<float>(digitWidth[d]));
+            labelDigit.push_back(d);
+            left += digitWidth[d] + LABEL_SPACING;
+        }
+        labelStart.push_back(static_cast<int>(labelDigit.size()));
+    }
+    // Текстурные координаты подписей зависят от того, какие цифры видны,
+    // поэтому пишутся в updateGeometry
+    size_t glyphs = labelDigit.size();
+    labelMesh = Mesh();
+    labelMesh.vertexCount = static_cast<int>(6 * glyphs);
+    labelMesh.triangleCount = static_cast<int>(2 * glyphs);
+    labelVertices.assign(3 * static_cast<size_t>(labelMesh.vertexCount), 0.0f);
+    labelTexcoords.assign(2 * static_cast<size_t>(labelMesh.vertexCount), 0.0f);
+    fillColors(colors, labelMesh.vertexCount, textColor);
+    uploadMesh(labelMesh, labelVertices, labelTexcoords, colors);
+
+    meshesLoaded = true;
+    builtVertices = n;
+    builtEdges = edges.size();
+    geometryValid = false;
+}
+
+// Функция освобождения сеток
+void GraphRenderer::unloadMeshes() {
+    if (!meshesLoaded) return;
+    if (edgeMesh.vertexCount > 0) UnloadMesh(edgeMesh);
+    if (vertexMesh.vertexCount > 0) UnloadMesh(vertexMesh);
+    if (labelMesh.vertexCount > 0) UnloadMesh(labelMesh);
+    edgeMesh = vertexMesh = labelMesh = Mesh();
+    meshesLoaded = false;
+}
+
+// Функция пересчёта координат сеток
+void GraphRenderer::updateGeometry(const std::vector<float>& x, const std::vector<float>& y,
+                                   const VisibleSet& visible, bool drawLabels) {
+    // Рёбра: прямоугольник толщиной 2 пикселя вдоль отрезка
+    drawnEdges = static_cast<int>(std::min(visible.edges.size(), builtEdges));
+    for (int e = 0; e < drawnEdges; e++) {
+        int u = visible.edges[e].first;
+        int v = visible.edges[e].second;
+        float dx = x[v] - x[u];
+        float dy = y[v] - y[u];
+        float length = std::sqrt(dx * dx + dy * dy);
+        // Нормаль к отрезку длиной в половину толщины
+        float scale = length > 0 ? EDGE_HALF_WIDTH / length : 0.0f;
+        float nx = -dy * scale;
+        float ny = dx * scale;
+        float* out = &edgeVertices[18 * static_cast<size_t>(e)];
+        const float corners[6][2] = {
+            {x[u] + nx, y[u] + ny}, {x[u] - nx, y[u] - ny}, {x[v] - nx, y[v] - ny},
+            {x[u] + nx, y[u] + ny}, {x[v] - nx, y[v] - ny}, {x[v] + nx, y[v] + ny}
+        };
+        for (int k = 0; k < 6; k++) {
+            out[3 * k] = corners[k][0];
+            out[3 * k + 1] = corners[k][1];
+            out[3 * k + 2] = 0.0f;
+        }
+    }
+
+    // Вершины: квадрат размером с текстуру круга
+    drawnVertices = static_cast<int>(std::min(visible.vertices.size(), static_cast<size_t>(builtVertices)));
+    float half = circleTexture.texture.width / 2.0f;
+    for (int k = 0; k < drawnVertices; k++) {
+        int i = visible.vertices[k];
+        writeQuad(&vertexVertices[18 * static_cast<size_t>(k)], x[i] - half, y[i] - half, x[i] + half, y[i] + half);
+    }
+
+    // Подписи: цифры по центру вершины (как DrawText в прежней отрисовке)
+    drawnGlyphs = 0;
+    if (drawLabels) {
+        float atlasWidth = static_cast<float>(digitCellWidth * 10);
+        for (int k = 0; k < drawnVertices; k++) {
+            int i = visible.vertices[k];
+            for (int g = labelStart[i]; g < labelStart[i + 1]; g++) {
+                float left = x[i] + labelOffsetX[g];
+                float top = y[i] - LABEL_FONT_SIZE / 2.0f;
+                writeQuad(&labelVertices[18 * static_cast<size_t>(drawnGlyphs)], left, top,
+                          left + labelWidth[g], top + LABEL_FONT_SIZE);
+                float u0 = labelDigit[g] * digitCellWidth / atlasWidth;
+                float u1 = (labelDigit[g] * digitCellWidth + labelWidth[g]) / atlasWidth;
+                writeQuadTexcoords(&labelTexcoords[12 * static_cast<size_t>(drawnGlyphs)], u0, 1.0f, u1, 0.0f);
+                drawnGlyphs++;
+            }
+        }
+    }
+
+    // Отправляем в видеокарту только заполненное начало буферов
+    // (буфер 0 - координаты вершин, буфер 1 - текстурные координаты)
+    if (drawnEdges > 0) {
+        UpdateMeshBuffer(edgeMesh, 0, edgeVertices.data(), drawnEdges * 18 * static_cast<int>(sizeof(float)), 0);
+    }
+    if (drawnVertices > 0) {
+        UpdateMeshBuffer(vertexMesh, 0, vertexVertices.data(), drawnVertices * 18 * static_cast<int>(sizeof(float)), 0);
+    }
+    if (drawnGlyphs > 0) {
+        UpdateMeshBuffer(labelMesh, 0, labelVertices.data(), drawnGlyphs * 18 * static_cast<int>(sizeof(float)), 0);
+        UpdateMeshBuffer(labelMesh, 1, labelTexcoords.data(), drawnGlyphs * 12 * static_cast<int>(sizeof(float)), 0);
+    }
+    geometryValid = true;
+}
+
+// Функция отрисовки графа
+void GraphRenderer::draw(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y,
+                         const VisibleSet& visible, uint64_t version, bool drawLabels) {
+    int n = graph.getNumVertices();
+    size_t m = graph.getEdges().size();
+
+    // Оформление или граф изменились - строим текстуры и сетки заново
+    if (meshesLoaded && (builtVertices != n || builtEdges != m)) {
+        unloadMeshes();
+        unloadTextures();
+    }
+    if (!texturesLoaded) loadTextures();
+    if (!materialLoaded) {
+        material = LoadMaterialDefault();
+        defaultTexture = material.maps[MATERIAL_MAP_DIFFUSE].texture;
+        materialLoaded = true;
+    }
+    if (!meshesLoaded) loadMeshes(graph);
+
+    // Буферы пересчитываются, только если сдвинулись вершины или камера
+    if (!geometryValid || version != builtVersion) {
+        updateGeometry(x, y, visible, drawLabels);
+        builtVersion = version;
+    }
+
+    // Рисуем накопленные RayLib фигуры, чтобы сохранить порядок слоёв,
+    // и отключаем отсечение граней (порядок обхода углов в 2D не важен)
+    rlDrawRenderBatchActive();
+    rlDisableBackfaceCulling();
+    {
+        GRAPH_PROFILE_SCOPE(DrawEdges);
+        drawMesh(edgeMesh, drawnEdges, material, defaultTexture);
+        GRAPH_PROFILE_COUNT(EdgesDrawn, drawnEdges);
+    }
+    {
+        GRAPH_PROFILE_SCOPE(DrawVertices);
+        drawMesh(vertexMesh, drawnVertices, material, circleTexture.texture);
+        GRAPH_PROFILE_COUNT(VerticesDrawn, drawnVertices);
+    }
+    if (drawnGlyphs > 0) {
+        GRAPH_PROFILE_SCOPE(DrawLabels);
+        drawMesh(labelMesh, drawnGlyphs, material, digitAtlas.texture);
+        GRAPH_PROFILE_COUNT(LabelGlyphsDrawn, drawnGlyphs);
+    }
+    material.maps[MATERIAL_MAP_DIFFUSE].texture = defaultTexture;
+    rlEnableBackfaceCulling();
+}
+
+// Функция освобождения ресурсов видеокарты
+void GraphRenderer::unload() {
+    unloadMeshes();
+    unloadTextures();
+    if (materialLoaded) {
+        // Текстура по умолчанию общая для RayLib - UnloadMaterial её не трогает
+        material.maps[MATERIAL_MAP_DIFFUSE].texture = defaultTexture;
+        UnloadMaterial(material);
+        materialLoaded = false;
+    }
+    geometryValid = false;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Graph.h"
+#include "ViewportIndex.h"
+#include <raylib.h>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Класс GraphRenderer - пакетная отрисовка графа через RayLib
+ *
+ * Вместо вызова DrawLineEx / DrawCircleV / DrawText для каждого ребра
+ * и вершины вся геометрия собирается в три сетки (Mesh) и рисуется
+ * тремя вызовами DrawMesh за кадр:
+ *   - рёбра: по два треугольника на ребро (линия толщиной 2 пикселя);
+ *   - вершины: квадраты с заранее нарисованной текстурой круга с обводкой;
+ *   - подписи: квадраты цифр из заранее нарисованного атласа цифр 0-9.
+ * Сетки рассчитаны на весь граф, но рисуется только видимая часть
+ * (VisibleSet): её квадраты пишутся в начало буферов, и DrawMesh получает
+ * уменьшенное количество вершин. Буферы пересчитываются только при смене
+ * номера версии (координаты или видимая часть изменились), цвета
+ * загружаются один раз. Нужен OpenGL 2.1+ / ES 2.0 (работает и на программном
+ * Mesa llvmpipe); на OpenGL 1.1 isAvailable() возвращает false,
+ * и визуализатор рисует граф по-старому.
+ *
+ * Все ресурсы видеокарты создаются при первом draw() и должны быть
+ * освобождены unload() до закрытия окна.
+ */
+class GraphRenderer {
+private:
+    // Сетки рёбер, вершин и подписей
+    Mesh edgeMesh;
+    Mesh vertexMesh;
+    Mesh labelMesh;
+    bool meshesLoaded;
+
+    // Материал по умолчанию (текстура подставляется перед каждым DrawMesh)
+    Material material;
+    Texture2D defaultTexture;
+    bool materialLoaded;
+
+    // Текстура круга вершины и атлас цифр подписей
+    RenderTexture2D circleTexture;
+    RenderTexture2D digitAtlas;
+    bool texturesLoaded;
+    int digitWidth[10];        // Ширина каждой цифры в пикселях
+    int digitCellWidth;        // Ширина ячейки цифры в атласе
+
+    // Параметры, с которыми построены текстуры и сетки
+    float vertexRadius;
+    Color vertexColor;
+    Color edgeColor;
+    Color textColor;
+    int builtVertices;         // Количество вершин в сетках
+    size_t builtEdges;         // Количество рёбер в сетках
+    uint64_t builtVersion;     // Версия координат и видимой части в буферах
+    bool geometryValid;        // Буферы соответствуют текущим координатам
+    int drawnEdges;            // Рёбер в буферах
+    int drawnVertices;         // Вершин в буферах
+    int drawnGlyphs;           // Цифр подписей в буферах
+
+    // Координаты вершин сеток на CPU (переиспользуются между обновлениями)
+    std::vector<float> edgeVertices;
+    std::vector<float> vertexVertices;
+    std::vector<float> labelVertices;
+
+    std::vector<float> labelTexcoords;
+
+    // Цифры подписей: цифры вершины v - с labelStart[v] до labelStart[v + 1]
+    std::vector<int> labelStart;       // Начало цифр вершины
+    std::vector<float> labelOffsetX;   // Левый край цифры относительно центра вершины
+    std::vector<float> labelWidth;     // Ширина квадрата цифры
+    std::vector<int> labelDigit;       // Цифра (ячейка атласа)
+
+    /**
+     * Нарисовать текстуру круга и атлас цифр
+     */
+    void loadTextures();
+
+    /**
+     * Освободить текстуры
+     */
+    void unloadTextures();
+
+    /**
+     * Создать сетки с постоянными цветами и текстурными координатами
+     * @param graph - граф
+     */
+    void loadMeshes(const Graph& graph);
+
+    /**
+     * Освободить сетки
+     */
+    void unloadMeshes();
+
+    /**
+     * Записать квадраты видимой части в начало буферов и отправить их в видеокарту
+     * @param x - X-координаты вершин графа
+     * @param y - Y-координаты вершин графа
+     * @param visible - видимые вершины и рёбра
+     * @param drawLabels - нужны ли подписи
+     */
+    void updateGeometry(const std::vector<float>& x, const std::vector<float>& y,
+                        const VisibleSet& visible, bool drawLabels);
+
+public:
+    /**
+     * Конструктор (ресурсы видеокарты создаются при первой отрисовке)
+     */
+    GraphRenderer();
+
+    GraphRenderer(const GraphRenderer&) = delete;
+    GraphRenderer& operator=(const GraphRenderer&) = delete;
+
+    /**
+     * Проверить, поддерживает ли текущий контекст OpenGL пакетную отрисовку
+     * (вызывать после InitWindow)
+     * @return true если доступны буферы вершин (OpenGL 2.1+ / ES 2.0)
+     */
+    static bool isAvailable();
+
+    /**
+     * Установить оформление (при изменении текстуры перерисовываются)
+     * @param radius - радиус вершины
+     * @param vertex - цвет вершин
+     * @param edge - цвет рёбер
+     * @param text - цвет подписей
+     */
+    void setStyle(float radius, Color vertex, Color edge, Color text);
+
+    /**
+     * Отметить, что координаты нужно загрузить заново при следующей отрисовке
+     */
+    void invalidate();
+
+    /**
+     * Нарисовать видимую часть графа (между BeginDrawing и EndDrawing,
+     * внутри BeginMode2D, если используется камера)
+     * @param graph - граф
+     * @param x - X-координаты вершин
+     * @param y - Y-координаты вершин
+     * @param visible - видимые вершины и рёбра (см. ViewportIndex)
+     * @param version - номер версии: меняется, когда меняются координаты,
+     *                  видимая часть или drawLabels
+     * @param drawLabels - рисовать номера вершин
+     */
+    void draw(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y,
+              const VisibleSet& visible, uint64_t version, bool drawLabels = true);
+
+    /**
+     * Освободить ресурсы видеокарты (до CloseWindow)
+     */
+    void unload();
+};
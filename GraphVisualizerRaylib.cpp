@@ -1,22 +1,24 @@
 // Подключаем заголовочный файл класса визуализатора
 #include "GraphVisualizerRaylib.h"
+// Подключаем фоновый поток раскладки
+#include "LayoutWorker.h"
+// Подключаем таймеры участков (исчезают без GRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
 // Подключаем библиотеку для ввода-вывода
 #include <iostream>
 // Подключаем библиотеку для алгоритмов (min, max)
 #include <algorithm>
+// Подключаем функции для C-строк (strlen)
+#include <cstring>
 
-// Определение математической константы Pi (если не определена)
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+// Размер шрифта номеров вершин
+static const int LABEL_FONT_SIZE = 20;
 
 // Конструктор визуализатора графа
 // Параметры: g - ссылка на граф, width - ширина окна, height - высота окна
 GraphVisualizerRaylib::GraphVisualizerRaylib(const Graph& g, int width, int height)
-    : graph(g), windowWidth(width), windowHeight(height) {
-    
-    // Изменяем размер вектора вершин под количество вершин в графе
-    vertices.resize(graph.getNumVertices());
+    : graph(g), layout(g), windowWidth(width), windowHeight(height), batchedRendering(true),
+      indexVersion(0), visibleValid(false), visibleVersion(0) {
     
     // Устанавливаем параметры визуализации по умолчанию
     vertexRadius = 25.0f;                    // Радиус вершины в пикселях
@@ -25,246 +27,251 @@ GraphVisualizerRaylib::GraphVisualizerRaylib(const Graph& g, int width, int heig
     textColor = {255, 255, 255, 255};        // Цвет текста (белый) RGBA
     backgroundColor = {245, 245, 245, 255};  // Цвет фона (светло-серый) RGBA
     
-    // Устанавливаем параметры force-directed алгоритма
-    // Force-directed - физическая модель для красивого расположения графа
-    repulsionForce = 50000.0f;    // Сила отталкивания между вершинами (как заряженные частицы)
-    attractionForce = 0.01f;      // Сила притяжения вдоль рёбер (как пружины)
-    damping = 0.85f;              // Коэффициент затухания (для стабилизации)
-    optimalDistance = 150.0f;     // Оптимальная длина ребра в пикселях
+    // Камера без сдвига и масштаба: координаты раскладки совпадают с пикселями окна
+    resetCamera();
+    
+    // Вершины не выходят за границы окна
+    updateLayoutBounds();
     
     // Инициализируем начальные позиции вершин
     initializePositions();
 }
 
 // Функция инициализации начальных позиций вершин
-// Размещаем вершины по кругу для красивого начального вида
+// Размещаем вершины по кругу в центре окна для красивого начального вида
 void GraphVisualizerRaylib::initializePositions() {
-    // Получаем количество вершин в графе
-    int n = graph.getNumVertices();
-    
-    // Если вершин нет, ничего не делаем
-    if (n == 0) return;
-    
-    // Размещаем вершины по кругу в центре окна
-    float centerX = windowWidth / 2.0f;   // X-координата центра окна
-    float centerY = windowHeight / 2.0f;  // Y-координата центра окна
-    // Радиус круга - 35% от минимального размера окна
-    float radius = std::min(windowWidth, windowHeight) * 0.35f;
-    
-    // Проходим по каждой вершине
-    for (int i = 0; i < n; i++) {
-        // Вычисляем угол для i-той вершины (равномерно распределяем по кругу)
-        float angle = 2.0f * M_PI * i / n;
-        // Вычисляем X-координату вершины по формуле окружности
-        vertices[i].x = centerX + radius * std::cos(angle);
-        // Вычисляем Y-координату вершины по формуле окружности
-        vertices[i].y = centerY + radius * std::sin(angle);
-        // Обнуляем начальную скорость по X
-        vertices[i].vx = 0;
-        // Обнуляем начальную скорость по Y
-        vertices[i].vy = 0;
-    }
+    layout.initializeCircle(windowWidth / 2.0f, windowHeight / 2.0f, initialRadius());
 }
 
-// Функция расчёта силы отталкивания между двумя вершинами
-// Работает по закону Кулона: F = k / r^2 (сила обратно пропорциональна квадрату расстояния)
-void GraphVisualizerRaylib::calculateRepulsion(int i, int j) {
-    // Вычисляем разницу координат (вектор от i к j)
-    float dx = vertices[j].x - vertices[i].x;
-    float dy = vertices[j].y - vertices[i].y;
-    // Вычисляем квадрат расстояния между вершинами
-    float distSq = dx * dx + dy * dy;
-    
-    // Защита от деления на ноль (если вершины совпадают)
-    if (distSq < 1.0f) distSq = 1.0f;
-    
-    // Вычисляем расстояние (корень из квадрата расстояния)
-    float dist = std::sqrt(distSq);
-    // Вычисляем силу отталкивания (обратно пропорциональна квадрату расстояния)
-    float force = repulsionForce / distSq;
-    
-    // Применяем силу к скорости вершины i (отталкиваем от j)
-    // Направление силы: противоположно вектору dx, dy (от j к i)
-    vertices[i].vx -= (dx / dist) * force;  // Компонента скорости по X
-    vertices[i].vy -= (dy / dist) * force;  // Компонента скорости по Y
-}
-
-// Функция расчёта силы притяжения вдоль ребра между вершинами
-// Работает как пружина: F = k * (текущая_длина - оптимальная_длина)
-void GraphVisualizerRaylib::calculateAttraction(int i, int j) {
-    // Вычисляем разницу координат (вектор от i к j)
-    float dx = vertices[j].x - vertices[i].x;
-    float dy = vertices[j].y - vertices[i].y;
-    // Вычисляем расстояние между вершинами
-    float dist = std::sqrt(dx * dx + dy * dy);
-    
-    // Защита от деления на ноль
-    if (dist < 1.0f) dist = 1.0f;
-    
-    // Вычисляем силу притяжения (пропорциональна отклонению от оптимального расстояния)
-    // Если вершины дальше оптимального расстояния - притягиваются
-    // Если ближе - отталкиваются
-    float force = attractionForce * (dist - optimalDistance);
-    
-    // Применяем силу к скорости вершины i (притягиваем к j)
-    vertices[i].vx += (dx / dist) * force;  // Компонента скорости по X
-    vertices[i].vy += (dy / dist) * force;  // Компонента скорости по Y
+// Функция возвращает радиус начального круга
+// Радиус круга - 35% от минимального размера окна
+float GraphVisualizerRaylib::initialRadius() const {
+    return std::min(windowWidth, windowHeight) * 0.35f;
 }
 
-// Функция выполнения одной итерации force-directed алгоритма
-// На каждой итерации пересчитываем силы и обновляем позиции вершин
-void GraphVisualizerRaylib::applyForceDirectedStep() {
-    // Получаем количество вершин
-    int n = graph.getNumVertices();
-    
-    // Обнуляем скорости всех вершин перед новым расчётом
-    for (int i = 0; i < n; i++) {
-        vertices[i].vx = 0;  // Скорость по X
-        vertices[i].vy = 0;  // Скорость по Y
-    }
-    
-    // Рассчитываем силы отталкивания между всеми парами вершин
-    // Каждая вершина отталкивает все остальные (как заряженные частицы)
-    for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-            // Вершина i отталкивается от j
-            calculateRepulsion(i, j);
-            // Вершина j отталкивается от i (симметрично)
-            calculateRepulsion(j, i);
-        }
-    }
-    
-    // Рассчитываем силы притяжения вдоль рёбер
-    // Рёбра работают как пружины, притягивая соединённые вершины
-    const auto& edges = graph.getEdges();  // Получаем список всех рёбер
-    for (const auto& edge : edges) {
-        int u = edge.first;   // Первая вершина ребра
-        int v = edge.second;  // Вторая вершина ребра
-        // Вершина u притягивается к v
-        calculateAttraction(u, v);
-        // Вершина v притягивается к u (симметрично)
-        calculateAttraction(v, u);
-    }
-    
-    // Обновляем позиции вершин на основе накопленных скоростей
-    updatePositions();
-}
-
-// Функция обновления позиций вершин на основе их скоростей
-void GraphVisualizerRaylib::updatePositions() {
-    // Получаем количество вершин
-    int n = graph.getNumVertices();
+// Функция ограничения раскладки окном
+void GraphVisualizerRaylib::updateLayoutBounds() {
     // Вычисляем отступ от границ окна (2 радиуса вершины)
     float margin = vertexRadius * 2;
-    
-    // Проходим по каждой вершине
-    for (int i = 0; i < n; i++) {
-        // Применяем демпфирование к скорости (затухание для стабилизации)
-        // Без демпфирования вершины будут бесконечно колебаться
-        vertices[i].vx *= damping;  // Уменьшаем скорость по X
-        vertices[i].vy *= damping;  // Уменьшаем скорость по Y
-        
-        // Обновляем позиции вершины на основе скорости
-        vertices[i].x += vertices[i].vx;  // Новая позиция X = старая + скорость
-        vertices[i].y += vertices[i].vy;  // Новая позиция Y = старая + скорость
-        
-        // Ограничиваем позиции границами окна (чтобы вершины не убегали за экран)
-        // std::max выбирает максимум (не даёт уйти влево/вверх)
-        // std::min выбирает минимум (не даёт уйти вправо/вниз)
-        vertices[i].x = std::max(margin, std::min((float)windowWidth - margin, vertices[i].x));
-        vertices[i].y = std::max(margin, std::min((float)windowHeight - margin, vertices[i].y));
-    }
+    layout.setBounds(margin, margin, windowWidth - margin, windowHeight - margin);
 }
 
 // Функция центрирования графа в окне
-// Находит центр масс всех вершин и перемещает его в центр окна
+// Перемещает центр масс всех вершин в центр окна
 void GraphVisualizerRaylib::centerGraph() {
-    // Получаем количество вершин
-    int n = graph.getNumVertices();
-    // Если вершин нет, ничего не делаем
-    if (n == 0) return;
-    
-    // Находим центр масс графа (среднее всех координат)
-    float centerX = 0, centerY = 0;  // Инициализируем центр
-    for (int i = 0; i < n; i++) {
-        centerX += vertices[i].x;  // Суммируем X-координаты
-        centerY += vertices[i].y;  // Суммируем Y-координаты
-    }
-    centerX /= n;  // Делим на количество вершин для получения среднего
-    centerY /= n;  // Делим на количество вершин для получения среднего
-    
-    // Вычисляем смещение для перемещения центра масс в центр окна
-    float offsetX = windowWidth / 2.0f - centerX;   // Смещение по X
-    float offsetY = windowHeight / 2.0f - centerY;  // Смещение по Y
-    
-    // Применяем смещение ко всем вершинам
-    for (int i = 0; i < n; i++) {
-        vertices[i].x += offsetX;  // Сдвигаем вершину по X
-        vertices[i].y += offsetY;  // Сдвигаем вершину по Y
-    }
+    layout.center(windowWidth / 2.0f, windowHeight / 2.0f);
+}
+
+// Функция вписывания раскладки в окно (с отступом в два радиуса вершины)
+void GraphVisualizerRaylib::fitToWindow() {
+    float margin = vertexRadius * 2;
+    layout.fitToRect(margin, margin, windowWidth - margin, windowHeight - margin);
 }
 
 // Функция оптимизации расположения вершин
-// Выполняет заданное количество итераций алгоритма для улучшения вида графа
-void GraphVisualizerRaylib::optimize(int iterations) {
+// Выполняет итерации алгоритма, пока раскладка не стабилизируется
+// (или до лимита итераций)
+LayoutResult GraphVisualizerRaylib::optimize(int maxIterations) {
     // Выводим сообщение о начале оптимизации
     std::cout << "Оптимизация расположения вершин..." << std::endl;
     
-    // Выполняем заданное количество итераций
-    for (int i = 0; i < iterations; i++) {
-        // Применяем один шаг force-directed алгоритма
-        applyForceDirectedStep();
-        
-        // Выводим прогресс каждые 100 итераций
-        if ((i + 1) % 100 == 0) {
-            std::cout << "Итерация " << (i + 1) << "/" << iterations << std::endl;
-        }
-    }
+    LayoutResult result = layout.optimize(maxIterations);
     
     // После оптимизации центрируем граф в окне
     centerGraph();
     // Выводим сообщение о завершении
-    std::cout << "Оптимизация завершена!" << std::endl;
+    std::cout << "Оптимизация завершена за " << result.iterations << " итераций"
+              << (result.converged ? " (раскладка стабилизировалась)" : " (достигнут лимит)")
+              << ", энергия " << result.energy << std::endl;
+    return result;
+}
+
+// Функция многоуровневой оптимизации расположения
+// Раскладка считается на неограниченной плоскости и в конце вписывается в окно
+LayoutResult GraphVisualizerRaylib::optimizeMultilevel(int refineIterations) {
+    std::cout << "Многоуровневая оптимизация расположения вершин..." << std::endl;
+    LayoutResult result = layout.optimizeMultilevel(refineIterations);
+    fitToWindow();
+    std::cout << "Оптимизация завершена за " << result.iterations << " итераций (все уровни)"
+              << ", энергия " << result.energy << std::endl;
+    return result;
 }
 
 // Функция отрисовки графа на экране
-// Сначала рисуем рёбра, потом вершины (чтобы вершины были поверх рёбер)
+// Рисуется только видимая часть; пакетная отрисовка пересобирает буферы
+// только при сдвиге вершин или камеры, поэтому кадр неподвижного графа
+// почти ничего не стоит на CPU
 void GraphVisualizerRaylib::draw() {
-    // Отрисовка рёбер графа
-    const auto& edges = graph.getEdges();  // Получаем список всех рёбер
-    for (const auto& edge : edges) {
-        int u = edge.first;   // Первая вершина ребра
-        int v = edge.second;  // Вторая вершина ребра
-        
-        // Рисуем линию между вершинами u и v
-        DrawLineEx(
-            {vertices[u].x, vertices[u].y},  // Начальная точка (вершина u)
-            {vertices[v].x, vertices[v].y},  // Конечная точка (вершина v)
-            2.0f,                            // Толщина линии в пикселях
-            edgeColor                        // Цвет линии
-        );
+    drawPositions(layout.getX(), layout.getY(), layout.getPositionsVersion());
+}
+
+// Функция отрисовки графа с заданными координатами
+void GraphVisualizerRaylib::drawPositions(const std::vector<float>& x, const std::vector<float>& y, uint64_t version) {
+    updateVisibleSet(x, y, version);
+    
+    // Номера вершин мельче LABEL_MIN_PIXELS на экране не читаются
+    bool drawLabels = LABEL_FONT_SIZE * camera.zoom >= LABEL_MIN_PIXELS;
+    
+    // Плотные области - под рёбрами и вершинами
+    drawDensityTiles();
+    
+    if (batchedRendering && GraphRenderer::isAvailable()) {
+        renderer.setStyle(vertexRadius, vertexColor, edgeColor, textColor);
+        renderer.draw(graph, x, y, visible, visibleVersion, drawLabels);
+        return;
+    }
+    drawImmediate(x, y, drawLabels);
+}
+
+// Функция обновления видимой части графа
+void GraphVisualizerRaylib::updateVisibleSet(const std::vector<float>& x, const std::vector<float>& y,
+                                             uint64_t version) {
+    // Вершины сдвинулись - индекс строится заново
+    if (!viewIndex.isBuilt() || indexVersion != version) {
+        viewIndex.build(graph, x, y);
+        indexVersion = version;
+        visibleValid = false;
     }
     
-    // Отрисовка вершин графа
-    int n = graph.getNumVertices();  // Получаем количество вершин
-    for (int i = 0; i < n; i++) {
-        // Рисуем заполненный круг для вершины
-        DrawCircleV({vertices[i].x, vertices[i].y}, vertexRadius, vertexColor);
-        
-        // Рисуем обводку вокруг вершины (чёрный контур)
-        DrawCircleLines(vertices[i].x, vertices[i].y, vertexRadius, BLACK);
-        
+    // Камера не двигалась - видимая часть прежняя
+    if (visibleValid && camera.target.x == visibleCamera.target.x && camera.target.y == visibleCamera.target.y &&
+        camera.offset.x == visibleCamera.offset.x && camera.offset.y == visibleCamera.offset.y &&
+        camera.zoom == visibleCamera.zoom) {
+        return;
+    }
+    
+    // Углы окна в координатах раскладки (камера без поворота)
+    Vector2 topLeft = GetScreenToWorld2D({0, 0}, camera);
+    Vector2 bottomRight = GetScreenToWorld2D({static_cast<float>(windowWidth), static_cast<float>(windowHeight)}, camera);
+    // Запас в два радиуса: круг и подпись вершины за краем окна видны частично
+    viewIndex.query(graph, x, y, topLeft.x, topLeft.y, bottomRight.x, bottomRight.y,
+                    vertexRadius * 2, camera.zoom, visible);
+    visibleCamera = camera;
+    visibleValid = true;
+    visibleVersion++;
+}
+
+// Функция отрисовки плотных областей
+// Чем больше вершин в области, тем плотнее цвет квадрата
+void GraphVisualizerRaylib::drawDensityTiles() {
+    for (const DensityTile& tile : visible.tiles) {
+        float density = visible.tileDensity(tile);
+        Color color = vertexColor;
+        color.a = static_cast<unsigned char>(64 + 191 * density);
+        DrawRectangleRec({tile.x, tile.y, tile.size, tile.size}, color);
+    }
+}
+
+// Функция отрисовки графа по одной фигуре
+// Сначала рисуем рёбра, потом вершины (чтобы вершины были поверх рёбер)
+void GraphVisualizerRaylib::drawImmediate(const std::vector<float>& posX, const std::vector<float>& posY,
+                                          bool drawLabels) {    
+    // Отрисовка видимых рёбер графа
+    const auto& edges = visible.edges;
+    {
+        GRAPH_PROFILE_SCOPE(DrawEdges);
+        for (const auto& edge : edges) {
+            int u = edge.first;   // Первая вершина ребра
+            int v = edge.second;  // Вторая вершина ребра
+            
+            // Рисуем линию между вершинами u и v
+            DrawLineEx(
+                {posX[u], posY[u]},  // Начальная точка (вершина u)
+                {posX[v], posY[v]},  // Конечная точка (вершина v)
+                2.0f,                // Толщина линии в пикселях
+                edgeColor            // Цвет линии
+            );
+        }
+        GRAPH_PROFILE_COUNT(EdgesDrawn, edges.size());
+    }
+    
+    // Отрисовка видимых вершин графа
+    {
+        GRAPH_PROFILE_SCOPE(DrawVertices);
+        for (int i : visible.vertices) {
+            // Рисуем заполненный круг для вершины
+            DrawCircleV({posX[i], posY[i]}, vertexRadius, vertexColor);
+            
+            // Рисуем обводку вокруг вершины (чёрный контур)
+            DrawCircleLines(posX[i], posY[i], vertexRadius, BLACK);
+        }
+        GRAPH_PROFILE_COUNT(VerticesDrawn, visible.vertices.size());
+    }
+    
+    // Отрисовка номеров вершин (отдельным проходом - поверх всех кругов,
+    // и время текста измеряется отдельно от кругов)
+    if (!drawLabels) return;
+    GRAPH_PROFILE_SCOPE(DrawLabels);
+    size_t glyphs = 0;  // Нарисовано цифр (как drawnGlyphs в GraphRenderer)
+    for (int i : visible.vertices) {
         // Рисуем номер вершины в центре круга
-        const char* text = TextFormat("%d", i);      // Форматируем номер вершины
-        int textWidth = MeasureText(text, 20);       // Измеряем ширину текста
+        const char* text = TextFormat("%d", graph.getOriginalId(i));  // Форматируем исходный номер вершины
+        glyphs += std::strlen(text);
+        int textWidth = MeasureText(text, LABEL_FONT_SIZE);    // Измеряем ширину текста
         DrawText(
-            text,                            // Текст для отрисовки
-            vertices[i].x - textWidth / 2,   // X-позиция (центрируем текст)
-            vertices[i].y - 10,              // Y-позиция (центрируем по вертикали)
-            20,                              // Размер шрифта
-            textColor                        // Цвет текста
+            text,                                 // Текст для отрисовки
+            posX[i] - textWidth / 2,              // X-позиция (центрируем текст)
+            posY[i] - LABEL_FONT_SIZE / 2,        // Y-позиция (центрируем по вертикали)
+            LABEL_FONT_SIZE,                      // Размер шрифта
+            textColor                             // Цвет текста
         );
     }
+    GRAPH_PROFILE_COUNT(LabelGlyphsDrawn, glyphs);
+}
+
+// Перевод цвета RayLib в цвет экспорта
+static ExportColor toExportColor(Color color) {
+    return {color.r, color.g, color.b, color.a};
+}
+
+// Функция подготовки экспорта картинки
+void GraphVisualizerRaylib::prepareExport(ExportView& view, ExportStyle& style) {
+    // Та же видимая часть, что рисует draw() (камера без поворота)
+    updateVisibleSet(layout.getX(), layout.getY(), layout.getPositionsVersion());
+    
+    view.width = windowWidth;
+    view.height = windowHeight;
+    view.scale = camera.zoom;
+    view.offsetX = camera.offset.x - camera.target.x * camera.zoom;
+    view.offsetY = camera.offset.y - camera.target.y * camera.zoom;
+    
+    style.vertexRadius = vertexRadius;
+    style.edgeWidth = 2.0f;
+    style.fontSize = LABEL_FONT_SIZE;
+    style.drawLabels = LABEL_FONT_SIZE * camera.zoom >= LABEL_MIN_PIXELS;
+    // Подписи - исходные номера вершин (у перенумерованного графа)
+    if (!graph.getOriginalIds().empty()) style.labels = &graph.getOriginalIds();
+    style.vertexColor = toExportColor(vertexColor);
+    style.outlineColor = toExportColor(BLACK);
+    style.edgeColor = toExportColor(edgeColor);
+    style.textColor = toExportColor(textColor);
+    style.backgroundColor = toExportColor(backgroundColor);
+}
+
+// Функция экспорта картинки в PNG
+bool GraphVisualizerRaylib::exportPng(const std::string& filename, int numThreads) {
+    ExportView view;
+    ExportStyle style;
+    prepareExport(view, style);
+    return GraphExport::writePng(filename, layout.getX(), layout.getY(), visible, view, style, numThreads);
+}
+
+// Функция экспорта картинки в SVG
+bool GraphVisualizerRaylib::exportSvg(const std::string& filename) {
+    ExportView view;
+    ExportStyle style;
+    prepareExport(view, style);
+    return GraphExport::writeSvg(filename, layout.getX(), layout.getY(), visible, view, style);
+}
+
+// Функция сохранения графа и координат вершин в бинарный файл
+bool GraphVisualizerRaylib::saveLayout(const std::string& filename) const {
+    return layout.saveLayout(filename);
+}
+
+// Функция загрузки координат вершин из бинарного файла
+bool GraphVisualizerRaylib::loadLayout(const std::string& filename) {
+    return layout.loadLayout(filename);
 }
 
 // Функция отображения графа в окне RayLib
@@ -275,49 +282,77 @@ void GraphVisualizerRaylib::display() {
     // Устанавливаем целевую частоту кадров (60 FPS)
     SetTargetFPS(60);
     
-    // Флаг для включения/выключения автоматической оптимизации
-    bool isOptimizing = false;
-    // Счётчик выполненных шагов оптимизации
-    int optimizationSteps = 0;
-    // Количество шагов оптимизации за один кадр
-    const int stepsPerFrame = 5;
+    // Оптимизация выполняется в фоновом потоке; пока он работает, раскладку
+    // меняет только он, а кадр рисуется по последнему готовому снимку координат
+    LayoutWorker worker(layout);
+    // Не больше 300 шагов в секунду (5 шагов за кадр при 60 FPS), чтобы
+    // раскладка маленького графа оставалась анимацией
+    worker.setStepsPerSecond(300);
+    // Состояние оптимизации в предыдущем кадре (для сообщений в консоль)
+    bool wasOptimizing = false;
+#ifdef GRAPH_ENABLE_PROFILING
+    // Снимок счётчиков на начало предыдущего кадра
+    ProfileStats previousStats = Profiler::snapshot();
+#endif
     
     // Главный игровой цикл (выполняется пока окно не закрыто)
     while (!WindowShouldClose()) {
+#ifdef GRAPH_ENABLE_PROFILING
+        // Статистика предыдущего кадра (шаги раскладки и отрисовка)
+        ProfileStats currentStats = Profiler::snapshot();
+        frameStats = currentStats.since(previousStats);
+        previousStats = currentStats;
+#endif
+        
         // ===== ОБРАБОТКА ВВОДА =====
         
         // Если нажата клавиша ПРОБЕЛ - переключаем режим оптимизации
+        // (охлаждение при запуске начинается заново с длины шага в одно ребро)
         if (IsKeyPressed(KEY_SPACE)) {
-            isOptimizing = !isOptimizing;  // Инвертируем флаг
-            if (isOptimizing) {
-                std::cout << "Оптимизация запущена (нажмите Пробел для остановки)" << std::endl;
-            } else {
-                std::cout << "Оптимизация остановлена" << std::endl;
-            }
+            worker.toggle();
         }
         
-        // Если нажата клавиша R - сбрасываем позиции вершин
+        // Если нажата клавиша R - сбрасываем позиции вершин (размещаем по кругу)
         if (IsKeyPressed(KEY_R)) {
             std::cout << "Сброс позиций вершин" << std::endl;
-            initializePositions();       // Размещаем вершины по кругу
-            optimizationSteps = 0;       // Сбрасываем счётчик шагов
+            worker.resetCircle(windowWidth / 2.0f, windowHeight / 2.0f, initialRadius());
         }
         
         // Если нажата клавиша C - центрируем граф
         if (IsKeyPressed(KEY_C)) {
-            centerGraph();
+            worker.center(windowWidth / 2.0f, windowHeight / 2.0f);
+        }
+        
+        // Если нажата клавиша Z - возвращаем масштаб и сдвиг по умолчанию
+        if (IsKeyPressed(KEY_Z)) {
+            resetCamera();
         }
         
-        // ===== ПРИМЕНЕНИЕ ОПТИМИЗАЦИИ =====
+        // Колесо мыши и перетаскивание - масштаб и сдвиг
+        updateCamera();
         
-        // Если включена оптимизация и не достигнут лимит шагов
-        if (isOptimizing && optimizationSteps < 1000) {
-            // Выполняем несколько шагов оптимизации за кадр
-            for (int i = 0; i < stepsPerFrame; i++) {
-                applyForceDirectedStep();  // Применяем force-directed алгоритм
-                optimizationSteps++;       // Увеличиваем счётчик
+        // Если нажата клавиша B - переключаем пакетную отрисовку
+        if (IsKeyPressed(KEY_B)) {
+            batchedRendering = !batchedRendering;
+            std::cout << (batchedRendering ? "Пакетная отрисовка включена" : "Пакетная отрисовка выключена")
+                      << std::endl;
+        }
+        
+        // ===== СОСТОЯНИЕ ОПТИМИЗАЦИИ =====
+        
+        // Последний готовый снимок координат (без ожидания фонового потока)
+        const LayoutSnapshot& snapshot = worker.latest();
+        if (snapshot.running && !wasOptimizing) {
+            std::cout << "Оптимизация запущена (нажмите Пробел для остановки)" << std::endl;
+        } else if (!snapshot.running && wasOptimizing) {
+            if (snapshot.converged) {
+                std::cout << "Раскладка стабилизировалась за " << snapshot.steps
+                          << " шагов, энергия " << snapshot.energy << std::endl;
+            } else {
+                std::cout << "Оптимизация остановлена" << std::endl;
             }
         }
+        wasOptimizing = snapshot.running;
         
         // ===== ОТРИСОВКА =====
         
@@ -326,12 +361,14 @@ void GraphVisualizerRaylib::display() {
         // Очищаем фон заданным цветом
         ClearBackground(backgroundColor);
         
-        // Рисуем граф (рёбра и вершины)
-        draw();
+        // Рисуем граф (рёбра и вершины) в координатах камеры
+        BeginMode2D(camera);
+        drawPositions(snapshot.x, snapshot.y, snapshot.version);
+        EndMode2D();
         
         // Отрисовка текстовых инструкций внизу экрана
         DrawText(
-            "Пробел - оптимизация | R - сброс | C - центр | ESC - выход",
+            "Пробел - оптимизация | R - сброс | C - центр | B - пакетная отрисовка | колесо, мышь - масштаб, сдвиг | Z - вид | ESC - выход",
             10,                    // X-позиция
             windowHeight - 30,     // Y-позиция (внизу экрана)
             16,                    // Размер шрифта
@@ -347,19 +384,93 @@ void GraphVisualizerRaylib::display() {
             DARKGRAY                           // Цвет текста
         );
         
+#ifdef GRAPH_ENABLE_PROFILING
+        // Время участков за предыдущий кадр (под счётчиком FPS)
+        drawStatsOverlay();
+#endif
+        
         // Завершаем отрисовку кадра и выводим на экран
         EndDrawing();
     }
     
+    // Останавливаем фоновый поток: раскладка снова принадлежит визуализатору
+    worker.stop();
+    // Освобождаем сетки и текстуры, пока контекст OpenGL ещё жив
+    renderer.unload();
     // Закрываем окно и освобождаем ресурсы RayLib
     CloseWindow();
 }
 
+// Функция управления камерой
+void GraphVisualizerRaylib::updateCamera() {
+    // Колесо мыши: масштаб относительно точки под курсором
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0) {
+        Vector2 mouse = GetMousePosition();
+        // Точка раскладки под курсором остаётся под курсором
+        camera.target = GetScreenToWorld2D(mouse, camera);
+        camera.offset = mouse;
+        camera.zoom = std::clamp(camera.zoom * std::pow(1.1f, wheel), MIN_ZOOM, MAX_ZOOM);
+    }
+    
+    // Перетаскивание левой кнопкой: сдвиг на смещение мыши
+    if (IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+        Vector2 delta = GetMouseDelta();
+        camera.target.x -= delta.x / camera.zoom;
+        camera.target.y -= delta.y / camera.zoom;
+    }
+}
+
+// Функция сброса камеры
+void GraphVisualizerRaylib::resetCamera() {
+    camera.offset = {0, 0};
+    camera.target = {0, 0};
+    camera.rotation = 0;
+    camera.zoom = 1.0f;
+}
+
+#ifdef GRAPH_ENABLE_PROFILING
+// Функция отрисовки панели статистики
+// Для каждого участка, выполнявшегося в прошлом кадре, выводится
+// количество вызовов и суммарное время, затем ненулевые счётчики
+void GraphVisualizerRaylib::drawStatsOverlay() const {
+    int x = windowWidth - 260;  // Левый край панели
+    int y = 32;                 // Первая строка - под счётчиком FPS
+    const int lineHeight = 16;  // Расстояние между строками
+    
+    for (int i = 0; i < ProfileStats::SECTION_COUNT; i++) {
+        ProfileSection section = static_cast<ProfileSection>(i);
+        if (frameStats[section].calls == 0) continue;
+        DrawText(TextFormat("%s: %d x %.2f ms", Profiler::sectionName(section),
+                            static_cast<int>(frameStats[section].calls), frameStats.milliseconds(section)),
+                 x, y, 14, DARKGRAY);
+        y += lineHeight;
+    }
+    for (int i = 0; i < ProfileStats::COUNTER_COUNT; i++) {
+        ProfileCounter counter = static_cast<ProfileCounter>(i);
+        if (frameStats.count(counter) == 0) continue;
+        DrawText(TextFormat("%s: %llu", Profiler::counterName(counter),
+                            static_cast<unsigned long long>(frameStats.count(counter))),
+                 x, y, 14, DARKGRAY);
+        y += lineHeight;
+    }
+}
+
+// Функция возвращает статистику последнего кадра
+const ProfileStats& GraphVisualizerRaylib::getFrameStats() const {
+    return frameStats;
+}
+#endif
+
 // ===== СЕТТЕРЫ ДЛЯ НАСТРОЙКИ ПАРАМЕТРОВ ВИЗУАЛИЗАЦИИ =====
 
 // Установить радиус вершин в пикселях
 void GraphVisualizerRaylib::setVertexRadius(float radius) {
     vertexRadius = radius;
+    // Отступ от границ окна зависит от радиуса
+    updateLayoutBounds();
+    // Запас видимой области тоже
+    visibleValid = false;
 }
 
 // Установить цвет вершин (формат RGBA)
@@ -377,6 +488,11 @@ void GraphVisualizerRaylib::setTextColor(Color color) {
     textColor = color;
 }
 
+// Включить или выключить пакетную отрисовку
+void GraphVisualizerRaylib::setBatchedRendering(bool enabled) {
+    batchedRendering = enabled;
+}
+
 // Установить цвет фона окна
 void GraphVisualizerRaylib::setBackgroundColor(Color color) {
     backgroundColor = color;
@@ -387,23 +503,53 @@ void GraphVisualizerRaylib::setBackgroundColor(Color color) {
 // Установить силу отталкивания между вершинами
 // Большие значения - вершины отталкиваются сильнее
 void GraphVisualizerRaylib::setRepulsionForce(float force) {
-    repulsionForce = force;
+    layout.setRepulsionForce(force);
 }
 
 // Установить силу притяжения вдоль рёбер
 // Большие значения - рёбра сильнее притягивают вершины
 void GraphVisualizerRaylib::setAttractionForce(float force) {
-    attractionForce = force;
+    layout.setAttractionForce(force);
 }
 
 // Установить коэффициент затухания (0-1)
 // Близко к 1 - медленное затухание, близко к 0 - быстрое
 void GraphVisualizerRaylib::setDamping(float d) {
-    damping = d;
+    layout.setDamping(d);
 }
 
 // Установить оптимальное расстояние между соединёнными вершинами
 void GraphVisualizerRaylib::setOptimalDistance(float distance) {
-    optimalDistance = distance;
+    layout.setOptimalDistance(distance);
+}
+
+// Установить способ расчёта сил отталкивания
+void GraphVisualizerRaylib::setRepulsionMode(RepulsionMode mode) {
+    layout.setRepulsionMode(mode);
+}
+
+// Установить угол раскрытия Barnes-Hut
+// Меньшие значения - точнее, но медленнее (0 - эквивалент точного расчёта)
+void GraphVisualizerRaylib::setBarnesHutTheta(float theta) {
+    layout.setBarnesHutTheta(theta);
 }
 
+// Установить радиус отсечения для режима Grid
+void GraphVisualizerRaylib::setGridCutoffFactor(float factor) {
+    layout.setGridCutoffFactor(factor);
+}
+
+// Установить количество потоков для расчёта раскладки
+void GraphVisualizerRaylib::setThreadCount(int numThreads) {
+    layout.setThreadCount(numThreads);
+}
+
+// Включить или выключить адаптивное охлаждение
+void GraphVisualizerRaylib::setAdaptiveCooling(bool enabled) {
+    layout.setAdaptiveCooling(enabled);
+}
+
+// Установить порог сходимости (доля оптимальной длины ребра)
+void GraphVisualizerRaylib::setConvergenceTolerance(float tolerance) {
+    layout.setConvergenceTolerance(tolerance);
+}
@@ -1,29 +1,26 @@
 #pragma once
 
 #include "Graph.h"
+#include "ForceLayout.h"
+#include "GraphRenderer.h"
+#include "ViewportIndex.h"
+#include "GraphExport.h"
+#include "Profiler.h"
 #include <raylib.h>
 #include <vector>
 #include <cmath>
 
-/**
- * Структура для хранения позиции вершины
- */
-struct VertexRaylib {
-    float x, y;      // Координаты
-    float vx, vy;    // Скорость (для force-directed алгоритма)
-    
-    VertexRaylib() : x(0), y(0), vx(0), vy(0) {}
-    VertexRaylib(float x, float y) : x(x), y(y), vx(0), vy(0) {}
-};
-
 /**
  * Класс GraphVisualizerRaylib - визуализация неориентированного графа с RayLib
  * Использует force-directed алгоритм для минимизации пересечений рёбер
+ * (расчёт раскладки выполняет ForceLayout, визуализатор только рисует)
  */
 class GraphVisualizerRaylib {
 private:
     const Graph& graph;
-    std::vector<VertexRaylib> vertices;
+    
+    // Force-directed раскладка (координаты вершин, силы, охлаждение)
+    ForceLayout layout;
     
     // Параметры окна
     int windowWidth;
@@ -36,11 +33,25 @@ private:
     Color textColor;
     Color backgroundColor;
     
-    // Параметры force-directed алгоритма
-    float repulsionForce;     // Сила отталкивания между вершинами
-    float attractionForce;    // Сила притяжения вдоль рёбер
-    float damping;            // Демпфирование (для затухания колебаний)
-    float optimalDistance;    // Оптимальное расстояние между вершинами
+    // Пакетная отрисовка (сетки в видеокарте) и флаг её использования
+    GraphRenderer renderer;
+    bool batchedRendering;
+    
+    // Камера (сдвиг и масштаб окна)
+    Camera2D camera;
+    
+    // Индекс видимости и видимая часть графа для текущей камеры
+    ViewportIndex viewIndex;
+    uint64_t indexVersion;       // Версия координат, по которым построен индекс
+    VisibleSet visible;
+    Camera2D visibleCamera;      // Камера, для которой найдена видимая часть
+    bool visibleValid;
+    uint64_t visibleVersion;     // Номер видимой части (для буферов GraphRenderer)
+    
+#ifdef GRAPH_ENABLE_PROFILING
+    // Время участков и счётчики за последний кадр display()
+    ProfileStats frameStats;
+#endif
     
     /**
      * Инициализировать позиции вершин
@@ -49,31 +60,92 @@ private:
     void initializePositions();
     
     /**
-     * Применить force-directed алгоритм для одной итерации
+     * Радиус начального круга вершин
+     * @return 35% от меньшей стороны окна
+     */
+    float initialRadius() const;
+    
+    /**
+     * Ограничить раскладку окном (с отступом в два радиуса вершины)
      */
-    void applyForceDirectedStep();
+    void updateLayoutBounds();
     
     /**
-     * Рассчитать силу отталкивания между двумя вершинами
+     * Центрировать граф в окне
      */
-    void calculateRepulsion(int i, int j);
+    void centerGraph();
     
     /**
-     * Рассчитать силу притяжения вдоль ребра
+     * Масштабировать и сдвинуть раскладку так, чтобы она поместилась в окно
      */
-    void calculateAttraction(int i, int j);
+    void fitToWindow();
     
     /**
-     * Обновить позиции вершин на основе скоростей
+     * Нарисовать граф с заданными координатами вершин
+     * (из раскладки или из снимка фонового потока)
+     * @param x - X-координаты вершин
+     * @param y - Y-координаты вершин
+     * @param version - версия координат
      */
-    void updatePositions();
+    void drawPositions(const std::vector<float>& x, const std::vector<float>& y, uint64_t version);
     
     /**
-     * Центрировать граф в окне
+     * Обновить индекс (если вершины сдвинулись) и видимую часть графа
+     * (если сдвинулись вершины или камера)
+     * @param x - X-координаты вершин
+     * @param y - Y-координаты вершин
+     * @param version - версия координат
      */
-    void centerGraph();
+    void updateVisibleSet(const std::vector<float>& x, const std::vector<float>& y, uint64_t version);
+    
+    /**
+     * Нарисовать плотные области полупрозрачными квадратами
+     */
+    void drawDensityTiles();
+    
+    /**
+     * Нарисовать видимую часть графа по одной фигуре за вызов
+     * (DrawLineEx, DrawCircleV, DrawText)
+     * Используется, если пакетная отрисовка выключена или недоступна
+     * @param posX - X-координаты вершин
+     * @param posY - Y-координаты вершин
+     * @param drawLabels - рисовать номера вершин
+     */
+    void drawImmediate(const std::vector<float>& posX, const std::vector<float>& posY, bool drawLabels);
+    
+    /**
+     * Обработать колесо мыши (масштаб к курсору) и перетаскивание (сдвиг)
+     */
+    void updateCamera();
+    
+#ifdef GRAPH_ENABLE_PROFILING
+    /**
+     * Нарисовать панель со временем участков за последний кадр
+     * (есть только при сборке с GRAPH_ENABLE_PROFILING)
+     */
+    void drawStatsOverlay() const;
+#endif
+    
+    /**
+     * Подготовить экспорт картинки: видимая часть для текущей камеры,
+     * перевод координат и оформление как в окне
+     * @param view - размер окна и камера
+     * @param style - цвета и размеры визуализатора
+     */
+    void prepareExport(ExportView& view, ExportStyle& style);
 
 public:
+    /**
+     * Размер номера вершины на экране (пикселей), ниже которого подписи не рисуются
+     */
+    static const int LABEL_MIN_PIXELS = 8;
+    
+    /**
+     * Пределы масштаба камеры
+     */
+    static constexpr float MIN_ZOOM = 0.01f;
+    static constexpr float MAX_ZOOM = 20.0f;
+    
     /**
      * Конструктор визуализатора
      * @param g - граф для визуализации
@@ -84,20 +156,89 @@ public:
     
     /**
      * Оптимизировать расположение вершин
-     * @param iterations - количество итераций
+     * Останавливается раньше, когда максимальное смещение вершины за шаг
+     * становится меньше порога (см. setConvergenceTolerance)
+     * @param maxIterations - максимальное количество итераций
+     * @return количество итераций, конечная энергия и признак сходимости
+     */
+    LayoutResult optimize(int maxIterations = 1000);
+    
+    /**
+     * Многоуровневая оптимизация для больших графов (огрубление - раскладка -
+     * уточнение): граф огрубляется паросочетаниями, самый грубый уровень
+     * раскладывается с нуля, затем позиции переносятся на подробные уровни
+     * и уточняются несколькими шагами. Результат вписывается в окно.
+     * @param refineIterations - количество шагов уточнения на исходном уровне
+     * @return суммарное количество шагов по всем уровням и энергия
      */
-    void optimize(int iterations = 1000);
+    LayoutResult optimizeMultilevel(int refineIterations = 30);
+    
+    /**
+     * Сохранить граф вместе с текущими координатами вершин в бинарный файл
+     * @param filename - имя файла (формат BinaryGraphFormat)
+     * @return true если файл записан
+     */
+    bool saveLayout(const std::string& filename) const;
+    
+    /**
+     * Загрузить координаты вершин из бинарного файла
+     * @param filename - имя файла, сохранённого saveLayout
+     * @return true если координаты загружены (количество вершин совпадает)
+     */
+    bool loadLayout(const std::string& filename);
     
     /**
      * Отобразить граф в окне RayLib
+     * Живая оптимизация (Пробел) идёт в фоновом потоке (см. LayoutWorker),
+     * окно рисует последний готовый снимок координат
      */
     void display();
     
     /**
-     * Отрисовать граф
+     * Отрисовать граф (внутри BeginMode2D с камерой визуализатора)
+     * Рисуется только часть графа в окне (см. ViewportIndex): плотные области -
+     * квадратами плотности, мелкие подписи пропускаются. Пакетно (три сетки,
+     * см. GraphRenderer), если это включено и поддерживается контекстом OpenGL,
+     * иначе по одной фигуре
      */
     void draw();
     
+    /**
+     * Записать в PNG то же изображение, что draw() рисует в окне
+     * (окно и видеокарта не нужны, см. GraphExport)
+     * @param filename - имя файла
+     * @param numThreads - потоков растеризации (1 - последовательно, 0 - все ядра)
+     * @return true если файл записан
+     */
+    bool exportPng(const std::string& filename, int numThreads = 0);
+    
+    /**
+     * Записать в SVG то же изображение, что draw() рисует в окне
+     * @param filename - имя файла
+     * @return true если файл записан
+     */
+    bool exportSvg(const std::string& filename);
+    
+    /**
+     * Сбросить камеру (масштаб 1, без сдвига)
+     */
+    void resetCamera();
+    
+    /**
+     * Включить или выключить пакетную отрисовку (клавиша B в окне)
+     * @param enabled - true для пакетной отрисовки (по умолчанию)
+     */
+    void setBatchedRendering(bool enabled);
+    
+#ifdef GRAPH_ENABLE_PROFILING
+    /**
+     * Получить время участков и счётчики за последний кадр display()
+     * (есть только при сборке с GRAPH_ENABLE_PROFILING)
+     * @return статистика кадра
+     */
+    const ProfileStats& getFrameStats() const;
+#endif
+    
     /**
      * Установить параметры визуализации
      */
@@ -114,5 +255,46 @@ public:
     void setAttractionForce(float force);
     void setDamping(float d);
     void setOptimalDistance(float distance);
+    
+    /**
+     * Установить способ расчёта сил отталкивания
+     * @param mode - Exact, BarnesHut, Grid или Auto
+     */
+    void setRepulsionMode(RepulsionMode mode);
+    
+    /**
+     * Установить угол раскрытия для Barnes-Hut
+     * @param theta - 0 даёт точный результат, 0.5-1.0 - обычный компромисс
+     */
+    void setBarnesHutTheta(float theta);
+    
+    /**
+     * Установить радиус отсечения для режима Grid
+     * Ячейка сетки равна радиусу, поэтому перебираются только 3x3 соседние ячейки
+     * @param factor - радиус в долях optimalDistance (по умолчанию 2.0)
+     */
+    void setGridCutoffFactor(float factor);
+    
+    /**
+     * Включить или выключить адаптивное охлаждение (схема Hu)
+     * Включено: вершина сдвигается на длину шага вдоль своей силы, длина шага
+     * подстраивается по изменению энергии. Выключено: скорость = сила * damping
+     * @param enabled - true для адаптивного охлаждения
+     */
+    void setAdaptiveCooling(bool enabled);
+    
+    /**
+     * Установить порог сходимости
+     * @param tolerance - максимальное смещение за шаг в долях optimalDistance
+     */
+    void setConvergenceTolerance(float tolerance);
+    
+    /**
+     * Установить количество потоков для расчёта раскладки
+     * Каждая вершина накапливает силы только в свои элементы массивов,
+     * поэтому результат не зависит от количества потоков и планирования
+     * @param numThreads - количество потоков (0 - по числу ядер)
+     */
+    void setThreadCount(int numThreads);
 };
 
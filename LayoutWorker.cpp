@@ -0,0 +1,147 @@
+// Подключаем заголовочный файл фонового потока раскладки
+#include "LayoutWorker.h"
+// Подключаем часы для ограничения скорости шагов
+#include <chrono>
+
+// Конструктор: первый снимок публикуется до запуска потока,
+// поэтому latest() сразу возвращает текущие координаты
+LayoutWorker::LayoutWorker(ForceLayout& l)
+    : layout(l), stopping(false), stepsPerSecond(0), running(false), steps(0), converged(false) {
+    publish();
+    thread = std::thread(&LayoutWorker::run, this);
+}
+
+// Деструктор
+LayoutWorker::~LayoutWorker() {
+    stop();
+}
+
+// Функция остановки потока
+void LayoutWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (thread.joinable()) thread.join();
+}
+
+// Функция отправки команды
+void LayoutWorker::send(const Command& command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        commands.push_back(command);
+    }
+    wake.notify_one();
+}
+
+// Запустить или остановить оптимизацию
+void LayoutWorker::toggle() {
+    send({CommandType::Toggle, 0, 0, 0});
+}
+
+// Расставить вершины по кругу
+void LayoutWorker::resetCircle(float centerX, float centerY, float radius) {
+    send({CommandType::ResetCircle, centerX, centerY, radius});
+}
+
+// Сдвинуть центр масс вершин
+void LayoutWorker::center(float centerX, float centerY) {
+    send({CommandType::Center, centerX, centerY, 0});
+}
+
+// Установить ограничение скорости шагов
+void LayoutWorker::setStepsPerSecond(int limit) {
+    stepsPerSecond.store(limit < 0 ? 0 : limit, std::memory_order_relaxed);
+    // Поток может ждать следующего шага по старому интервалу
+    wake.notify_one();
+}
+
+// Функция получения последнего снимка
+const LayoutSnapshot& LayoutWorker::latest() {
+    snapshots.update();
+    return snapshots.readBuffer();
+}
+
+// Функция выполнения команды
+void LayoutWorker::apply(const Command& command) {
+    switch (command.type) {
+    case CommandType::Toggle:
+        running = !running;
+        if (running) {
+            // Охлаждение начинается заново с длины шага в одно ребро
+            layout.resetCooling();
+            steps = 0;
+            converged = false;
+        }
+        break;
+    case CommandType::ResetCircle:
+        layout.initializeCircle(command.x, command.y, command.radius);
+        layout.resetCooling();
+        steps = 0;
+        converged = false;
+        break;
+    case CommandType::Center:
+        layout.center(command.x, command.y);
+        break;
+    }
+}
+
+// Функция публикации снимка
+void LayoutWorker::publish() {
+    LayoutSnapshot& snapshot = snapshots.writeBuffer();
+    // assign переиспользует память экземпляра
+    snapshot.x.assign(layout.getX().begin(), layout.getX().end());
+    snapshot.y.assign(layout.getY().begin(), layout.getY().end());
+    snapshot.version = layout.getPositionsVersion();
+    snapshot.steps = steps;
+    snapshot.energy = layout.getEnergy();
+    snapshot.running = running;
+    snapshot.converged = converged;
+    snapshots.publish();
+}
+
+// Главная функция фонового потока
+void LayoutWorker::run() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point nextStep = Clock::now();
+    std::vector<Command> pending;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        // Без оптимизации поток спит до команды, с оптимизацией - до следующего шага
+        auto hasWork = [this] { return stopping || !commands.empty(); };
+        if (running) {
+            wake.wait_until(lock, nextStep, hasWork);
+        } else {
+            wake.wait(lock, hasWork);
+        }
+        if (stopping) break;
+        pending.swap(commands);
+        lock.unlock();
+
+        // Команды выполняются между шагами, раскладка меняется только здесь
+        bool changed = !pending.empty();
+        for (const Command& command : pending) {
+            apply(command);
+        }
+        pending.clear();
+
+        Clock::time_point now = Clock::now();
+        if (running && now >= nextStep) {
+            bool stable = layout.coolingStep();
+            steps++;
+            if (stable) {
+                running = false;
+                converged = true;
+            }
+            changed = true;
+            // Следующий шаг не раньше 1/stepsPerSecond секунды
+            int limit = stepsPerSecond.load(std::memory_order_relaxed);
+            nextStep = limit > 0 ? now + std::chrono::microseconds(1000000 / limit) : now;
+        }
+
+        if (changed) publish();
+        lock.lock();
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "ForceLayout.h"
+#include "TripleBuffer.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Снимок раскладки, опубликованный фоновым потоком
+ */
+struct LayoutSnapshot {
+    std::vector<float> x;    // X-координаты вершин
+    std::vector<float> y;    // Y-координаты вершин
+    uint64_t version;        // Версия координат (ForceLayout::getPositionsVersion)
+    int steps;               // Шагов с последнего запуска или сброса
+    float energy;            // Энергия последнего шага
+    bool running;            // Оптимизация идёт
+    bool converged;          // Раскладка стабилизировалась (оптимизация остановлена сама)
+
+    LayoutSnapshot() : version(0), steps(0), energy(0), running(false), converged(false) {}
+};
+
+/**
+ * Класс LayoutWorker - живая оптимизация раскладки в фоновом потоке
+ * Не зависит от RayLib.
+ *
+ * Поток выполняет шаги ForceLayout::coolingStep и после каждого шага
+ * публикует копию координат через TripleBuffer. Поток отрисовки забирает
+ * последний целиком готовый снимок без блокировок (latest()) и не ждёт
+ * расчёта, поэтому частота кадров не зависит от размера графа.
+ * Управление (запуск/остановка, сброс, центрирование) передаётся потоку
+ * командами; раскладка меняется только в фоновом потоке.
+ *
+ * Пока объект существует, к переданному ForceLayout нельзя обращаться
+ * из других потоков; после stop() (или деструктора) раскладка содержит
+ * последние координаты.
+ */
+class LayoutWorker {
+private:
+    // Команды потоку раскладки
+    enum class CommandType {
+        Toggle,         // Запустить или остановить оптимизацию
+        ResetCircle,    // Расставить вершины по кругу
+        Center          // Сдвинуть центр масс
+    };
+
+    struct Command {
+        CommandType type;
+        float x, y, radius;
+    };
+
+    ForceLayout& layout;
+    TripleBuffer<LayoutSnapshot> snapshots;  // Снимки для потока отрисовки
+
+    std::thread thread;
+    std::mutex mutex;                        // Защита очереди команд
+    std::condition_variable wake;            // Новая команда или остановка
+    std::vector<Command> commands;           // Очередь команд
+    bool stopping;
+    std::atomic<int> stepsPerSecond;         // Ограничение скорости (0 - без ограничения)
+
+    // Состояние потока раскладки (меняется только в нём)
+    bool running;
+    int steps;
+    bool converged;
+
+    /**
+     * Главная функция фонового потока
+     */
+    void run();
+
+    /**
+     * Выполнить команду (в фоновом потоке)
+     * @param command - команда
+     */
+    void apply(const Command& command);
+
+    /**
+     * Скопировать координаты и состояние в снимок и опубликовать его
+     */
+    void publish();
+
+    /**
+     * Поставить команду в очередь и разбудить поток
+     * @param command - команда
+     */
+    void send(const Command& command);
+
+public:
+    /**
+     * Запустить фоновый поток (оптимизация остановлена до toggle())
+     * @param layout - раскладка (принадлежит потоку до stop())
+     */
+    explicit LayoutWorker(ForceLayout& layout);
+
+    /**
+     * Остановить поток
+     */
+    ~LayoutWorker();
+
+    LayoutWorker(const LayoutWorker&) = delete;
+    LayoutWorker& operator=(const LayoutWorker&) = delete;
+
+    /**
+     * Запустить или остановить оптимизацию
+     * (при запуске охлаждение начинается заново)
+     */
+    void toggle();
+
+    /**
+     * Расставить вершины по кругу и начать охлаждение заново
+     * @param centerX, centerY - центр круга
+     * @param radius - радиус круга
+     */
+    void resetCircle(float centerX, float centerY, float radius);
+
+    /**
+     * Сдвинуть центр масс вершин в точку
+     * @param centerX, centerY - точка
+     */
+    void center(float centerX, float centerY);
+
+    /**
+     * Ограничить количество шагов в секунду (маленький граф иначе
+     * раскладывается мгновенно и без анимации)
+     * @param limit - шагов в секунду, 0 - без ограничения
+     */
+    void setStepsPerSecond(int limit);
+
+    /**
+     * Получить последний опубликованный снимок (только из одного потока -
+     * потока отрисовки). Ссылка действительна до следующего вызова latest()
+     * @return снимок
+     */
+    const LayoutSnapshot& latest();
+
+    /**
+     * Остановить фоновый поток и дождаться его завершения
+     */
+    void stop();
+};
@@ -2,6 +2,8 @@
 #include "Graph.h"
 // Подключаем заголовочный файл визуализатора с RayLib
 #include "GraphVisualizerRaylib.h"
+// Подключаем бинарный формат графа (загрузка и конвертация)
+#include "BinaryGraphFormat.h"
 // Подключаем библиотеку для ввода-вывода
 #include <iostream>
 // Подключаем библиотеку для работы со строками
@@ -42,6 +44,7 @@ int main() {
         cout << "4. Двудольный граф" << endl;
         cout << "5. Несвязный граф" << endl;
         cout << "6. Загрузить граф из файла" << endl;
+        cout << "7. Конвертировать файл графа (текст <-> бинарный)" << endl;
         cout << "0. Выход" << endl;
         cout << "========================================" << endl;
         cout << "Выберите опцию: ";
@@ -162,13 +165,20 @@ int main() {
         
         // Применяем алгоритм оптимизации расположения вершин
         cout << "\nПрименение алгоритма оптимизации расположения вершин..." << endl;
-        visualizer.optimize(500);  // Выполняем 500 итераций оптимизации
+        if (graph.getNumVertices() >= ForceLayout::BARNES_HUT_THRESHOLD) {
+            // Большой граф - многоуровневая раскладка (огрубление - раскладка - уточнение)
+            visualizer.optimizeMultilevel();
+        } else {
+            visualizer.optimize(500);  // Выполняем 500 итераций оптимизации
+        }
         
         // Выводим инструкции по управлению
         cout << "\n=== Управление ===" << endl;
         cout << "Пробел - включить/выключить оптимизацию в реальном времени" << endl;
         cout << "R - сбросить позиции вершин" << endl;
         cout << "C - центрировать граф" << endl;
+        cout << "B - пакетная отрисовка / по одной фигуре" << endl;
+        cout << "Колесо мыши - масштаб, перетаскивание - сдвиг, Z - исходный вид" << endl;
         cout << "ESC или закрыть окно - выход" << endl;
         cout << "\nОткрывается окно визуализации..." << endl;
         
@@ -234,7 +244,12 @@ int main() {
                 cout << "Введите имя файла: ";
                 cin >> filename;  // Читаем имя файла от пользователя
                 // Загружаем граф из файла (статический метод класса Graph)
-                graph = Graph::loadFromFile(filename);
+                // Бинарный файл открывается мгновенно через отображение в память
+                if (BinaryGraphFormat::isBinaryFile(filename)) {
+                    graph = Graph::openBinary(filename);
+                } else {
+                    graph = Graph::loadFromFile(filename);
+                }
                 // Проверяем, успешно ли загрузился граф
                 if (graph.getNumVertices() == 0) {
                     cout << "Не удалось загрузить граф." << endl;
@@ -243,6 +258,20 @@ int main() {
                 break;
             }
                 
+            case 7: {  // Конвертация между текстовым и бинарным форматом
+                string source, target;  // Имена исходного и результирующего файлов
+                cout << "Введите имя исходного файла: ";
+                cin >> source;
+                cout << "Введите имя результирующего файла: ";
+                cin >> target;
+                // Направление конвертации определяем по сигнатуре исходного файла
+                bool ok = BinaryGraphFormat::isBinaryFile(source)
+                    ? BinaryGraphFormat::convertBinaryToText(source, target)
+                    : BinaryGraphFormat::convertTextToBinary(source, target);
+                cout << (ok ? "Конвертация завершена." : "Конвертация не удалась.") << endl;
+                continue;  // Граф не визуализируем, возвращаемся к меню
+            }
+                
             default:  // Неверный выбор
                 cout << "Неверный выбор!" << endl;
                 continue;  // Возвращаемся к началу цикла
@@ -250,9 +279,19 @@ int main() {
         
         // Если граф успешно создан/загружен (не пуст)
         if (graph.getNumVertices() > 0) {
+            // Рёбра больше не добавляются - переводим граф в компактный формат CSR
+            graph.freeze();
+            
             // Демонстрируем алгоритмы на графе
             demonstrateGraphAlgorithms(graph);
             
+            // Большой граф перенумеровываем (обратный Катхилл-Макки): соседние
+            // вершины получают близкие номера, и обходы и раскладка читают
+            // память почти подряд. Подписи в окне - исходные номера вершин
+            if (graph.getNumVertices() >= ForceLayout::BARNES_HUT_THRESHOLD) {
+                graph = graph.relabel(graph.computeOrdering(VertexOrdering::ReverseCuthillMcKee));
+            }
+            
             // Визуализируем граф в окне RayLib
             visualizeGraph(graph);
         }
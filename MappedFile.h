@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/**
+ * Класс MappedFile - файл, отображённый в память только для чтения
+ * (mmap в POSIX, CreateFileMapping в Windows)
+ * Содержимое файла доступно как обычный массив байт без копирования,
+ * страницы подгружаются операционной системой по мере обращения.
+ */
+class MappedFile {
+private:
+    const char* ptr;       // Начало отображения
+    size_t length;         // Размер файла в байтах
+#ifdef _WIN32
+    void* fileHandle;      // Дескриптор файла (HANDLE)
+    void* mappingHandle;   // Дескриптор отображения (HANDLE)
+#else
+    int fd;                // Файловый дескриптор
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Отображение нельзя копировать (оно владеет системными ресурсами)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Отобразить файл в память
+     * @param filename - имя файла
+     * @return true если файл открыт и отображён (пустой файл открывается
+     *         с размером 0, без отображения)
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Закрыть отображение и файл
+     */
+    void close();
+
+    /**
+     * Проверить, открыт ли файл
+     * @return true если отображение активно
+     */
+    bool isOpen() const;
+
+    /**
+     * Получить указатель на содержимое файла
+     * @return указатель на первый байт
+     */
+    const char* data() const;
+
+    /**
+     * Получить размер файла
+     * @return размер в байтах
+     */
+    size_t size() const;
+};
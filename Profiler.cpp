@@ -0,0 +1,94 @@
+// Подключаем заголовочный файл профилировщика
+#include "Profiler.h"
+// Подключаем атомарные операции
+#include <atomic>
+
+// Накопленные значения участков и счётчиков
+namespace {
+
+std::atomic<uint64_t> sectionCalls[ProfileStats::SECTION_COUNT];
+std::atomic<uint64_t> sectionTotal[ProfileStats::SECTION_COUNT];
+std::atomic<uint64_t> sectionMax[ProfileStats::SECTION_COUNT];
+std::atomic<uint64_t> counterValues[ProfileStats::COUNTER_COUNT];
+
+// Имена участков (в порядке ProfileSection)
+const char* const SECTION_NAMES[ProfileStats::SECTION_COUNT] = {
+    "layout_step", "repulsion", "attraction", "energy", "update_positions", "displacement",
+    "draw_edges", "draw_vertices", "draw_labels",
+    "bfs", "parallel_bfs", "multi_source_bfs", "dfs", "biconnected", "components",
+    "load_from_file", "from_edge_list", "reorder", "stream_edges"
+};
+
+// Имена счётчиков (в порядке ProfileCounter)
+const char* const COUNTER_NAMES[ProfileStats::COUNTER_COUNT] = {
+    "layout_steps", "edges_drawn", "vertices_drawn", "label_glyphs_drawn", "vertices_visited"
+};
+
+} // namespace
+
+// Функция вычисления разности снимков
+ProfileStats ProfileStats::since(const ProfileStats& earlier) const {
+    ProfileStats result;
+    for (int i = 0; i < SECTION_COUNT; i++) {
+        result.sections[i].calls = sections[i].calls - earlier.sections[i].calls;
+        result.sections[i].totalNanoseconds = sections[i].totalNanoseconds - earlier.sections[i].totalNanoseconds;
+        result.sections[i].maxNanoseconds = sections[i].maxNanoseconds;
+    }
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        result.counters[i] = counters[i] - earlier.counters[i];
+    }
+    return result;
+}
+
+// Функция добавления вызова участка
+void Profiler::record(ProfileSection section, uint64_t nanoseconds) {
+    int i = static_cast<int>(section);
+    sectionCalls[i].fetch_add(1, std::memory_order_relaxed);
+    sectionTotal[i].fetch_add(nanoseconds, std::memory_order_relaxed);
+    // Максимум обновляем только если новый вызов дольше
+    uint64_t current = sectionMax[i].load(std::memory_order_relaxed);
+    while (nanoseconds > current &&
+           !sectionMax[i].compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+// Функция увеличения счётчика
+void Profiler::count(ProfileCounter counter, uint64_t amount) {
+    counterValues[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+// Функция получения снимка
+ProfileStats Profiler::snapshot() {
+    ProfileStats stats;
+    for (int i = 0; i < ProfileStats::SECTION_COUNT; i++) {
+        stats.sections[i].calls = sectionCalls[i].load(std::memory_order_relaxed);
+        stats.sections[i].totalNanoseconds = sectionTotal[i].load(std::memory_order_relaxed);
+        stats.sections[i].maxNanoseconds = sectionMax[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < ProfileStats::COUNTER_COUNT; i++) {
+        stats.counters[i] = counterValues[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+// Функция обнуления участков и счётчиков
+void Profiler::reset() {
+    for (int i = 0; i < ProfileStats::SECTION_COUNT; i++) {
+        sectionCalls[i].store(0, std::memory_order_relaxed);
+        sectionTotal[i].store(0, std::memory_order_relaxed);
+        sectionMax[i].store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < ProfileStats::COUNTER_COUNT; i++) {
+        counterValues[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// Функция возвращает имя участка
+const char* Profiler::sectionName(ProfileSection section) {
+    return SECTION_NAMES[static_cast<int>(section)];
+}
+
+// Функция возвращает имя счётчика
+const char* Profiler::counterName(ProfileCounter counter) {
+    return COUNTER_NAMES[static_cast<int>(counter)];
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+
+/**
+ * Измеряемые участки кода
+ */
+enum class ProfileSection {
+    LayoutStep,                  // Шаг force-directed алгоритма целиком
+    Repulsion,                   // Силы отталкивания (Exact, Barnes-Hut или Grid)
+    Attraction,                  // Силы притяжения вдоль рёбер
+    Energy,                      // Подсчёт энергии шага
+    UpdatePositions,             // Сдвиг вершин
+    Displacement,                // Подсчёт максимального смещения
+    DrawEdges,                   // Отрисовка рёбер
+    DrawVertices,                // Отрисовка кругов вершин
+    DrawLabels,                  // Отрисовка номеров вершин
+    BreadthFirstSearch,          // Обход в ширину
+    ParallelBreadthFirstSearch,  // Параллельный обход в ширину
+    MultiSourceBreadthFirstSearch,  // Обход в ширину из многих вершин
+    DepthFirstSearch,            // Обход в глубину
+    BiconnectedComponents,       // Точки сочленения, мосты и компоненты двусвязности
+    ConnectedComponents,         // Разметка компонент связности
+    LoadFromFile,                // Загрузка графа из текстового файла
+    FromEdgeList,                // Построение графа из списка рёбер
+    ReorderVertices,             // Перенумерация вершин (computeOrdering / relabel)
+    StreamEdges,                 // Потоковый проход по файлу рёбер (вместе с обработкой)
+    Count                        // Количество участков (не участок)
+};
+
+/**
+ * Счётчики событий
+ */
+enum class ProfileCounter {
+    LayoutSteps,      // Выполнено шагов раскладки
+    EdgesDrawn,       // Нарисовано рёбер
+    VerticesDrawn,    // Нарисовано вершин
+    LabelGlyphsDrawn, // Нарисовано цифр подписей
+    VerticesVisited,  // Вершин посещено обходами
+    Count             // Количество счётчиков (не счётчик)
+};
+
+/**
+ * Статистика одного участка
+ */
+struct ProfileSectionStats {
+    uint64_t calls;              // Количество вызовов
+    uint64_t totalNanoseconds;   // Суммарное время
+    uint64_t maxNanoseconds;     // Самый долгий вызов
+
+    ProfileSectionStats() : calls(0), totalNanoseconds(0), maxNanoseconds(0) {}
+};
+
+/**
+ * Снимок всех участков и счётчиков
+ */
+struct ProfileStats {
+    static const int SECTION_COUNT = static_cast<int>(ProfileSection::Count);
+    static const int COUNTER_COUNT = static_cast<int>(ProfileCounter::Count);
+
+    ProfileSectionStats sections[SECTION_COUNT];
+    uint64_t counters[COUNTER_COUNT];
+
+    ProfileStats() : counters() {}
+
+    /**
+     * Получить статистику участка
+     * @param section - участок
+     * @return количество вызовов и время
+     */
+    const ProfileSectionStats& operator[](ProfileSection section) const {
+        return sections[static_cast<int>(section)];
+    }
+
+    /**
+     * Получить значение счётчика
+     * @param counter - счётчик
+     * @return значение
+     */
+    uint64_t count(ProfileCounter counter) const {
+        return counters[static_cast<int>(counter)];
+    }
+
+    /**
+     * Суммарное время участка в миллисекундах
+     * @param section - участок
+     * @return время
+     */
+    double milliseconds(ProfileSection section) const {
+        return (*this)[section].totalNanoseconds / 1e6;
+    }
+
+    /**
+     * Разность снимков: что произошло между earlier и этим снимком
+     * (maxNanoseconds берётся из этого снимка)
+     * @param earlier - более ранний снимок
+     * @return разность
+     */
+    ProfileStats since(const ProfileStats& earlier) const;
+};
+
+/**
+ * Класс Profiler - счётчики и таймеры горячих путей
+ *
+ * Участки отмечаются макросом GRAPH_PROFILE_SCOPE(Section), счётчики -
+ * GRAPH_PROFILE_COUNT(Counter, n). Без макроса GRAPH_ENABLE_PROFILING
+ * (флаг компилятора -DGRAPH_ENABLE_PROFILING) оба макроса раскрываются
+ * в пустые выражения, и измерения полностью исчезают из кода.
+ * Значения накапливаются в атомарных переменных, поэтому участки можно
+ * отмечать из любых потоков.
+ */
+class Profiler {
+public:
+    /**
+     * Проверить, собрана ли программа с измерениями
+     * @return true если определён GRAPH_ENABLE_PROFILING
+     */
+    static constexpr bool enabled() {
+#ifdef GRAPH_ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Добавить один вызов участка
+     * @param section - участок
+     * @param nanoseconds - длительность вызова
+     */
+    static void record(ProfileSection section, uint64_t nanoseconds);
+
+    /**
+     * Увеличить счётчик
+     * @param counter - счётчик
+     * @param amount - приращение
+     */
+    static void count(ProfileCounter counter, uint64_t amount);
+
+    /**
+     * Получить снимок всех участков и счётчиков
+     * @return снимок (нули, если измерения выключены)
+     */
+    static ProfileStats snapshot();
+
+    /**
+     * Обнулить все участки и счётчики
+     */
+    static void reset();
+
+    /**
+     * Короткое латинское имя участка (для отчётов и экранной панели)
+     * @param section - участок
+     * @return имя
+     */
+    static const char* sectionName(ProfileSection section);
+
+    /**
+     * Короткое латинское имя счётчика
+     * @param counter - счётчик
+     * @return имя
+     */
+    static const char* counterName(ProfileCounter counter);
+};
+
+/**
+ * Таймер участка: замеряет время от создания до конца области видимости
+ */
+class ProfileScope {
+private:
+    ProfileSection section;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ProfileScope(ProfileSection s) : section(s), start(std::chrono::steady_clock::now()) {}
+
+    ~ProfileScope() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::record(section, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+// Склейка имени переменной с номером строки (несколько таймеров в одной функции)
+#define GRAPH_PROFILE_CONCAT_INNER(a, b) a##b
+#define GRAPH_PROFILE_CONCAT(a, b) GRAPH_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef GRAPH_ENABLE_PROFILING
+#define GRAPH_PROFILE_SCOPE(section) \
+    ProfileScope GRAPH_PROFILE_CONCAT(profileScope, __LINE__)(ProfileSection::section)
+#define GRAPH_PROFILE_COUNT(counter, amount) \
+    Profiler::count(ProfileCounter::counter, static_cast<uint64_t>(amount))
+#else
+#define GRAPH_PROFILE_SCOPE(section) ((void)0)
+#define GRAPH_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
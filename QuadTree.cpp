@@ -0,0 +1,193 @@
+// Подключаем заголовочный файл квадродерева
+#include "QuadTree.h"
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем математические функции (sqrt)
+#include <cmath>
+
+// Конструктор пустого дерева
+QuadTree::QuadTree() : posX(nullptr), posY(nullptr) {}
+
+// Функция построения дерева по координатам вершин
+void QuadTree::build(const std::vector<float>& x, const std::vector<float>& y) {
+    // Количество вершин
+    int n = static_cast<int>(x.size());
+    // Запоминаем указатели на координаты (используются при обходе)
+    posX = x.data();
+    posY = y.data();
+
+    // Очищаем узлы (память вектора сохраняется между шагами)
+    nodes.clear();
+    // Если вершин нет, дерево остаётся пустым
+    if (n == 0) return;
+
+    // Заполняем массив индексов вершин по порядку
+    indices.resize(n);
+    scratch.resize(n);
+    for (int i = 0; i < n; i++) {
+        indices[i] = i;
+    }
+
+    // Находим ограничивающий прямоугольник и центр масс всех вершин
+    float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    double sumX = 0, sumY = 0;
+    for (int i = 0; i < n; i++) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+        sumX += x[i];
+        sumY += y[i];
+    }
+
+    // Корень - квадрат, покрывающий все вершины (с небольшим запасом,
+    // чтобы вершины на правой/нижней границе попадали внутрь)
+    Node root;
+    root.minX = minX;
+    root.minY = minY;
+    root.size = std::max(maxX - minX, maxY - minY) + 1.0f;
+    root.massX = static_cast<float>(sumX / n);
+    root.massY = static_cast<float>(sumY / n);
+    root.count = n;
+    root.begin = 0;
+    root.end = n;
+    root.firstChild = -1;
+    nodes.push_back(root);
+
+    // Рекурсивно разбиваем корень
+    subdivide(0, 0);
+}
+
+// Функция разбиения узла на 4 квадранта
+void QuadTree::subdivide(int nodeIndex, int depth) {
+    // Копируем узел (вектор nodes может перевыделить память при добавлении детей)
+    Node node = nodes[nodeIndex];
+
+    // Маленькие узлы и слишком глубокие узлы остаются листьями
+    if (node.count <= LEAF_CAPACITY || depth >= MAX_DEPTH) return;
+
+    // Середина квадрата узла
+    float half = node.size / 2.0f;
+    float midX = node.minX + half;
+    float midY = node.minY + half;
+
+    // Считаем количество вершин и суммы координат в каждом квадранте
+    // Номер квадранта: бит 0 - правая половина, бит 1 - нижняя половина
+    int counts[4] = {0, 0, 0, 0};
+    double sumX[4] = {0, 0, 0, 0};
+    double sumY[4] = {0, 0, 0, 0};
+    for (int k = node.begin; k < node.end; k++) {
+        int v = indices[k];
+        int q = (posX[v] >= midX ? 1 : 0) + (posY[v] >= midY ? 2 : 0);
+        counts[q]++;
+        sumX[q] += posX[v];
+        sumY[q] += posY[v];
+    }
+
+    // Раскладываем индексы по квадрантам (сортировка подсчётом)
+    int offsets[4];
+    offsets[0] = node.begin;
+    for (int q = 1; q < 4; q++) {
+        offsets[q] = offsets[q - 1] + counts[q - 1];
+    }
+    int cursor[4] = {offsets[0], offsets[1], offsets[2], offsets[3]};
+    for (int k = node.begin; k < node.end; k++) {
+        int v = indices[k];
+        int q = (posX[v] >= midX ? 1 : 0) + (posY[v] >= midY ? 2 : 0);
+        scratch[cursor[q]++] = v;
+    }
+    std::copy(scratch.begin() + node.begin, scratch.begin() + node.end, indices.begin() + node.begin);
+
+    // Создаём 4 дочерних узла подряд (пустые узлы тоже храним, чтобы
+    // дети всегда находились по индексам firstChild..firstChild+3)
+    int firstChild = static_cast<int>(nodes.size());
+    for (int q = 0; q < 4; q++) {
+        Node child;
+        child.minX = (q & 1) ? midX : node.minX;
+        child.minY = (q & 2) ? midY : node.minY;
+        child.size = half;
+        child.count = counts[q];
+        child.massX = counts[q] > 0 ? static_cast<float>(sumX[q] / counts[q]) : midX;
+        child.massY = counts[q] > 0 ? static_cast<float>(sumY[q] / counts[q]) : midY;
+        child.begin = offsets[q];
+        child.end = offsets[q] + counts[q];
+        child.firstChild = -1;
+        nodes.push_back(child);
+    }
+    nodes[nodeIndex].firstChild = firstChild;
+
+    // Рекурсивно разбиваем непустые квадранты
+    for (int q = 0; q < 4; q++) {
+        if (counts[q] > 0) {
+            subdivide(firstChild + q, depth + 1);
+        }
+    }
+}
+
+// Функция расчёта силы отталкивания, действующей на вершину self
+void QuadTree::accumulateRepulsion(int self, float theta, float k, float& fx, float& fy) const {
+    // Пустое дерево не создаёт сил
+    if (nodes.empty()) return;
+
+    // Позиция вершины, для которой считаем силу
+    float px = posX[self];
+    float py = posY[self];
+    // Квадрат угла раскрытия (сравниваем квадраты, чтобы не считать корень)
+    float theta2 = theta * theta;
+
+    // Стек обхода на стеке вызова: при глубине MAX_DEPTH в нём одновременно
+    // не больше 3 * MAX_DEPTH + 4 узлов, поэтому куча не нужна
+    int stack[4 * MAX_DEPTH + 8];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        // Пустые квадранты пропускаем
+        if (node.count == 0) continue;
+
+        if (node.firstChild < 0) {
+            // Лист - считаем силы от каждой вершины точно
+            for (int idx = node.begin; idx < node.end; idx++) {
+                int j = indices[idx];
+                if (j == self) continue;
+                float dx = posX[j] - px;
+                float dy = posY[j] - py;
+                float distSq = dx * dx + dy * dy;
+                if (distSq < 1.0f) distSq = 1.0f;
+                float dist = std::sqrt(distSq);
+                float force = k / distSq;
+                fx -= (dx / dist) * force;
+                fy -= (dy / dist) * force;
+            }
+            continue;
+        }
+
+        // Вектор до центра масс узла
+        float dx = node.massX - px;
+        float dy = node.massY - py;
+        float distSq = dx * dx + dy * dy;
+        // Узел, содержащий саму вершину, всегда раскрываем
+        bool inside = px >= node.minX && px < node.minX + node.size &&
+                      py >= node.minY && py < node.minY + node.size;
+
+        if (!inside && node.size * node.size < theta2 * distSq) {
+            // Узел достаточно далеко - заменяем его одной точкой массы count
+            if (distSq < 1.0f) distSq = 1.0f;
+            float dist = std::sqrt(distSq);
+            float force = k * node.count / distSq;
+            fx -= (dx / dist) * force;
+            fy -= (dy / dist) * force;
+        } else {
+            // Узел слишком близко - спускаемся к детям
+            for (int q = 0; q < 4; q++) {
+                stack[top++] = node.firstChild + q;
+            }
+        }
+    }
+}
+
+// Функция возвращает количество узлов дерева
+int QuadTree::getNodeCount() const {
+    return static_cast<int>(nodes.size());
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Класс QuadTree - квадродерево для приближённого расчёта сил отталкивания
+ * (алгоритм Barnes-Hut). Не зависит от RayLib.
+ *
+ * Каждый узел хранит центр масс и количество вершин своей области.
+ * Далёкие группы вершин заменяются одной "тяжёлой" точкой в центре масс,
+ * поэтому расчёт отталкивания для одной вершины стоит O(log n) вместо O(n).
+ */
+class QuadTree {
+private:
+    /**
+     * Узел дерева. Узел покрывает диапазон [begin, end) массива индексов
+     */
+    struct Node {
+        float minX, minY;     // Левый верхний угол квадрата узла
+        float size;           // Сторона квадрата узла
+        float massX, massY;   // Центр масс вершин узла
+        int count;            // Количество вершин в узле (масса)
+        int begin, end;       // Диапазон вершин в массиве indices
+        int firstChild;       // Индекс первого из 4 детей (-1 для листа)
+    };
+
+    std::vector<Node> nodes;        // Все узлы дерева (корень - nodes[0])
+    std::vector<int> indices;       // Индексы вершин, упорядоченные по узлам
+    std::vector<int> scratch;       // Буфер для разбиения индексов по квадрантам
+    const float* posX;              // Координаты X вершин (не владеем)
+    const float* posY;              // Координаты Y вершин (не владеем)
+
+    /**
+     * Рекурсивно разбить узел на 4 квадранта
+     * @param nodeIndex - индекс узла в nodes
+     * @param depth - глубина узла
+     */
+    void subdivide(int nodeIndex, int depth);
+
+public:
+    /**
+     * Максимальное количество вершин в листе
+     */
+    static const int LEAF_CAPACITY = 8;
+
+    /**
+     * Максимальная глубина дерева (защита от совпадающих вершин)
+     */
+    static const int MAX_DEPTH = 32;
+
+    QuadTree();
+
+    /**
+     * Построить дерево по координатам вершин
+     * Массивы должны оставаться живыми до следующего вызова build()
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     */
+    void build(const std::vector<float>& x, const std::vector<float>& y);
+
+    /**
+     * Рассчитать суммарную силу отталкивания, действующую на вершину
+     * Формула совпадает с точным расчётом: F = k * m / r^2
+     * Метод не изменяет дерево, поэтому его можно вызывать из нескольких потоков
+     * @param self - индекс вершины
+     * @param theta - угол раскрытия (0 - точный расчёт, больше - грубее и быстрее)
+     * @param k - коэффициент силы отталкивания
+     * @param fx - накопитель силы по X
+     * @param fy - накопитель силы по Y
+     */
+    void accumulateRepulsion(int self, float theta, float k, float& fx, float& fy) const;
+
+    /**
+     * Получить количество узлов дерева
+     * @return количество узлов
+     */
+    int getNodeCount() const;
+};
@@ -0,0 +1,161 @@
+// Подключаем заголовочный файл равномерной сетки
+#include "SpatialGrid.h"
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+// Подключаем математические функции (sqrt, floor)
+#include <cmath>
+
+// Конструктор пустой сетки
+SpatialGrid::SpatialGrid() : cellSize(1.0f), originX(0), originY(0), cols(0), rows(0) {}
+
+// Функция построения сетки по координатам вершин
+void SpatialGrid::build(const std::vector<float>& x, const std::vector<float>& y, float size) {
+    int n = static_cast<int>(x.size());
+    cols = rows = 0;
+    cellStart.assign(1, 0);
+    if (n == 0) return;
+
+    // Ограничивающий прямоугольник вершин
+    float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (int i = 1; i < n; i++) {
+        minX = std::min(minX, x[i]);
+        maxX = std::max(maxX, x[i]);
+        minY = std::min(minY, y[i]);
+        maxY = std::max(maxY, y[i]);
+    }
+
+    // Подбираем размер ячейки: не меньше заданного и так,
+    // чтобы ячеек было не больше MAX_CELLS_PER_VERTEX * n
+    cellSize = std::max(size, 1.0f);
+    double maxCells = static_cast<double>(MAX_CELLS_PER_VERTEX) * n + 16;
+    double area = static_cast<double>(maxX - minX + cellSize) * (maxY - minY + cellSize);
+    if (area / (static_cast<double>(cellSize) * cellSize) > maxCells) {
+        cellSize = static_cast<float>(std::sqrt(area / maxCells));
+    }
+    originX = minX;
+    originY = minY;
+    cols = static_cast<int>((maxX - minX) / cellSize) + 1;
+    rows = static_cast<int>((maxY - minY) / cellSize) + 1;
+
+    // Считаем количество вершин в каждой ячейке
+    vertexCell.resize(n);
+    cellStart.assign(static_cast<size_t>(cols) * rows + 1, 0);
+    for (int i = 0; i < n; i++) {
+        int cx = std::min(cols - 1, static_cast<int>((x[i] - originX) / cellSize));
+        int cy = std::min(rows - 1, static_cast<int>((y[i] - originY) / cellSize));
+        vertexCell[i] = cy * cols + cx;
+        cellStart[vertexCell[i] + 1]++;
+    }
+    // Префиксные суммы - начала ячеек
+    for (size_t c = 1; c < cellStart.size(); c++) {
+        cellStart[c] += cellStart[c - 1];
+    }
+
+    // Раскладываем вершины и их координаты в порядке ячеек
+    sortedIndex.resize(n);
+    sortedX.resize(n);
+    sortedY.resize(n);
+    std::vector<int> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < n; i++) {
+        int slot = cursor[vertexCell[i]]++;
+        sortedIndex[slot] = i;
+        sortedX[slot] = x[i];
+        sortedY[slot] = y[i];
+    }
+}
+
+// Функция расчёта отталкивания от вершин в радиусе cutoff
+void SpatialGrid::accumulateRepulsion(int self, float cutoff, float k, float& fx, float& fy) const {
+    if (cols == 0) return;
+
+    // Позиция вершины и её ячейка
+    int cell = vertexCell[self];
+    int cx = cell % cols;
+    int cy = cell / cols;
+    float px = 0, py = 0;
+    for (int s = cellStart[cell]; s < cellStart[cell + 1]; s++) {
+        if (sortedIndex[s] == self) {
+            px = sortedX[s];
+            py = sortedY[s];
+            break;
+        }
+    }
+
+    // Сколько ячеек в каждую сторону покрывает радиус отсечения
+    int reach = static_cast<int>(std::ceil(cutoff / cellSize));
+    float cutoffSq = cutoff * cutoff;
+
+    for (int gy = std::max(0, cy - reach); gy <= std::min(rows - 1, cy + reach); gy++) {
+        // Вершины соседних по X ячеек одной строки лежат подряд
+        int rowBegin = cellStart[gy * cols + std::max(0, cx - reach)];
+        int rowEnd = cellStart[gy * cols + std::min(cols - 1, cx + reach) + 1];
+        for (int s = rowBegin; s < rowEnd; s++) {
+            float dx = sortedX[s] - px;
+            float dy = sortedY[s] - py;
+            float distSq = dx * dx + dy * dy;
+            // Дальние вершины и сама вершина не учитываются
+            if (distSq > cutoffSq || sortedIndex[s] == self) continue;
+            if (distSq < 1.0f) distSq = 1.0f;
+            float dist = std::sqrt(distSq);
+            float force = k / distSq;
+            fx -= (dx / dist) * force;
+            fy -= (dy / dist) * force;
+        }
+    }
+}
+
+// Функция сбора вершин в прямоугольнике
+void SpatialGrid::queryRect(float minX, float minY, float maxX, float maxY, std::vector<int>& out) const {
+    if (cols == 0 || maxX < minX || maxY < minY) return;
+
+    // Диапазон ячеек, пересекающих прямоугольник (ограничиваем до перевода в int,
+    // чтобы далёкий прямоугольник не переполнил номер ячейки)
+    float fx0 = std::max(0.0f, std::floor((minX - originX) / cellSize));
+    float fy0 = std::max(0.0f, std::floor((minY - originY) / cellSize));
+    float fx1 = std::min(cols - 1.0f, std::floor((maxX - originX) / cellSize));
+    float fy1 = std::min(rows - 1.0f, std::floor((maxY - originY) / cellSize));
+    if (fx0 > fx1 || fy0 > fy1) return;
+    int cx0 = static_cast<int>(fx0), cy0 = static_cast<int>(fy0);
+    int cx1 = static_cast<int>(fx1), cy1 = static_cast<int>(fy1);
+
+    for (int gy = cy0; gy <= cy1; gy++) {
+        // Вершины соседних по X ячеек одной строки лежат подряд
+        int rowBegin = cellStart[gy * cols + cx0];
+        int rowEnd = cellStart[gy * cols + cx1 + 1];
+        for (int s = rowBegin; s < rowEnd; s++) {
+            if (sortedX[s] >= minX && sortedX[s] <= maxX && sortedY[s] >= minY && sortedY[s] <= maxY) {
+                out.push_back(sortedIndex[s]);
+            }
+        }
+    }
+}
+
+// Функция возвращает количество вершин в ячейке
+int SpatialGrid::getCellCount(int cell) const {
+    return cellStart[cell + 1] - cellStart[cell];
+}
+
+// Функция возвращает фактическую сторону ячейки
+float SpatialGrid::getCellSize() const {
+    return cellSize;
+}
+
+// Функция возвращает количество столбцов сетки
+int SpatialGrid::getCols() const {
+    return cols;
+}
+
+// Функция возвращает количество строк сетки
+int SpatialGrid::getRows() const {
+    return rows;
+}
+
+// Функция возвращает X левого верхнего угла сетки
+float SpatialGrid::getOriginX() const {
+    return originX;
+}
+
+// Функция возвращает Y левого верхнего угла сетки
+float SpatialGrid::getOriginY() const {
+    return originY;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Класс SpatialGrid - равномерная сетка (spatial hash) над позициями вершин
+ * Не зависит от RayLib.
+ *
+ * Вершины раскладываются по квадратным ячейкам (сортировка подсчётом),
+ * координаты копируются в порядке ячеек, поэтому перебор соседних ячеек
+ * идёт по непрерывной памяти. Используется для приближённого расчёта
+ * отталкивания с отсечением по расстоянию (вариант Fruchterman-Reingold
+ * с сеткой): вершина отталкивается только от вершин соседних ячеек.
+ */
+class SpatialGrid {
+private:
+    float cellSize;                  // Сторона ячейки
+    float originX, originY;          // Левый верхний угол сетки
+    int cols, rows;                  // Размер сетки в ячейках
+    std::vector<int> cellStart;      // Начало ячейки в массивах ниже (cols * rows + 1)
+    std::vector<int> sortedIndex;    // Номера вершин в порядке ячеек
+    std::vector<float> sortedX;      // X-координаты в порядке ячеек
+    std::vector<float> sortedY;      // Y-координаты в порядке ячеек
+    std::vector<int> vertexCell;     // Ячейка каждой вершины
+
+public:
+    /**
+     * Максимальное отношение числа ячеек к числу вершин
+     * (если вершины разлетелись далеко, ячейки укрупняются)
+     */
+    static const int MAX_CELLS_PER_VERTEX = 4;
+
+    SpatialGrid();
+
+    /**
+     * Построить сетку по координатам вершин
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     * @param size - желаемая сторона ячейки (может быть увеличена)
+     */
+    void build(const std::vector<float>& x, const std::vector<float>& y, float size);
+
+    /**
+     * Рассчитать силу отталкивания на вершину от вершин ближе cutoff
+     * Перебираются только ячейки, пересекающие круг радиуса cutoff.
+     * Формула совпадает с точным расчётом: F = k / r^2
+     * Метод не изменяет сетку, поэтому его можно вызывать из нескольких потоков
+     * @param self - индекс вершины
+     * @param cutoff - радиус отсечения
+     * @param k - коэффициент силы отталкивания
+     * @param fx - накопитель силы по X
+     * @param fy - накопитель силы по Y
+     */
+    void accumulateRepulsion(int self, float cutoff, float k, float& fx, float& fy) const;
+
+    /**
+     * Собрать вершины, лежащие в прямоугольнике
+     * Перебираются только ячейки, пересекающие прямоугольник
+     * @param minX, minY - левый верхний угол
+     * @param maxX, maxY - правый нижний угол
+     * @param out - номера вершин добавляются в конец
+     */
+    void queryRect(float minX, float minY, float maxX, float maxY, std::vector<int>& out) const;
+
+    /**
+     * Получить количество вершин в ячейке
+     * @param cell - номер ячейки (строка * getCols() + столбец)
+     * @return количество вершин
+     */
+    int getCellCount(int cell) const;
+
+    /**
+     * Получить фактическую сторону ячейки
+     * @return сторона ячейки
+     */
+    float getCellSize() const;
+
+    /**
+     * Получить размер сетки и положение её левого верхнего угла
+     */
+    int getCols() const;
+    int getRows() const;
+    float getOriginX() const;
+    float getOriginY() const;
+};
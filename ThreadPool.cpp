@@ -0,0 +1,177 @@
+// Подключаем заголовочный файл пула потоков
+#include "ThreadPool.h"
+// Подключаем библиотеку для алгоритмов (min, max)
+#include <algorithm>
+
+// Признак того, что текущий поток выполняет тело параллельного цикла
+// (вложенные вызовы parallelFor выполняются последовательно)
+static thread_local bool insideParallelFor = false;
+
+// Конструктор - запускаем threadCount - 1 рабочих потоков
+// (вызывающий поток сам участвует в каждом цикле)
+ThreadPool::ThreadPool(int threadCount)
+    : task(nullptr), jobBegin(0), jobEnd(0), jobGrain(1), generation(0), activeWorkers(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    ranges.reset(new WorkRange[threadCount]);
+    for (int i = 0; i < threadCount; i++) {
+        ranges[i].bounds.store(0);
+    }
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Деструктор - будим потоки и ждём их завершения
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Функция возвращает количество потоков вместе с вызывающим
+int ThreadPool::getThreadCount() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+// Главная функция рабочего потока: ждём задание, выполняем, сообщаем о завершении
+void ThreadPool::workerLoop(int worker) {
+    uint64_t seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorkers.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+
+        insideParallelFor = true;
+        runChunks(worker);
+        insideParallelFor = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--activeWorkers == 0) {
+                jobFinished.notify_one();
+            }
+        }
+    }
+}
+
+// Упаковать отрезок порций [first, last) в одно 64-битное слово
+static inline uint64_t packRange(uint64_t first, uint64_t last) {
+    return first | (last << 32);
+}
+
+// Функция получения порции из отрезка потока owner
+bool ThreadPool::takeChunk(int owner, bool fromFront, int64_t& chunk) {
+    std::atomic<uint64_t>& bounds = ranges[owner].bounds;
+    uint64_t current = bounds.load(std::memory_order_relaxed);
+    while (true) {
+        uint64_t first = current & 0xFFFFFFFFu;
+        uint64_t last = current >> 32;
+        if (first >= last) return false;
+        // Владелец забирает первую порцию, вор - последнюю
+        uint64_t updated = fromFront ? packRange(first + 1, last) : packRange(first, last - 1);
+        if (bounds.compare_exchange_weak(current, updated, std::memory_order_acq_rel)) {
+            chunk = static_cast<int64_t>(fromFront ? first : last - 1);
+            return true;
+        }
+    }
+}
+
+// Функция выполнения одной порции
+void ThreadPool::runChunk(int64_t chunk, int worker) {
+    int64_t begin = jobBegin + chunk * jobGrain;
+    (*task)(begin, std::min(begin + jobGrain, jobEnd), worker);
+}
+
+// Функция разбора порций: сначала свой отрезок, затем кража у остальных
+void ThreadPool::runChunks(int worker) {
+    int threadCount = getThreadCount();
+    int64_t chunk;
+    while (takeChunk(worker, true, chunk)) {
+        runChunk(chunk, worker);
+    }
+    // Свои порции кончились - обходим остальных потоков по кругу;
+    // порции новых отрезков не появляются, поэтому одного пустого
+    // круга достаточно для завершения
+    bool stolen = true;
+    while (stolen) {
+        stolen = false;
+        for (int offset = 1; offset < threadCount; offset++) {
+            int victim = (worker + offset) % threadCount;
+            while (takeChunk(victim, false, chunk)) {
+                runChunk(chunk, worker);
+                stolen = true;
+            }
+        }
+    }
+}
+
+// Функция параллельного цикла
+void ThreadPool::parallelFor(int64_t begin, int64_t end, int64_t grain, const RangeTask& body) {
+    if (end <= begin) return;
+    grain = std::max<int64_t>(1, grain);
+    // Номера порций должны помещаться в 32 бита
+    grain = std::max<int64_t>(grain, (end - begin) / 0xFFFFFFFFLL + 1);
+
+    // Один поток, вложенный вызов или работа на одну порцию - без синхронизации
+    if (workers.empty() || insideParallelFor || end - begin <= grain) {
+        body(begin, end, 0);
+        return;
+    }
+
+    // Одновременно в пуле выполняется только одно задание
+    std::lock_guard<std::mutex> submit(submitMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &body;
+        jobBegin = begin;
+        jobEnd = end;
+        jobGrain = grain;
+        // Делим порции на равные непрерывные отрезки по потокам
+        int threadCount = getThreadCount();
+        int64_t chunkCount = (end - begin + grain - 1) / grain;
+        for (int i = 0; i < threadCount; i++) {
+            uint64_t first = static_cast<uint64_t>(chunkCount * i / threadCount);
+            uint64_t last = static_cast<uint64_t>(chunkCount * (i + 1) / threadCount);
+            ranges[i].bounds.store(packRange(first, last), std::memory_order_relaxed);
+        }
+        activeWorkers = static_cast<int>(workers.size());
+        generation++;
+    }
+    wakeWorkers.notify_all();
+
+    // Вызывающий поток работает как поток номер 0
+    insideParallelFor = true;
+    runChunks(0);
+    insideParallelFor = false;
+
+    // Ждём, пока все рабочие потоки закончат свои порции
+    std::unique_lock<std::mutex> lock(mutex);
+    jobFinished.wait(lock, [&]() { return activeWorkers == 0; });
+    task = nullptr;
+}
+
+// Функция возвращает общий пул на все ядра
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(0);
+    return pool;
+}
+
+// Функция выбора пула под заданное количество потоков
+ThreadPool& ThreadPool::select(int numThreads, std::unique_ptr<ThreadPool>& holder) {
+    ThreadPool& common = shared();
+    if (numThreads <= 0 || numThreads == common.getThreadCount()) {
+        return common;
+    }
+    holder.reset(new ThreadPool(numThreads));
+    return *holder;
+}
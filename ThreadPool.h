@@ -0,0 +1,136 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Класс ThreadPool - пул постоянных потоков для параллельных циклов
+ * Потоки создаются один раз и ждут работу, поэтому параллельный цикл
+ * можно запускать много раз подряд (например, на каждом уровне BFS)
+ * без затрат на создание потоков.
+ *
+ * Порции распределяются с кражей работы (work stealing): каждый поток
+ * получает свой непрерывный отрезок порций и берёт их с начала, а
+ * освободившийся поток забирает порции с конца чужого отрезка. Так
+ * соседние порции обрабатываются одним потоком, а неравномерная
+ * нагрузка (например, строки разной стоимости) всё равно выравнивается.
+ */
+class ThreadPool {
+public:
+    /**
+     * Тело параллельного цикла: обработать диапазон [begin, end)
+     * worker - номер потока от 0 до getThreadCount() - 1
+     * (удобно для буферов "на поток")
+     */
+    typedef std::function<void(int64_t begin, int64_t end, int worker)> RangeTask;
+
+private:
+    std::vector<std::thread> workers;      // Рабочие потоки (без вызывающего)
+    std::mutex mutex;                      // Защита состояния задания
+    std::condition_variable wakeWorkers;   // Сигнал о новом задании
+    std::condition_variable jobFinished;   // Сигнал о завершении задания
+    std::mutex submitMutex;                // Одно задание за раз
+
+    /**
+     * Отрезок порций одного потока: в 64-битном слове упакованы номер первой
+     * (младшие 32 бита) и номер после последней (старшие 32 бита) порции.
+     * Владелец сдвигает начало, воры - конец; оба через CAS.
+     * Выравнивание на кэш-линию убирает ложное разделение между потоками.
+     */
+    struct alignas(64) WorkRange {
+        std::atomic<uint64_t> bounds;
+    };
+
+    // Текущее задание
+    const RangeTask* task;                 // Тело цикла
+    int64_t jobBegin;                      // Начало диапазона
+    int64_t jobEnd;                        // Конец диапазона
+    int64_t jobGrain;                      // Размер порции
+    std::unique_ptr<WorkRange[]> ranges;   // Отрезки порций потоков
+    uint64_t generation;                   // Номер задания (для пробуждения)
+    int activeWorkers;                     // Сколько потоков ещё работают
+    bool stopping;                         // Пул уничтожается
+
+    /**
+     * Главная функция рабочего потока
+     * @param worker - номер потока
+     */
+    void workerLoop(int worker);
+
+    /**
+     * Разбирать порции текущего задания, пока они не кончатся
+     * (сначала свои, затем украденные у других потоков)
+     * @param worker - номер потока
+     */
+    void runChunks(int worker);
+
+    /**
+     * Взять порцию из отрезка потока
+     * @param owner - номер потока, чей отрезок используется
+     * @param fromFront - true для владельца (с начала), false для вора (с конца)
+     * @param chunk - номер полученной порции
+     * @return true если порция получена, false если отрезок пуст
+     */
+    bool takeChunk(int owner, bool fromFront, int64_t& chunk);
+
+    /**
+     * Выполнить тело цикла для одной порции
+     * @param chunk - номер порции
+     * @param worker - номер потока
+     */
+    void runChunk(int64_t chunk, int worker);
+
+public:
+    /**
+     * Создать пул
+     * @param threadCount - общее количество потоков с учётом вызывающего
+     *                      (0 - по числу ядер)
+     */
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Получить количество потоков (вместе с вызывающим)
+     * @return количество потоков
+     */
+    int getThreadCount() const;
+
+    /**
+     * Выполнить параллельный цикл по диапазону [begin, end)
+     * Диапазон делится на порции по grain элементов; каждый поток начинает
+     * со своего отрезка порций и по мере освобождения крадёт чужие.
+     * Вызывающий поток тоже работает.
+     * Функция возвращается, когда обработан весь диапазон.
+     * Вызов изнутри тела цикла выполняется последовательно.
+     * @param begin - начало диапазона
+     * @param end - конец диапазона
+     * @param grain - размер порции (не меньше 1)
+     * @param body - тело цикла
+     */
+    void parallelFor(int64_t begin, int64_t end, int64_t grain, const RangeTask& body);
+
+    /**
+     * Общий пул на все ядра машины (создаётся при первом обращении)
+     * @return ссылка на общий пул
+     */
+    static ThreadPool& shared();
+
+    /**
+     * Выбрать пул для алгоритма с заданным количеством потоков:
+     * общий пул, если numThreads <= 0 или совпадает с его размером,
+     * иначе - новый пул, которым владеет holder
+     * @param numThreads - желаемое количество потоков
+     * @param holder - владелец собственного пула (живёт у вызывающего)
+     * @return ссылка на выбранный пул
+     */
+    static ThreadPool& select(int numThreads, std::unique_ptr<ThreadPool>& holder);
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "ArrayView.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * Класс TraversalContext - переиспользуемая рабочая память обходов графа
+ * (см. перегрузки Graph::depthFirstSearch / breadthFirstSearch /
+ * getConnectedComponents с контекстом)
+ *
+ * Посещённые вершины отмечаются номером обхода (эпохой): новый обход
+ * увеличивает эпоху, и старые отметки перестают совпадать с ней, поэтому
+ * массив отметок не очищается между обходами. Стек, порядок обхода и
+ * разметка компонент - плоские векторы, которые только очищаются
+ * (память сохраняется). После первого обхода графа повторные обходы
+ * не выделяют память.
+ *
+ * Контекст не потокобезопасен: один контекст - один поток.
+ */
+class TraversalContext {
+private:
+    std::vector<uint32_t> marks;            // Эпоха последнего посещения вершины
+    uint32_t epoch;                         // Номер текущего обхода
+    std::vector<int> stack;                 // Стек DFS (путь от стартовой вершины)
+    std::vector<size_t> cursors;            // Следующий сосед каждой вершины стека
+    std::vector<int> order;                 // Результат обхода (для BFS - ещё и очередь)
+    std::vector<int> componentStart;        // Начала компонент в componentVertices (k + 1)
+    std::vector<int> componentVertices;     // Вершины всех компонент подряд
+
+    friend class Graph;
+
+public:
+    TraversalContext() : epoch(0) {}
+
+    /**
+     * Создать контекст с заранее выделенной памятью
+     * @param numVertices - количество вершин графа
+     */
+    explicit TraversalContext(int numVertices) : epoch(0) {
+        reserve(numVertices);
+    }
+
+    /**
+     * Начать новый обход графа с numVertices вершинами
+     * (begin / visit / isVisited - для алгоритмов обхода)
+     * @param numVertices - количество вершин
+     */
+    void begin(int numVertices) {
+        if (marks.size() < static_cast<size_t>(numVertices)) {
+            marks.resize(numVertices, 0);
+        }
+        // Раз в 2^32 обходов эпоха переполняется - тогда отметки стираются
+        if (++epoch == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+        stack.clear();
+        cursors.clear();
+        order.clear();
+    }
+
+    /**
+     * Отметить вершину посещённой
+     * @param vertex - вершина
+     * @return true если вершина в этом обходе ещё не была отмечена
+     */
+    bool visit(int vertex) {
+        if (marks[vertex] == epoch) return false;
+        marks[vertex] = epoch;
+        return true;
+    }
+
+    /**
+     * Проверить, посещена ли вершина текущим (последним) обходом
+     * @param vertex - вершина (после хотя бы одного обхода)
+     * @return true если вершина достижима из стартовой
+     */
+    bool isVisited(int vertex) const {
+        return marks[vertex] == epoch;
+    }
+
+    /**
+     * Заранее выделить память под граф с numVertices вершинами
+     * (иначе память выделяется при первом обходе)
+     * @param numVertices - количество вершин
+     */
+    void reserve(int numVertices) {
+        if (marks.size() < static_cast<size_t>(numVertices)) {
+            marks.resize(numVertices, 0);
+        }
+        stack.reserve(numVertices);
+        cursors.reserve(numVertices);
+        order.reserve(numVertices);
+    }
+
+    /**
+     * Получить результат последнего обхода
+     * @return вершины в порядке обхода (действительно до следующего обхода)
+     */
+    const std::vector<int>& getOrder() const {
+        return order;
+    }
+
+    /**
+     * Получить количество компонент, найденных getConnectedComponents
+     * @return количество компонент
+     */
+    int getComponentCount() const {
+        return componentStart.empty() ? 0 : static_cast<int>(componentStart.size()) - 1;
+    }
+
+    /**
+     * Получить вершины компоненты (по возрастанию)
+     * @param component - номер компоненты (0..getComponentCount()-1)
+     * @return представление вершин (действительно до следующего вызова)
+     */
+    ArrayView<int> getComponent(int component) const {
+        return ArrayView<int>(componentVertices.data() + componentStart[component],
+                              static_cast<size_t>(componentStart[component + 1] - componentStart[component]));
+    }
+};
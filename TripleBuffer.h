@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * Шаблон TripleBuffer - передача последнего значения от одного потока-писателя
+ * одному потоку-читателю без блокировок.
+ *
+ * Три экземпляра T: писатель заполняет свой (back), читатель читает свой
+ * (front), третий (middle) - последний опубликованный. Публикация и чтение
+ * обмениваются с middle одной атомарной операцией exchange, поэтому ни одна
+ * сторона никогда не ждёт другую: писатель может публиковать чаще, чем
+ * читатель забирает (промежуточные значения пропускаются), а читатель
+ * всегда видит целиком записанное значение.
+ * Память экземпляров переиспользуется, поэтому векторы внутри T после
+ * первых публикаций больше не выделяются.
+ */
+template <typename T>
+class TripleBuffer {
+private:
+    // В middle младшие биты - номер экземпляра, FRESH - "опубликован и ещё не прочитан"
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;
+
+    T slots[3];
+    alignas(64) std::atomic<int> middle;   // Последний опубликованный экземпляр
+    alignas(64) int back;                  // Экземпляр писателя
+    alignas(64) int front;                 // Экземпляр читателя
+
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * Получить экземпляр для записи (только поток-писатель)
+     * @return экземпляр, который станет видим читателю после publish()
+     */
+    T& writeBuffer() {
+        return slots[back];
+    }
+
+    /**
+     * Опубликовать записанный экземпляр (только поток-писатель)
+     * Писатель получает взамен прежний middle
+     */
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * Забрать последний опубликованный экземпляр, если он новый
+     * (только поток-читатель)
+     * @return true если readBuffer() изменился
+     */
+    bool update() {
+        if ((middle.load(std::memory_order_acquire) & FRESH) == 0) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Получить экземпляр читателя (только поток-читатель)
+     * @return последний забранный update() экземпляр
+     */
+    const T& readBuffer() const {
+        return slots[front];
+    }
+};
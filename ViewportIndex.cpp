@@ -0,0 +1,217 @@
+// Подключаем заголовочный файл индекса области просмотра
+#include "ViewportIndex.h"
+// Подключаем библиотеку для алгоритмов (min, max, fill)
+#include <algorithm>
+// Подключаем математические функции (sqrt, floor)
+#include <cmath>
+
+// Вспомогательные проверки прямоугольников
+namespace {
+
+// Лежит ли точка в прямоугольнике
+inline bool insideRect(float px, float py, float minX, float minY, float maxX, float maxY) {
+    return px >= minX && px <= maxX && py >= minY && py <= maxY;
+}
+
+// Пересекает ли ограничивающий прямоугольник отрезка заданный прямоугольник
+inline bool segmentBoxOverlaps(float ax, float ay, float bx, float by,
+                               float minX, float minY, float maxX, float maxY) {
+    return std::max(ax, bx) >= minX && std::min(ax, bx) <= maxX &&
+           std::max(ay, by) >= minY && std::min(ay, by) <= maxY;
+}
+
+} // namespace
+
+// Конструктор пустого индекса
+ViewportIndex::ViewportIndex() : edgeReach(1.0f), epoch(0), built(false) {}
+
+// Функция построения индекса
+void ViewportIndex::build(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y) {
+    int n = graph.getNumVertices();
+    EdgeView edges = graph.getEdges();
+
+    // Средняя длина ребра задаёт размер ячейки и порог длинных рёбер
+    double totalLength = 0;
+    for (const auto& edge : edges) {
+        float dx = x[edge.second] - x[edge.first];
+        float dy = y[edge.second] - y[edge.first];
+        totalLength += std::sqrt(dx * dx + dy * dy);
+    }
+    float meanLength = edges.empty() ? 1.0f : static_cast<float>(totalLength / edges.size());
+    meanLength = std::max(meanLength, 1.0f);
+    edgeReach = LONG_EDGE_FACTOR * meanLength;
+
+    // Длинные рёбра могут пересекать область просмотра издалека -
+    // их проверяем отдельно
+    longEdges.clear();
+    for (const auto& edge : edges) {
+        float dx = x[edge.second] - x[edge.first];
+        float dy = y[edge.second] - y[edge.first];
+        if (dx * dx + dy * dy > edgeReach * edgeReach) {
+            longEdges.push_back(edge);
+        }
+    }
+
+    // Уровень 0 пирамиды - ячейки сетки вершин
+    grid.build(x, y, meanLength);
+    levels.clear();
+    DensityLevel base;
+    base.cols = grid.getCols();
+    base.rows = grid.getRows();
+    base.cellSize = grid.getCellSize();
+    base.counts.resize(static_cast<size_t>(base.cols) * base.rows);
+    for (size_t c = 0; c < base.counts.size(); c++) {
+        base.counts[c] = grid.getCellCount(static_cast<int>(c));
+    }
+    levels.push_back(std::move(base));
+
+    // Следующие уровни объединяют 2x2 ячейки, пока не останется одна
+    while (levels.back().cols > 1 || levels.back().rows > 1) {
+        const DensityLevel& fine = levels.back();
+        DensityLevel coarse;
+        coarse.cols = (fine.cols + 1) / 2;
+        coarse.rows = (fine.rows + 1) / 2;
+        coarse.cellSize = fine.cellSize * 2;
+        coarse.counts.assign(static_cast<size_t>(coarse.cols) * coarse.rows, 0);
+        for (int cy = 0; cy < fine.rows; cy++) {
+            for (int cx = 0; cx < fine.cols; cx++) {
+                coarse.counts[(cy / 2) * coarse.cols + cx / 2] += fine.counts[cy * fine.cols + cx];
+            }
+        }
+        levels.push_back(std::move(coarse));
+    }
+
+    visibleMark.assign(n, 0);
+    epoch = 0;
+    built = true;
+}
+
+// Функция сбора вершин ячейки пирамиды
+void ViewportIndex::collect(int level, int cx, int cy, float minX, float minY, float maxX, float maxY,
+                            std::vector<int>& out) const {
+    const DensityLevel& current = levels[level];
+    if (cx >= current.cols || cy >= current.rows || current.counts[cy * current.cols + cx] == 0) return;
+
+    // Ячейка не пересекает прямоугольник - её вершины не нужны
+    float cellMinX = grid.getOriginX() + cx * current.cellSize;
+    float cellMinY = grid.getOriginY() + cy * current.cellSize;
+    float cellMaxX = cellMinX + current.cellSize;
+    float cellMaxY = cellMinY + current.cellSize;
+    if (cellMaxX < minX || cellMinX > maxX || cellMaxY < minY || cellMinY > maxY) return;
+
+    if (level == 0) {
+        // Прямоугольник на границе ячейки задевает соседние ячейки -
+        // повторы отбрасываются метками в query
+        grid.queryRect(std::max(minX, cellMinX), std::max(minY, cellMinY),
+                       std::min(maxX, cellMaxX), std::min(maxY, cellMaxY), out);
+        return;
+    }
+    for (int dy = 0; dy < 2; dy++) {
+        for (int dx = 0; dx < 2; dx++) {
+            collect(level - 1, 2 * cx + dx, 2 * cy + dy, minX, minY, maxX, maxY, out);
+        }
+    }
+}
+
+// Функция поиска видимой части графа
+void ViewportIndex::query(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y,
+                          float minX, float minY, float maxX, float maxY, float margin, float pixelsPerUnit,
+                          VisibleSet& out) {
+    out.clear();
+    if (!built || levels.empty() || levels[0].counts.empty()) return;
+
+    // Новый номер запроса (при переполнении метки обнуляются)
+    if (++epoch == 0) {
+        std::fill(visibleMark.begin(), visibleMark.end(), 0);
+        epoch = 1;
+    }
+
+    // Область, в которой рисуются вершины (с запасом на радиус и подпись)
+    float viewMinX = minX - margin, viewMinY = minY - margin;
+    float viewMaxX = maxX + margin, viewMaxY = maxY + margin;
+    // Область кандидатов: короткое ребро, пересекающее экран,
+    // имеет хотя бы один конец не дальше edgeReach от экрана
+    float reachMinX = viewMinX - edgeReach, reachMinY = viewMinY - edgeReach;
+    float reachMaxX = viewMaxX + edgeReach, reachMaxY = viewMaxY + edgeReach;
+
+    // Уровень пирамиды, ячейка которого на экране не меньше TILE_PIXELS
+    float tileSize = TILE_PIXELS / pixelsPerUnit;
+    int level = 0;
+    while (level + 1 < static_cast<int>(levels.size()) && levels[level].cellSize < tileSize) level++;
+    const DensityLevel& current = levels[level];
+    float cellPixels = current.cellSize * pixelsPerUnit;
+    out.denseLimit = std::max(1, static_cast<int>(cellPixels * cellPixels / DENSE_PIXELS_PER_VERTEX));
+
+    // Диапазон ячеек уровня, пересекающих область кандидатов
+    float originX = grid.getOriginX(), originY = grid.getOriginY();
+    float fx0 = std::max(0.0f, std::floor((reachMinX - originX) / current.cellSize));
+    float fy0 = std::max(0.0f, std::floor((reachMinY - originY) / current.cellSize));
+    float fx1 = std::min(current.cols - 1.0f, std::floor((reachMaxX - originX) / current.cellSize));
+    float fy1 = std::min(current.rows - 1.0f, std::floor((reachMaxY - originY) / current.cellSize));
+    if (fx0 > fx1 || fy0 > fy1) return;
+
+    // Плотные ячейки становятся плитками, из остальных собираем кандидатов
+    std::vector<int> candidates;
+    for (int cy = static_cast<int>(fy0); cy <= static_cast<int>(fy1); cy++) {
+        for (int cx = static_cast<int>(fx0); cx <= static_cast<int>(fx1); cx++) {
+            int count = current.counts[cy * current.cols + cx];
+            if (count == 0) continue;
+            if (count > out.denseLimit) {
+                DensityTile tile = {originX + cx * current.cellSize, originY + cy * current.cellSize,
+                                    current.cellSize, count};
+                // Плитки за краем экрана не рисуются
+                if (segmentBoxOverlaps(tile.x, tile.y, tile.x + tile.size, tile.y + tile.size,
+                                       viewMinX, viewMinY, viewMaxX, viewMaxY)) {
+                    out.tiles.push_back(tile);
+                }
+                continue;
+            }
+            collect(level, cx, cy, reachMinX, reachMinY, reachMaxX, reachMaxY, candidates);
+        }
+    }
+
+    // Отмечаем кандидатов (повторы с границ ячеек удаляются),
+    // рисуем только вершины в области просмотра
+    size_t unique = 0;
+    for (int v : candidates) {
+        if (visibleMark[v] == epoch) continue;
+        visibleMark[v] = epoch;
+        candidates[unique++] = v;
+        if (insideRect(x[v], y[v], viewMinX, viewMinY, viewMaxX, viewMaxY)) {
+            out.vertices.push_back(v);
+        }
+    }
+    candidates.resize(unique);
+
+    // Рёбра кандидатов: второй конец - тоже кандидат (ребро берётся один раз),
+    // лежит в плотной плитке (ребро пропускается) или далеко от экрана
+    for (int u : candidates) {
+        for (int v : graph.getAdjList(u)) {
+            if (visibleMark[v] == epoch) {
+                if (v < u) continue;
+            } else if (insideRect(x[v], y[v], reachMinX, reachMinY, reachMaxX, reachMaxY)) {
+                continue;
+            }
+            if (segmentBoxOverlaps(x[u], y[u], x[v], y[v], viewMinX, viewMinY, viewMaxX, viewMaxY)) {
+                out.edges.push_back({u, v});
+            }
+        }
+    }
+
+    // Длинные рёбра, оба конца которых далеко от экрана
+    for (const auto& edge : longEdges) {
+        int u = edge.first, v = edge.second;
+        if (insideRect(x[u], y[u], reachMinX, reachMinY, reachMaxX, reachMaxY) ||
+            insideRect(x[v], y[v], reachMinX, reachMinY, reachMaxX, reachMaxY)) {
+            continue;
+        }
+        if (segmentBoxOverlaps(x[u], y[u], x[v], y[v], viewMinX, viewMinY, viewMaxX, viewMaxY)) {
+            out.edges.push_back(edge);
+        }
+    }
+}
+
+// Функция проверки построения индекса
+bool ViewportIndex::isBuilt() const {
+    return built;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Graph.h"
+#include "SpatialGrid.h"
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * Плитка плотности: область, в которой вершин слишком много,
+ * чтобы рисовать их по отдельности
+ */
+struct DensityTile {
+    float x, y;      // Левый верхний угол
+    float size;      // Сторона квадрата
+    int count;       // Количество вершин в плитке
+};
+
+/**
+ * Видимая часть графа для одного положения камеры
+ */
+struct VisibleSet {
+    std::vector<int> vertices;                    // Вершины, рисуемые по отдельности
+    std::vector<std::pair<int, int>> edges;       // Рёбра, пересекающие область просмотра
+    std::vector<DensityTile> tiles;               // Плотные области (вместо их вершин и рёбер)
+    int denseLimit;                               // Порог вершин в плитке (для яркости плиток)
+
+    VisibleSet() : denseLimit(1) {}
+
+    void clear() {
+        vertices.clear();
+        edges.clear();
+        tiles.clear();
+    }
+
+    /**
+     * Насыщенность цвета плитки (окно и экспорт картинок рисуют одинаково)
+     * @param tile - плитка
+     * @return от 0 (порог плотности) до 1 (в 4 раза плотнее порога)
+     */
+    float tileDensity(const DensityTile& tile) const {
+        return std::min(1.0f, static_cast<float>(tile.count) / (4.0f * denseLimit));
+    }
+};
+
+/**
+ * Класс ViewportIndex - пространственный индекс раскладки для отсечения
+ * невидимых вершин и рёбер. Не зависит от RayLib.
+ *
+ * Вершины раскладываются по равномерной сетке (SpatialGrid), над ней
+ * строится пирамида количеств вершин (каждый уровень объединяет 2x2
+ * ячейки предыдущего). Запрос области просмотра идёт по уровню пирамиды,
+ * ячейка которого на экране не меньше TILE_PIXELS: ячейки с числом вершин
+ * больше порога становятся плитками плотности, из остальных вершины
+ * собираются спуском по пирамиде (пустые ячейки пропускаются).
+ * Рёбра находятся через списки смежности видимых вершин; рёбра длиннее
+ * нескольких средних длин хранятся отдельным списком и проверяются
+ * пересечением прямоугольников. Поэтому стоимость запроса зависит от
+ * видимой части графа, а не от его размера.
+ */
+class ViewportIndex {
+private:
+    // Уровень пирамиды количеств вершин
+    struct DensityLevel {
+        int cols, rows;              // Размер уровня в ячейках
+        float cellSize;              // Сторона ячейки
+        std::vector<int> counts;     // Количество вершин в ячейках
+    };
+
+    SpatialGrid grid;                            // Сетка вершин (уровень 0)
+    std::vector<DensityLevel> levels;            // Пирамида количеств вершин
+    std::vector<std::pair<int, int>> longEdges;  // Рёбра длиннее edgeReach
+    float edgeReach;                             // Максимальная длина "короткого" ребра
+    std::vector<uint32_t> visibleMark;           // Метки вершин, попавших в запрос
+    uint32_t epoch;                              // Номер текущего запроса для меток
+    bool built;
+
+    /**
+     * Собрать вершины ячейки пирамиды, лежащие в прямоугольнике
+     * (рекурсивный спуск, пустые ячейки пропускаются)
+     */
+    void collect(int level, int cx, int cy, float minX, float minY, float maxX, float maxY,
+                 std::vector<int>& out) const;
+
+public:
+    /**
+     * Размер ячейки плотности на экране в пикселях
+     */
+    static const int TILE_PIXELS = 16;
+
+    /**
+     * Площадь экрана на одну вершину (пикс^2), при которой
+     * область считается плотной (отдельные круги уже неразличимы)
+     */
+    static const int DENSE_PIXELS_PER_VERTEX = 16;
+
+    /**
+     * Ребро длиннее LONG_EDGE_FACTOR средних длин считается длинным
+     */
+    static constexpr float LONG_EDGE_FACTOR = 4.0f;
+
+    ViewportIndex();
+
+    /**
+     * Построить индекс по текущим координатам
+     * @param graph - граф
+     * @param x - координаты X вершин
+     * @param y - координаты Y вершин
+     */
+    void build(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y);
+
+    /**
+     * Найти видимые вершины, рёбра и плотные области
+     * @param graph - граф (тот же, что при build)
+     * @param x - координаты X вершин (те же, что при build)
+     * @param y - координаты Y вершин
+     * @param minX, minY, maxX, maxY - область просмотра в координатах раскладки
+     * @param margin - запас вокруг области (радиус вершины, половина подписи)
+     * @param pixelsPerUnit - масштаб: пикселей экрана на единицу координат
+     * @param out - результат (предыдущее содержимое удаляется)
+     */
+    void query(const Graph& graph, const std::vector<float>& x, const std::vector<float>& y,
+               float minX, float minY, float maxX, float maxY, float margin, float pixelsPerUnit,
+               VisibleSet& out);
+
+    /**
+     * Проверить, построен ли индекс
+     * @return true после build
+     */
+    bool isBuilt() const;
+};
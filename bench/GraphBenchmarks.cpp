@@ -0,0 +1,552 @@
+// Бенчмарки горячих путей Graph и force-directed раскладки (Google Benchmark)
+//
+// Графы строятся генераторами GraphGenerators (Эрдёш-Реньи, Барабаши-Альберт,
+// решётка, полный, цикл, двудольный) с числом рёбер от 1e3 до 1e7.
+// Машиночитаемый результат для отслеживания регрессий:
+//   graph-bench --benchmark_format=json > result.json
+//   graph-bench --benchmark_out=result.json --benchmark_out_format=json
+// Отдельные группы выбираются фильтром, например --benchmark_filter=BFS
+
+// Подключаем библиотеку Google Benchmark
+#include <benchmark/benchmark.h>
+// Подключаем заголовочный файл класса Graph
+#include "Graph.h"
+// Подключаем генераторы синтетических графов
+#include "GraphGenerators.h"
+// Подключаем force-directed раскладку (без RayLib)
+#include "ForceLayout.h"
+// Подключаем библиотеку для записи временного файла
+#include <fstream>
+// Подключаем библиотеку для работы со строками
+#include <string>
+// Подключаем математические функции (sqrt)
+#include <cmath>
+// Подключаем библиотеку для удаления временного файла
+#include <cstdio>
+// Подключаем генератор случайных чисел и shuffle (перемешивание номеров вершин)
+#include <random>
+#include <algorithm>
+
+// Внутренние функции бенчмарков
+namespace {
+
+// Вид синтетического графа (первый аргумент бенчмарков)
+enum GeneratorKind {
+    ERDOS_RENYI,
+    BARABASI_ALBERT,
+    GRID_2D,
+    COMPLETE,
+    CYCLE,
+    BIPARTITE,
+    GENERATOR_KIND_COUNT
+};
+
+// Названия видов графа (метка в отчёте)
+const char* const GENERATOR_NAMES[GENERATOR_KIND_COUNT] = {
+    "erdos_renyi", "barabasi_albert", "grid_2d", "complete", "cycle", "bipartite"
+};
+
+// Средняя степень разреженных случайных графов
+const int SPARSE_DEGREE = 8;
+
+// Размеры графов (количество рёбер)
+const int64_t MIN_EDGES = 1000;
+const int64_t MAX_EDGES = 10000000;
+// Точное отталкивание стоит O(n^2) на шаг - ограничиваем размер
+const int64_t MAX_EXACT_LAYOUT_EDGES = 100000;
+const int64_t MAX_LAYOUT_EDGES = 1000000;
+
+// Функция построения графа заданного вида примерно с targetEdges рёбрами
+GeneratedGraph generate(int kind, int64_t targetEdges) {
+    int side = static_cast<int>(std::sqrt(2.0 * targetEdges));
+    switch (kind) {
+        case ERDOS_RENYI:
+            return GraphGenerators::erdosRenyi(static_cast<int>(targetEdges * 2 / SPARSE_DEGREE), targetEdges);
+        case BARABASI_ALBERT:
+            return GraphGenerators::barabasiAlbert(static_cast<int>(targetEdges * 2 / SPARSE_DEGREE), SPARSE_DEGREE / 2);
+        case GRID_2D: {
+            int rows = static_cast<int>(std::sqrt(targetEdges / 2.0));
+            return GraphGenerators::grid2D(rows, rows);
+        }
+        case COMPLETE:
+            return GraphGenerators::complete(side);
+        case CYCLE:
+            return GraphGenerators::cycle(static_cast<int>(targetEdges));
+        default:
+            return GraphGenerators::bipartite(side, side);
+    }
+}
+
+// Функция возвращает сгенерированный граф (последний результат кэшируется:
+// Google Benchmark вызывает бенчмарк несколько раз с одними аргументами)
+const GeneratedGraph& generatedGraph(int kind, int64_t targetEdges) {
+    static int cachedKind = -1;
+    static int64_t cachedEdges = -1;
+    static GeneratedGraph cached;
+    if (kind != cachedKind || targetEdges != cachedEdges) {
+        cached = GeneratedGraph();  // Сначала освобождаем память прежнего графа
+        cached = generate(kind, targetEdges);
+        cachedKind = kind;
+        cachedEdges = targetEdges;
+    }
+    return cached;
+}
+
+// Функция возвращает замороженный граф (последний результат кэшируется)
+const Graph& frozenGraph(int kind, int64_t targetEdges) {
+    static int cachedKind = -1;
+    static int64_t cachedEdges = -1;
+    static Graph cached(0);
+    if (kind != cachedKind || targetEdges != cachedEdges) {
+        const GeneratedGraph& generated = generatedGraph(kind, targetEdges);
+        cached = Graph(0);
+        cached = Graph::fromEdgeList(generated.numVertices, EdgeView(generated.edges));
+        cachedKind = kind;
+        cachedEdges = targetEdges;
+    }
+    return cached;
+}
+
+// Способы перенумерации (аргумент бенчмарков локальности):
+// 0 - без перенумерации, 1.. - VertexOrdering + 1
+const int ORDERING_COUNT = 5;
+const char* const ORDERING_NAMES[ORDERING_COUNT] = {"none", "rcm", "degree", "bfs", "rabbit"};
+
+// Функция возвращает граф со случайно перемешанными номерами вершин
+// (как во входных файлах: номера не связаны со структурой графа),
+// перенумерованный способом ordering. permutation - перестановка
+// относительно перемешанного графа (для ordering = 0 - пустая)
+const Graph& reorderedGraph(int kind, int64_t targetEdges, int ordering, const VertexPermutation** permutation) {
+    static int cachedKind = -1;
+    static int64_t cachedEdges = -1;
+    static int cachedOrdering = -1;
+    static Graph shuffled(0);
+    static Graph cached(0);
+    static VertexPermutation cachedPermutation;
+    if (kind != cachedKind || targetEdges != cachedEdges) {
+        const GeneratedGraph& generated = generatedGraph(kind, targetEdges);
+        std::vector<int> ids(generated.numVertices);
+        for (int v = 0; v < generated.numVertices; v++) ids[v] = v;
+        std::mt19937 random(1);
+        std::shuffle(ids.begin(), ids.end(), random);
+        std::vector<std::pair<int, int>> edges(generated.edges.size());
+        for (size_t i = 0; i < edges.size(); i++) {
+            edges[i] = std::make_pair(ids[generated.edges[i].first], ids[generated.edges[i].second]);
+        }
+        shuffled = Graph(0);
+        shuffled = Graph::fromEdgeList(generated.numVertices, EdgeView(edges));
+        cachedKind = kind;
+        cachedEdges = targetEdges;
+        cachedOrdering = -1;
+    }
+    if (ordering != cachedOrdering) {
+        cached = Graph(0);
+        cachedPermutation = VertexPermutation();
+        if (ordering > 0) {
+            cachedPermutation = shuffled.computeOrdering(static_cast<VertexOrdering>(ordering - 1));
+            cached = shuffled.relabel(cachedPermutation);
+        }
+        cachedOrdering = ordering;
+    }
+    if (permutation) *permutation = &cachedPermutation;
+    return ordering > 0 ? cached : shuffled;
+}
+
+// Функция записи размеров графа в отчёт
+void reportGraph(benchmark::State& state, int kind, int vertices, int64_t edges) {
+    state.SetLabel(GENERATOR_NAMES[kind]);
+    state.counters["vertices"] = vertices;
+    state.counters["edges"] = static_cast<double>(edges);
+}
+
+// Аргументы: все виды графа x размеры от MIN_EDGES до MAX_EDGES (шаг x10)
+void allKinds(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"kind", "edges"});
+    for (int kind = 0; kind < GENERATOR_KIND_COUNT; kind++) {
+        for (int64_t edges = MIN_EDGES; edges <= MAX_EDGES; edges *= 10) {
+            b->Args({kind, edges});
+        }
+    }
+}
+
+// Аргументы для addEdge: проверка дублей стоит O(степени), поэтому
+// полный и двудольный графы (степени порядка sqrt(E)) ограничены 1e5 рёбрами
+void addEdgeKinds(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"kind", "edges"});
+    for (int kind = 0; kind < GENERATOR_KIND_COUNT; kind++) {
+        int64_t maxEdges = (kind == COMPLETE || kind == BIPARTITE) ? 100000 : MAX_EDGES;
+        for (int64_t edges = MIN_EDGES; edges <= maxEdges; edges *= 10) {
+            b->Args({kind, edges});
+        }
+    }
+}
+
+// Аргументы для шага раскладки: режим отталкивания x размер графа
+// (Эрдёш-Реньи со средней степенью SPARSE_DEGREE)
+void layoutModes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"mode", "edges"});
+    const RepulsionMode modes[] = {RepulsionMode::Exact, RepulsionMode::BarnesHut, RepulsionMode::Grid};
+    for (RepulsionMode mode : modes) {
+        int64_t maxEdges = mode == RepulsionMode::Exact ? MAX_EXACT_LAYOUT_EDGES : MAX_LAYOUT_EDGES;
+        for (int64_t edges = MIN_EDGES; edges <= maxEdges; edges *= 10) {
+            b->Args({static_cast<int64_t>(mode), edges});
+        }
+    }
+}
+
+// Аргументы бенчмарков локальности: способ перенумерации x вид графа x размер
+// (Эрдёш-Реньи, Барабаши-Альберт и решётка от 1e5 до 1e7 рёбер)
+void orderingKinds(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"order", "kind", "edges"});
+    const int kinds[] = {ERDOS_RENYI, BARABASI_ALBERT, GRID_2D};
+    for (int kind : kinds) {
+        for (int64_t edges = 100000; edges <= MAX_EDGES; edges *= 10) {
+            for (int ordering = 0; ordering < ORDERING_COUNT; ordering++) {
+                b->Args({ordering, kind, edges});
+            }
+        }
+    }
+}
+
+// Аргументы шага раскладки после перенумерации: Barnes-Hut и Grid
+// (Барабаши-Альберт до MAX_LAYOUT_EDGES рёбер)
+void orderingLayoutModes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"order", "mode", "edges"});
+    const RepulsionMode modes[] = {RepulsionMode::BarnesHut, RepulsionMode::Grid};
+    for (RepulsionMode mode : modes) {
+        for (int64_t edges = 100000; edges <= MAX_LAYOUT_EDGES; edges *= 10) {
+            for (int ordering = 0; ordering < ORDERING_COUNT; ordering++) {
+                b->Args({ordering, static_cast<int64_t>(mode), edges});
+            }
+        }
+    }
+}
+
+// Аргументы многоуровневой раскладки: количество вершин x потоков
+// (Барабаши-Альберт со средней степенью SPARSE_DEGREE). Цель - 1M вершин
+// меньше чем за минуту - рассчитана на 16 потоков; запуск с одним потоком
+// показывает, сколько работы приходится на ядро
+void multilevelSizes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"vertices", "threads"});
+    b->Args({100000, 1});
+    b->Args({1000000, 1});
+    b->Args({1000000, 4});
+    b->Args({1000000, 16});
+}
+
+} // namespace
+
+// ===== ПОСТРОЕНИЕ ГРАФА =====
+
+// Последовательная вставка addEdge (с проверкой дублей и union-find)
+static void BM_AddEdge(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const GeneratedGraph& generated = generatedGraph(kind, state.range(1));
+    for (auto _ : state) {
+        Graph graph(generated.numVertices);
+        for (const auto& edge : generated.edges) {
+            graph.addEdge(edge.first, edge.second);
+        }
+        benchmark::DoNotOptimize(graph);
+    }
+    reportGraph(state, kind, generated.numVertices, static_cast<int64_t>(generated.edges.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(generated.edges.size()));
+}
+BENCHMARK(BM_AddEdge)->Apply(addEdgeKinds)->Unit(benchmark::kMillisecond);
+
+// Пакетное построение CSR из списка рёбер
+static void BM_FromEdgeList(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const GeneratedGraph& generated = generatedGraph(kind, state.range(1));
+    for (auto _ : state) {
+        Graph graph = Graph::fromEdgeList(generated.numVertices, EdgeView(generated.edges));
+        benchmark::DoNotOptimize(graph);
+    }
+    reportGraph(state, kind, generated.numVertices, static_cast<int64_t>(generated.edges.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(generated.edges.size()));
+}
+BENCHMARK(BM_FromEdgeList)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Загрузка текстового файла (отображение в память и параллельный разбор)
+static void BM_LoadFromFile(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const GeneratedGraph& generated = generatedGraph(kind, state.range(1));
+
+    // Временный файл в формате loadFromFile
+    std::string filename = "graph_bench_" + std::to_string(kind) + "_" + std::to_string(state.range(1)) + ".txt";
+    {
+        std::ofstream file(filename);
+        file << generated.numVertices << "\n";
+        for (const auto& edge : generated.edges) {
+            file << edge.first << " " << edge.second << "\n";
+        }
+    }
+    std::ifstream sizeProbe(filename, std::ios::binary | std::ios::ate);
+    int64_t fileSize = static_cast<int64_t>(sizeProbe.tellg());
+    sizeProbe.close();
+
+    for (auto _ : state) {
+        Graph graph = Graph::loadFromFile(filename);
+        benchmark::DoNotOptimize(graph);
+    }
+    std::remove(filename.c_str());
+
+    reportGraph(state, kind, generated.numVertices, static_cast<int64_t>(generated.edges.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(generated.edges.size()));
+    state.SetBytesProcessed(state.iterations() * fileSize);
+}
+BENCHMARK(BM_LoadFromFile)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// ===== ОБХОДЫ И СВЯЗНОСТЬ =====
+
+// Обход в ширину от вершины 0
+static void BM_BreadthFirstSearch(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    for (auto _ : state) {
+        std::vector<int> order = graph.breadthFirstSearch(0);
+        benchmark::DoNotOptimize(order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_BreadthFirstSearch)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Обход в ширину с переиспользуемым контекстом (без выделения памяти)
+static void BM_BreadthFirstSearchContext(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    TraversalContext context(graph.getNumVertices());
+    for (auto _ : state) {
+        const std::vector<int>& order = graph.breadthFirstSearch(0, context);
+        benchmark::DoNotOptimize(order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_BreadthFirstSearchContext)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Параллельный обход в ширину с переключением направления
+static void BM_ParallelBreadthFirstSearch(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    for (auto _ : state) {
+        BFSResult result = graph.parallelBreadthFirstSearch(0);
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_ParallelBreadthFirstSearch)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Обход в ширину из 64 вершин: одна пачка MS-BFS против 64 отдельных обходов
+// (items - просмотренные рёбра в пересчёте на отдельные обходы)
+static void BM_MultiSourceBreadthFirstSearch(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    std::vector<int> sources(MultiSourceBFSResult::NARROW_BATCH);
+    for (size_t i = 0; i < sources.size(); i++) {
+        sources[i] = static_cast<int>(i * graph.getNumVertices() / sources.size());
+    }
+    for (auto _ : state) {
+        MultiSourceBFSResult result = graph.multiSourceBreadthFirstSearch(sources);
+        benchmark::DoNotOptimize(result.distances.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges * static_cast<int64_t>(sources.size()));
+}
+BENCHMARK(BM_MultiSourceBreadthFirstSearch)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Те же 64 обхода по одному (с переиспользуемым контекстом)
+static void BM_RepeatedBreadthFirstSearch(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    TraversalContext context(graph.getNumVertices());
+    const int count = MultiSourceBFSResult::NARROW_BATCH;
+    for (auto _ : state) {
+        for (int i = 0; i < count; i++) {
+            int source = static_cast<int>(static_cast<int64_t>(i) * graph.getNumVertices() / count);
+            const std::vector<int>& order = graph.breadthFirstSearch(source, context);
+            benchmark::DoNotOptimize(order.data());
+        }
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges * count);
+}
+BENCHMARK(BM_RepeatedBreadthFirstSearch)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Обход в глубину от вершины 0
+static void BM_DepthFirstSearch(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    for (auto _ : state) {
+        std::vector<int> order = graph.depthFirstSearch(0);
+        benchmark::DoNotOptimize(order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_DepthFirstSearch)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Обход в глубину с переиспользуемым контекстом (без выделения памяти)
+static void BM_DepthFirstSearchContext(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    TraversalContext context(graph.getNumVertices());
+    for (auto _ : state) {
+        const std::vector<int>& order = graph.depthFirstSearch(0, context);
+        benchmark::DoNotOptimize(order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_DepthFirstSearchContext)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Компоненты связности (разметка кэшируется в графе, поэтому граф
+// строится заново перед каждым замером, вне измеряемого времени)
+static void BM_ConnectedComponents(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const GeneratedGraph& generated = generatedGraph(kind, state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Graph graph = Graph::fromEdgeList(generated.numVertices, EdgeView(generated.edges));
+        state.ResumeTiming();
+        std::vector<std::vector<int>> components = graph.getConnectedComponents();
+        benchmark::DoNotOptimize(components.data());
+        state.PauseTiming();
+        // Освобождение графа тоже не входит в замер
+        components = std::vector<std::vector<int>>();
+        graph = Graph(0);
+        state.ResumeTiming();
+    }
+    reportGraph(state, kind, generated.numVertices, static_cast<int64_t>(generated.edges.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(generated.edges.size()));
+}
+BENCHMARK(BM_ConnectedComponents)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Точки сочленения, мосты и компоненты двусвязности (итеративный DFS)
+static void BM_BiconnectedComponents(benchmark::State& state) {
+    int kind = static_cast<int>(state.range(0));
+    const Graph& graph = frozenGraph(kind, state.range(1));
+    for (auto _ : state) {
+        BiconnectedComponents components = graph.getBiconnectedComponents();
+        benchmark::DoNotOptimize(components.componentEdges.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_BiconnectedComponents)->Apply(allKinds)->Unit(benchmark::kMillisecond);
+
+// Обход в ширину после перенумерации вершин (исходные номера перемешаны)
+static void BM_ReorderedBreadthFirstSearch(benchmark::State& state) {
+    int ordering = static_cast<int>(state.range(0));
+    int kind = static_cast<int>(state.range(1));
+    const Graph& graph = reorderedGraph(kind, state.range(2), ordering, nullptr);
+    TraversalContext context(graph.getNumVertices());
+    for (auto _ : state) {
+        const std::vector<int>& order = graph.breadthFirstSearch(0, context);
+        benchmark::DoNotOptimize(order.data());
+    }
+    int64_t edges = static_cast<int64_t>(graph.getEdges().size());
+    reportGraph(state, kind, graph.getNumVertices(), edges);
+    state.SetLabel(std::string(GENERATOR_NAMES[kind]) + "/" + ORDERING_NAMES[ordering]);
+    state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(BM_ReorderedBreadthFirstSearch)->Apply(orderingKinds)->Unit(benchmark::kMillisecond);
+
+// ===== РАСКЛАДКА =====
+
+// Один шаг force-directed алгоритма (сравнение Exact / Barnes-Hut / Grid
+// на одних и тех же графах)
+static void BM_LayoutStep(benchmark::State& state) {
+    RepulsionMode mode = static_cast<RepulsionMode>(state.range(0));
+    const Graph& graph = frozenGraph(ERDOS_RENYI, state.range(1));
+    int n = graph.getNumVertices();
+
+    ForceLayout layout(graph);
+    layout.setRepulsionMode(mode);
+    layout.initializeCircle(0.0f, 0.0f, layout.getOptimalDistance() * std::sqrt(static_cast<float>(n)) / 2);
+    // Несколько шагов до замера - вершины уходят с окружности
+    // и распределение становится похожим на рабочее
+    layout.resetCooling();
+    for (int i = 0; i < 5; i++) layout.coolingStep();
+
+    for (auto _ : state) {
+        layout.step();
+        benchmark::DoNotOptimize(layout.getX().data());
+    }
+    const char* modeNames[] = {"exact", "barnes_hut", "grid"};
+    state.SetLabel(modeNames[static_cast<int>(mode)]);
+    state.counters["vertices"] = n;
+    state.counters["edges"] = static_cast<double>(graph.getEdges().size());
+    state.counters["energy"] = layout.getEnergy();
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LayoutStep)->Apply(layoutModes)->Unit(benchmark::kMillisecond);
+
+// Шаг раскладки после перенумерации вершин. Координаты - готовая
+// многоуровневая раскладка перемешанного графа (соседи в графе близки
+// и на плоскости, как в рабочей раскладке), переставленная в новый порядок;
+// она считается один раз на размер графа, вне замера
+static void BM_ReorderedLayoutStep(benchmark::State& state) {
+    int ordering = static_cast<int>(state.range(0));
+    RepulsionMode mode = static_cast<RepulsionMode>(state.range(1));
+    int64_t targetEdges = state.range(2);
+    static int64_t cachedEdges = -1;
+    static std::vector<float> x, y;
+    if (targetEdges != cachedEdges) {
+        const Graph& shuffled = reorderedGraph(BARABASI_ALBERT, targetEdges, 0, nullptr);
+        ForceLayout start(shuffled);
+        start.optimizeMultilevel(5);
+        x = start.getX();
+        y = start.getY();
+        cachedEdges = targetEdges;
+    }
+    const VertexPermutation* permutation = nullptr;
+    const Graph& graph = reorderedGraph(BARABASI_ALBERT, targetEdges, ordering, &permutation);
+    int n = graph.getNumVertices();
+    ForceLayout layout(graph);
+    layout.setRepulsionMode(mode);
+    if (ordering > 0) layout.setPositions(permutation->apply(x), permutation->apply(y));
+    else layout.setPositions(x, y);
+
+    for (auto _ : state) {
+        layout.step();
+        benchmark::DoNotOptimize(layout.getX().data());
+    }
+    const char* modeNames[] = {"exact", "barnes_hut", "grid"};
+    state.SetLabel(std::string(modeNames[static_cast<int>(mode)]) + "/" + ORDERING_NAMES[ordering]);
+    state.counters["vertices"] = n;
+    state.counters["edges"] = static_cast<double>(graph.getEdges().size());
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ReorderedLayoutStep)->Apply(orderingLayoutModes)->Unit(benchmark::kMillisecond);
+
+// Многоуровневая раскладка целиком (огрубление, грубый уровень, уточнение
+// всех уровней) с числом шагов уточнения по умолчанию. Один прогон -
+// минуты на одном ядре, поэтому повторов нет; время - настенное
+static void BM_MultilevelLayout(benchmark::State& state) {
+    int64_t vertices = state.range(0);
+    int threads = static_cast<int>(state.range(1));
+    const Graph& graph = frozenGraph(BARABASI_ALBERT, vertices * SPARSE_DEGREE / 2);
+    for (auto _ : state) {
+        ForceLayout layout(graph);
+        layout.setThreadCount(threads);
+        LayoutResult result = layout.optimizeMultilevel();
+        benchmark::DoNotOptimize(layout.getX().data());
+        state.counters["steps"] = result.iterations;
+    }
+    reportGraph(state, BARABASI_ALBERT, graph.getNumVertices(), static_cast<int64_t>(graph.getEdges().size()));
+    state.counters["threads"] = threads;
+}
+BENCHMARK(BM_MultilevelLayout)->Apply(multilevelSizes)->Iterations(1)->UseRealTime()->Unit(benchmark::kSecond);
+
+BENCHMARK_MAIN();
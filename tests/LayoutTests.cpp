@@ -0,0 +1,195 @@
+// Проверки вычислительной части раскладки (без окна и RayLib)
+//
+// Запуск: graph-layout-tests (код возврата 0 - все проверки пройдены).
+// Каждая проверка сравнивает быстрый способ расчёта с эталонным и печатает
+// полученную погрешность, провал - с сообщением в стандартный поток ошибок.
+
+// Подключаем квадродерево Barnes-Hut
+#include "QuadTree.h"
+// Подключаем вычислительные ядра (точный расчёт - эталон)
+#include "ForceKernels.h"
+// Подключаем force-directed раскладку и генераторы графов
+#include "ForceLayout.h"
+#include "GraphGenerators.h"
+// Подключаем библиотеку для ввода-вывода
+#include <iostream>
+// Подключаем библиотеку для работы с динамическими массивами
+#include <vector>
+// Подключаем библиотеку для работы со строками
+#include <string>
+// Подключаем генератор случайных чисел (координаты точек)
+#include <random>
+// Подключаем математические функции (sqrt)
+#include <cmath>
+
+// Используем пространство имён std для упрощения кода
+using namespace std;
+
+// Внутренние функции проверок
+namespace {
+
+// Количество проваленных проверок
+int failures = 0;
+
+// Функция учёта проверки: при нарушении условия печатает сообщение
+void check(bool condition, const string& message) {
+    if (!condition) {
+        cerr << "ПРОВАЛ: " << message << endl;
+        failures++;
+    }
+}
+
+// Функция заполнения координат n случайных точек в квадрате side x side
+void randomPoints(int n, float side, uint32_t seed, vector<float>& x, vector<float>& y) {
+    mt19937 random(seed);
+    uniform_real_distribution<float> coordinate(0.0f, side);
+    x.resize(n);
+    y.resize(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = coordinate(random);
+        y[i] = coordinate(random);
+    }
+}
+
+// Функция расчёта относительной погрешности сил: сумма длин разностей
+// векторов, делённая на сумму длин эталонных векторов
+double relativeError(const vector<float>& fx, const vector<float>& fy,
+                     const vector<float>& refX, const vector<float>& refY) {
+    double difference = 0.0;
+    double reference = 0.0;
+    for (size_t i = 0; i < refX.size(); i++) {
+        double dx = static_cast<double>(fx[i]) - refX[i];
+        double dy = static_cast<double>(fy[i]) - refY[i];
+        difference += sqrt(dx * dx + dy * dy);
+        reference += sqrt(static_cast<double>(refX[i]) * refX[i] + static_cast<double>(refY[i]) * refY[i]);
+    }
+    return reference > 0.0 ? difference / reference : difference;
+}
+
+// Функция проверки Barnes-Hut: погрешность отталкивания через квадродерево
+// относительно точного O(n^2) расчёта не превышает допуска для каждого theta
+void testBarnesHutError() {
+    const int n = 5000;
+    const float k = 1000.0f;
+    vector<float> x, y;
+    randomPoints(n, 1000.0f, 1, x, y);
+
+    vector<float> exactX(n, 0.0f), exactY(n, 0.0f);
+    ForceKernels::repulsionRowsScalar(x.data(), y.data(), n, 0, n, k, exactX.data(), exactY.data());
+
+    QuadTree tree;
+    tree.build(x, y);
+
+    // Допуски с запасом относительно измеренных значений
+    const float thetas[] = {0.0f, 0.3f, 0.5f, 0.8f, 1.2f};
+    const double tolerances[] = {1e-5, 0.002, 0.007, 0.025, 0.07};
+    for (int t = 0; t < 5; t++) {
+        vector<float> fx(n, 0.0f), fy(n, 0.0f);
+        for (int i = 0; i < n; i++) tree.accumulateRepulsion(i, thetas[t], k, fx[i], fy[i]);
+        double error = relativeError(fx, fy, exactX, exactY);
+        cout << "Barnes-Hut theta=" << thetas[t] << ": погрешность " << error << endl;
+        check(error <= tolerances[t], "Barnes-Hut theta=" + to_string(thetas[t]) + ": погрешность "
+              + to_string(error) + " больше допуска " + to_string(tolerances[t]));
+    }
+}
+
+// Функция проверки ядра AVX2: точное отталкивание векторным ядром совпадает
+// со скалярным эталоном с точностью до порядка суммирования float. Диапазон
+// строк и n не кратны ширине вектора - проверяются и хвосты
+void testAvx2Kernel() {
+    if (!ForceKernels::hasAvx2()) {
+        cout << "AVX2: процессор не поддерживает, проверка пропущена" << endl;
+        return;
+    }
+    const int n = 3001;
+    const int rowBegin = 5;
+    const int rowEnd = 2998;
+    const float k = 1000.0f;
+    vector<float> x, y;
+    randomPoints(n, 1000.0f, 2, x, y);
+
+    vector<float> scalarX(n, 0.0f), scalarY(n, 0.0f);
+    vector<float> vectorX(n, 0.0f), vectorY(n, 0.0f);
+    ForceKernels::repulsionRowsScalar(x.data(), y.data(), n, rowBegin, rowEnd, k, scalarX.data(), scalarY.data());
+    ForceKernels::repulsionRows(x.data(), y.data(), n, rowBegin, rowEnd, k, vectorX.data(), vectorY.data());
+
+    double error = relativeError(vectorX, vectorY, scalarX, scalarY);
+    cout << "AVX2: погрешность относительно скалярного ядра " << error << endl;
+    check(error <= 1e-5, "AVX2: погрешность " + to_string(error) + " больше допуска 1e-5");
+
+    // Строки вне диапазона не должны изменяться
+    bool untouched = true;
+    for (int i = 0; i < n; i++) {
+        if ((i < rowBegin || i >= rowEnd) && (vectorX[i] != 0.0f || vectorY[i] != 0.0f)) untouched = false;
+    }
+    check(untouched, "AVX2: изменены силы вершин вне диапазона строк");
+}
+
+// Функция раскладки графа заданным способом на заданном количестве потоков
+// (multilevel - многоуровневая раскладка, иначе optimize с начальным кругом)
+LayoutResult runLayout(const Graph& graph, RepulsionMode mode, bool multilevel, int threads,
+                       vector<float>& x, vector<float>& y) {
+    ForceLayout layout(graph);
+    layout.setThreadCount(threads);
+    layout.setRepulsionMode(mode);
+    LayoutResult result;
+    if (multilevel) {
+        result = layout.optimizeMultilevel(10);
+    } else {
+        layout.initializeCircle(500.0f, 500.0f, 400.0f);
+        result = layout.optimize(60);
+    }
+    x = layout.getX();
+    y = layout.getY();
+    return result;
+}
+
+// Функция проверки многопоточности: раскладка на 2, 3 и 8 потоках побитово
+// совпадает с однопоточной (силы каждой вершины считаются в своём потоке,
+// суммы по вершинам - по порциям в фиксированном порядке)
+void testThreadCountDeterminism() {
+    GeneratedGraph generated = GraphGenerators::barabasiAlbert(2000, 3, 7);
+    Graph graph = Graph::fromEdgeList(generated.numVertices, EdgeView(generated.edges));
+
+    struct Case {
+        const char* name;
+        RepulsionMode mode;
+        bool multilevel;
+    };
+    const Case cases[] = {
+        {"exact", RepulsionMode::Exact, false},
+        {"barnes-hut", RepulsionMode::BarnesHut, false},
+        {"grid", RepulsionMode::Grid, false},
+        {"multilevel", RepulsionMode::Auto, true},
+    };
+    const int threadCounts[] = {2, 3, 8};
+    for (const Case& c : cases) {
+        vector<float> referenceX, referenceY;
+        LayoutResult reference = runLayout(graph, c.mode, c.multilevel, 1, referenceX, referenceY);
+        for (int threads : threadCounts) {
+            vector<float> x, y;
+            LayoutResult result = runLayout(graph, c.mode, c.multilevel, threads, x, y);
+            bool same = x == referenceX && y == referenceY && result.iterations == reference.iterations
+                        && result.energy == reference.energy;
+            check(same, string("потоки, ") + c.name + ": раскладка на " + to_string(threads)
+                  + " потоках отличается от однопоточной");
+        }
+        cout << "Потоки, " << c.name << ": " << reference.iterations << " шагов, сравнено на 1, 2, 3 и 8 потоках" << endl;
+    }
+}
+
+} // namespace
+
+// Главная функция: запускает все проверки
+int main() {
+    testBarnesHutError();
+    testAvx2Kernel();
+    testThreadCountDeterminism();
+
+    if (failures > 0) {
+        cerr << "Проваленных проверок: " << failures << endl;
+        return 1;
+    }
+    cout << "Все проверки пройдены" << endl;
+    return 0;
+}
@@ -0,0 +1,228 @@
+// Консольная утилита graph-components: компоненты связности файла рёбер,
+// который не помещается в оперативную память
+//
+// Пример:
+//   graph-components --in edges.txt --labels labels.txt --sizes sizes.txt --threads 16
+//   graph-components --in edges.bin --bfs 0 --levels levels.txt
+//
+// Файл (текстовый формат loadFromFile или бинарный BinaryGraphFormat -
+// определяется по сигнатуре) читается последовательными блоками, граф
+// в памяти не строится: компоненты - один проход с union-find O(V),
+// обход в ширину (--bfs) - несколько проходов с уровнями вершин O(V).
+// Количество компонент, размеры крупнейших, время и скорость чтения
+// выводятся в стандартный вывод.
+
+// Подключаем заголовочный файл класса Graph
+#include "Graph.h"
+// Подключаем потоковое чтение файла рёбер (формат и размер файла)
+#include "EdgeStream.h"
+// Подключаем таймеры участков (при сборке с -DGRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем библиотеку для ввода-вывода
+#include <iostream>
+// Подключаем библиотеку для записи результатов
+#include <fstream>
+// Подключаем библиотеку для работы со строками
+#include <string>
+// Подключаем библиотеку для замера времени
+#include <chrono>
+// Подключаем библиотеку для алгоритмов (sort, min)
+#include <algorithm>
+// Подключаем быстрое форматирование чисел (to_chars)
+#include <charconv>
+
+// Используем пространство имён std для упрощения кода
+using namespace std;
+
+// Внутренние функции утилиты
+namespace {
+
+// Сколько крупнейших компонент выводить
+const size_t LARGEST_SHOWN = 10;
+
+// Параметры командной строки
+struct Options {
+    string input;            // Входной файл рёбер
+    string labels;           // Номер компоненты каждой вершины (пусто - не записывать)
+    string sizes;            // Размеры компонент (пусто - не записывать)
+    int bfsStart = -1;       // Стартовая вершина обхода в ширину (-1 - без обхода)
+    string levels;           // Уровни вершин обхода (пусто - не записывать)
+    int threads = 0;         // Количество потоков (0 - по числу ядер)
+};
+
+// Функция вывода справки
+void printUsage() {
+    cout << "Использование: graph-components --in <файл рёбер> [параметры]" << endl;
+    cout << "  --in <файл>       список рёбер (текстовый или бинарный формат)" << endl;
+    cout << "  --labels <файл>   номер компоненты каждой вершины (по строке на вершину)" << endl;
+    cout << "  --sizes <файл>    размеры компонент (по строке на компоненту)" << endl;
+    cout << "  --bfs <вершина>   полувнешний обход в ширину из вершины" << endl;
+    cout << "  --levels <файл>   уровни вершин обхода (-1 - недостижима)" << endl;
+    cout << "  --threads <N>     количество потоков (0 - по числу ядер)" << endl;
+}
+
+// Функция разбора целого числа из аргумента
+// Возвращает false, если строка не является неотрицательным числом
+bool parseCount(const string& text, int& value) {
+    try {
+        size_t used = 0;
+        long parsed = stol(text, &used);
+        if (used != text.size() || parsed < 0 || parsed > 2000000000L) return false;
+        value = static_cast<int>(parsed);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Функция разбора аргументов командной строки
+// Возвращает false (с сообщением в cerr), если аргументы некорректны
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        // Все параметры, кроме --help, требуют значения
+        if (arg != "--help" && i + 1 >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения" << endl;
+            return false;
+        }
+        if (arg == "--help") {
+            return false;
+        } else if (arg == "--in") {
+            options.input = argv[++i];
+        } else if (arg == "--labels") {
+            options.labels = argv[++i];
+        } else if (arg == "--sizes") {
+            options.sizes = argv[++i];
+        } else if (arg == "--levels") {
+            options.levels = argv[++i];
+        } else if (arg == "--bfs") {
+            if (!parseCount(argv[++i], options.bfsStart)) {
+                cerr << "Ошибка: некорректная стартовая вершина: " << argv[i] << endl;
+                return false;
+            }
+        } else if (arg == "--threads") {
+            if (!parseCount(argv[++i], options.threads)) {
+                cerr << "Ошибка: некорректное количество потоков: " << argv[i] << endl;
+                return false;
+            }
+        } else {
+            cerr << "Ошибка: неизвестный параметр " << arg << endl;
+            return false;
+        }
+    }
+    if (options.input.empty()) {
+        cerr << "Ошибка: нужно указать --in" << endl;
+        return false;
+    }
+    if (!options.levels.empty() && options.bfsStart < 0) {
+        cerr << "Ошибка: --levels требует --bfs" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция записи чисел в текстовый файл (по числу на строку)
+// Числа форматируются через to_chars в буфер, который сбрасывается целиком
+bool writeNumbers(const string& filename, const vector<int>& values) {
+    ofstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Ошибка: не удалось создать файл " << filename << endl;
+        return false;
+    }
+    const size_t bufferSize = 1 << 20;
+    vector<char> buffer(bufferSize + 16);
+    size_t used = 0;
+    for (int value : values) {
+        char* p = buffer.data() + used;
+        p = to_chars(p, p + 16, value).ptr;
+        *p++ = '\n';
+        used = p - buffer.data();
+        if (used >= bufferSize) {
+            file.write(buffer.data(), used);
+            used = 0;
+        }
+    }
+    file.write(buffer.data(), used);
+    return static_cast<bool>(file);
+}
+
+// Функция возвращает время в секундах с момента start
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+// Главная функция утилиты
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // Заголовок файла: формат, количество вершин и объём рёбер (для скорости чтения)
+    EdgeStream stream;
+    if (!stream.open(options.input)) return 1;
+    double megabytes = stream.getBodyBytes() / 1048576.0;
+
+    // ===== КОМПОНЕНТЫ СВЯЗНОСТИ (один проход) =====
+    auto start = chrono::steady_clock::now();
+    ComponentLabels components = Graph::streamConnectedComponents(options.input, options.threads);
+    double componentSeconds = secondsSince(start);
+    if (components.labels.size() != static_cast<size_t>(stream.getNumVertices())) {
+        cerr << "Ошибка: файл не прочитан: " << options.input << endl;
+        return 1;
+    }
+
+    // ===== ОБХОД В ШИРИНУ (несколько проходов) =====
+    vector<int> levels;
+    double bfsSeconds = 0;
+    if (options.bfsStart >= 0) {
+        // Ошибки формата строк уже выведены проходом компонент
+        start = chrono::steady_clock::now();
+        levels = Graph::streamBreadthFirstSearch(options.input, options.bfsStart, options.threads, false);
+        bfsSeconds = secondsSince(start);
+        if (levels.empty()) return 1;
+    }
+
+    // ===== ЗАПИСЬ РЕЗУЛЬТАТОВ =====
+    if (!options.labels.empty() && !writeNumbers(options.labels, components.labels)) return 1;
+    if (!options.sizes.empty() && !writeNumbers(options.sizes, components.sizes)) return 1;
+    if (!options.levels.empty() && !writeNumbers(options.levels, levels)) return 1;
+
+    // ===== СТАТИСТИКА =====
+    vector<int> largest = components.sizes;
+    size_t shown = min(LARGEST_SHOWN, largest.size());
+    partial_sort(largest.begin(), largest.begin() + shown, largest.end(), greater<int>());
+    cout << "vertices: " << stream.getNumVertices() << endl;
+    cout << "format: " << (stream.isBinary() ? "binary" : "text") << endl;
+    cout << "components: " << components.sizes.size() << endl;
+    cout << "largest:";
+    for (size_t i = 0; i < shown; i++) cout << " " << largest[i];
+    cout << endl;
+    cout << "components_seconds: " << componentSeconds << endl;
+    cout << "read_mb_per_second: " << (componentSeconds > 0 ? megabytes / componentSeconds : 0.0) << endl;
+    if (options.bfsStart >= 0) {
+        int reached = 0, depth = 0;
+        for (int level : levels) {
+            if (level < 0) continue;
+            reached++;
+            depth = max(depth, level);
+        }
+        cout << "bfs_reached: " << reached << endl;
+        cout << "bfs_depth: " << depth << endl;
+        cout << "bfs_seconds: " << bfsSeconds << endl;
+    }
+    if (Profiler::enabled()) {
+        // Время участков: количество вызовов и суммарные миллисекунды
+        ProfileStats stats = Profiler::snapshot();
+        for (int i = 0; i < ProfileStats::SECTION_COUNT; i++) {
+            ProfileSection section = static_cast<ProfileSection>(i);
+            if (stats[section].calls == 0) continue;
+            cout << "section." << Profiler::sectionName(section) << ": " << stats[section].calls
+                 << " calls, " << stats.milliseconds(section) << " ms" << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,360 @@
+// Консольная утилита graph-layout: расчёт раскладки графа без окна и RayLib
+//
+// Пример:
+//   graph-layout --in g.txt --iters 500 --algo bh --threads 32 --out layout.bin
+//
+// Загружает граф (текстовый или бинарный формат - определяется по сигнатуре),
+// выполняет force-directed раскладку и записывает координаты вершин:
+// в бинарный формат BinaryGraphFormat (граф + координаты), если имя файла
+// оканчивается на .bin, иначе - в текстовый файл "x y" по строке на вершину.
+// С --png/--svg раскладка дополнительно рисуется в картинку (без окна и
+// видеокарты, см. GraphExport); --out тогда можно не указывать.
+// С --reorder вершины перед раскладкой перенумеровываются для локальности
+// памяти; координаты и картинки записываются в исходной нумерации.
+// Время загрузки, раскладки и записи выводится в стандартный вывод.
+
+// Подключаем заголовочный файл класса Graph
+#include "Graph.h"
+// Подключаем force-directed раскладку (не зависит от RayLib)
+#include "ForceLayout.h"
+// Подключаем бинарный формат графа (определение формата входного файла)
+#include "BinaryGraphFormat.h"
+// Подключаем отсечение невидимого и экспорт картинок (не зависят от RayLib)
+#include "ViewportIndex.h"
+#include "GraphExport.h"
+// Подключаем таймеры участков (при сборке с -DGRAPH_ENABLE_PROFILING)
+#include "Profiler.h"
+// Подключаем библиотеку для ввода-вывода
+#include <iostream>
+// Подключаем библиотеку для записи текстового файла координат
+#include <fstream>
+// Подключаем библиотеку для работы со строками
+#include <string>
+// Подключаем библиотеку для замера времени
+#include <chrono>
+// Подключаем математические функции (sqrt)
+#include <cmath>
+// Подключаем библиотеку для алгоритмов (max)
+#include <algorithm>
+// Подключаем умные указатели (раскладка в исходной нумерации)
+#include <memory>
+
+// Используем пространство имён std для упрощения кода
+using namespace std;
+
+// Внутренние функции утилиты
+namespace {
+
+// Параметры командной строки
+struct Options {
+    string input;            // Входной файл графа
+    string output;           // Выходной файл координат
+    int iterations = -1;     // Количество итераций (-1 - по умолчанию для алгоритма)
+    string algorithm = "auto";  // exact, bh, grid, auto или ml
+    int threads = 0;         // Количество потоков (0 - по числу ядер)
+    string png;              // Картинка PNG (пусто - не рисовать)
+    string svg;              // Картинка SVG (пусто - не рисовать)
+    int width = 1200;        // Размер картинки в пикселях
+    int height = 800;
+    string reorder = "none";  // Перенумерация вершин: none, rcm, degree, bfs или rabbit
+};
+
+// Функция вывода справки
+void printUsage() {
+    cout << "Использование: graph-layout --in <граф> --out <координаты> [параметры]" << endl;
+    cout << "  --in <файл>       граф (текстовый или бинарный формат)" << endl;
+    cout << "  --out <файл>      координаты: *.bin - граф с координатами," << endl;
+    cout << "                    иначе текст \"x y\" по строке на вершину" << endl;
+    cout << "  --png <файл>      нарисовать раскладку в PNG" << endl;
+    cout << "  --svg <файл>      нарисовать раскладку в SVG" << endl;
+    cout << "  --width <N>       ширина картинки (по умолчанию 1200)" << endl;
+    cout << "  --height <N>      высота картинки (по умолчанию 800)" << endl;
+    cout << "  --iters <N>       максимум итераций (по умолчанию 500;" << endl;
+    cout << "                    для ml - шаги уточнения, по умолчанию 30)" << endl;
+    cout << "  --algo <алгоритм> exact | bh | grid | auto | ml (по умолчанию auto)" << endl;
+    cout << "  --threads <N>     количество потоков (0 - по числу ядер)" << endl;
+    cout << "  --reorder <способ> none | rcm | degree | bfs | rabbit - перенумерация" << endl;
+    cout << "                    вершин перед раскладкой (по умолчанию none)" << endl;
+}
+
+// Функция разбора целого числа из аргумента
+// Возвращает false, если строка не является неотрицательным числом
+bool parseCount(const string& text, int& value) {
+    try {
+        size_t used = 0;
+        long parsed = stol(text, &used);
+        if (used != text.size() || parsed < 0 || parsed > 1000000000L) return false;
+        value = static_cast<int>(parsed);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Функция разбора аргументов командной строки
+// Возвращает false (с сообщением в cerr), если аргументы некорректны
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        // Все параметры, кроме --help, требуют значения
+        if (arg != "--help" && i + 1 >= argc) {
+            cerr << "Ошибка: у параметра " << arg << " нет значения" << endl;
+            return false;
+        }
+        if (arg == "--help") {
+            return false;
+        } else if (arg == "--in") {
+            options.input = argv[++i];
+        } else if (arg == "--out") {
+            options.output = argv[++i];
+        } else if (arg == "--png") {
+            options.png = argv[++i];
+        } else if (arg == "--svg") {
+            options.svg = argv[++i];
+        } else if (arg == "--width" || arg == "--height") {
+            int& size = arg == "--width" ? options.width : options.height;
+            if (!parseCount(argv[++i], size) || size == 0 || size > 65535) {
+                cerr << "Ошибка: некорректный размер картинки: " << argv[i] << endl;
+                return false;
+            }
+        } else if (arg == "--reorder") {
+            options.reorder = argv[++i];
+        } else if (arg == "--algo") {
+            options.algorithm = argv[++i];
+        } else if (arg == "--iters") {
+            if (!parseCount(argv[++i], options.iterations)) {
+                cerr << "Ошибка: некорректное количество итераций: " << argv[i] << endl;
+                return false;
+            }
+        } else if (arg == "--threads") {
+            if (!parseCount(argv[++i], options.threads)) {
+                cerr << "Ошибка: некорректное количество потоков: " << argv[i] << endl;
+                return false;
+            }
+        } else {
+            cerr << "Ошибка: неизвестный параметр " << arg << endl;
+            return false;
+        }
+    }
+    if (options.input.empty() || (options.output.empty() && options.png.empty() && options.svg.empty())) {
+        cerr << "Ошибка: нужно указать --in и --out (или --png / --svg)" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Функция выбора способа расчёта отталкивания по имени алгоритма
+// Возвращает false, если алгоритм неизвестен
+bool parseAlgorithm(const string& name, RepulsionMode& mode) {
+    if (name == "exact") mode = RepulsionMode::Exact;
+    else if (name == "bh") mode = RepulsionMode::BarnesHut;
+    else if (name == "grid") mode = RepulsionMode::Grid;
+    else if (name == "auto" || name == "ml") mode = RepulsionMode::Auto;
+    else return false;
+    return true;
+}
+
+// Функция выбора способа перенумерации вершин по имени
+// Возвращает false, если способ неизвестен (для "none" - true, reorder = false)
+bool parseOrdering(const string& name, VertexOrdering& ordering, bool& reorder) {
+    reorder = name != "none";
+    if (name == "none") return true;
+    if (name == "rcm") ordering = VertexOrdering::ReverseCuthillMcKee;
+    else if (name == "degree") ordering = VertexOrdering::Degree;
+    else if (name == "bfs") ordering = VertexOrdering::BreadthFirst;
+    else if (name == "rabbit") ordering = VertexOrdering::Rabbit;
+    else return false;
+    return true;
+}
+
+// Функция проверки расширения файла
+bool hasExtension(const string& filename, const string& extension) {
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Функция записи координат в текстовый файл
+// Формат: первая строка - количество вершин, затем "x y" для каждой вершины
+bool writeTextLayout(const string& filename, const ForceLayout& layout) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Ошибка: не удалось создать файл " << filename << endl;
+        return false;
+    }
+    const vector<float>& x = layout.getX();
+    const vector<float>& y = layout.getY();
+    file << x.size() << "\n";
+    for (size_t i = 0; i < x.size(); i++) {
+        file << x[i] << " " << y[i] << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+// Функция возвращает время в секундах с момента start
+double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// Функция рисования раскладки в картинки PNG и SVG
+// Раскладка вписывается в картинку целиком; плотные области рисуются
+// квадратами плотности, как в окне визуализатора
+bool writeImages(const Options& options, const Graph& graph, const ForceLayout& layout,
+                 double& pngSeconds, double& svgSeconds) {
+    const vector<float>& x = layout.getX();
+    const vector<float>& y = layout.getY();
+    // Вершина - четверть длины ребра, номер - чуть меньше вершины
+    ExportStyle style;
+    style.vertexRadius = layout.getOptimalDistance() / 4;
+
+    // Отступ от края - 20 пикселей плюс радиус вершины в пикселях
+    ExportView view = ExportView::fit(x, y, options.width, options.height, 20.0f);
+    view = ExportView::fit(x, y, options.width, options.height, 20.0f + style.vertexRadius * view.scale);
+    // Ребро не тоньше пикселя, иначе на мелком масштабе оно почти не видно
+    style.edgeWidth = std::max(style.vertexRadius / 12, 1.0f / view.scale);
+    style.fontSize = static_cast<int>(std::ceil(style.vertexRadius * 0.8f));
+    style.drawLabels = style.fontSize * view.scale >= 8;
+
+    // Видимая часть для всей картинки
+    ViewportIndex index;
+    index.build(graph, x, y);
+    VisibleSet visible;
+    index.query(graph, x, y, -view.offsetX / view.scale, -view.offsetY / view.scale,
+                (options.width - view.offsetX) / view.scale, (options.height - view.offsetY) / view.scale,
+                style.vertexRadius * 2, view.scale, visible);
+
+    auto start = chrono::steady_clock::now();
+    if (!options.png.empty() && !GraphExport::writePng(options.png, x, y, visible, view, style, options.threads)) {
+        return false;
+    }
+    pngSeconds = secondsSince(start);
+    start = chrono::steady_clock::now();
+    if (!options.svg.empty() && !GraphExport::writeSvg(options.svg, x, y, visible, view, style)) {
+        return false;
+    }
+    svgSeconds = secondsSince(start);
+    return true;
+}
+
+} // namespace
+
+// Главная функция утилиты
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    RepulsionMode mode;
+    if (!parseAlgorithm(options.algorithm, mode)) {
+        cerr << "Ошибка: неизвестный алгоритм " << options.algorithm << endl;
+        printUsage();
+        return 1;
+    }
+    VertexOrdering ordering = VertexOrdering::ReverseCuthillMcKee;
+    bool reorder = false;
+    if (!parseOrdering(options.reorder, ordering, reorder)) {
+        cerr << "Ошибка: неизвестный способ перенумерации " << options.reorder << endl;
+        printUsage();
+        return 1;
+    }
+    bool multilevel = options.algorithm == "ml";
+    if (options.iterations < 0) options.iterations = multilevel ? 30 : 500;
+
+    // ===== ЗАГРУЗКА ГРАФА =====
+    auto start = chrono::steady_clock::now();
+    Graph graph = BinaryGraphFormat::isBinaryFile(options.input)
+        ? Graph::openBinary(options.input)
+        : Graph::loadFromFile(options.input, options.threads);
+    double loadSeconds = secondsSince(start);
+    int n = graph.getNumVertices();
+    if (n == 0) {
+        cerr << "Ошибка: граф не загружен или пуст: " << options.input << endl;
+        return 1;
+    }
+
+    // ===== ПЕРЕНУМЕРАЦИЯ =====
+    // Раскладка считается на перенумерованной копии графа
+    start = chrono::steady_clock::now();
+    VertexPermutation permutation;
+    Graph ordered(0);
+    if (reorder) {
+        permutation = graph.computeOrdering(ordering);
+        ordered = graph.relabel(permutation);
+    }
+    double reorderSeconds = secondsSince(start);
+
+    // ===== РАСКЛАДКА =====
+    ForceLayout layout(reorder ? ordered : graph);
+    layout.setRepulsionMode(mode);
+    layout.setThreadCount(options.threads);
+
+    start = chrono::steady_clock::now();
+    LayoutResult result;
+    if (multilevel) {
+        result = layout.optimizeMultilevel(options.iterations);
+    } else {
+        // Начальная раскладка - круг, площадь которого растёт с числом вершин
+        float radius = layout.getOptimalDistance() * std::sqrt(static_cast<float>(n)) / 2;
+        layout.initializeCircle(0.0f, 0.0f, radius);
+        result = layout.optimize(options.iterations);
+    }
+    double layoutSeconds = secondsSince(start);
+
+    // Координаты в исходной нумерации: раскладка исходного графа
+    // с переставленными обратно координатами
+    std::unique_ptr<ForceLayout> restored;
+    if (reorder) {
+        restored.reset(new ForceLayout(graph));
+        restored->setOptimalDistance(layout.getOptimalDistance());
+        restored->setPositions(permutation.restore(layout.getX()), permutation.restore(layout.getY()));
+    }
+    const ForceLayout& output = reorder ? *restored : layout;
+
+    // ===== ЗАПИСЬ КООРДИНАТ =====
+    start = chrono::steady_clock::now();
+    bool written = options.output.empty() || (hasExtension(options.output, ".bin")
+        ? output.saveLayout(options.output)
+        : writeTextLayout(options.output, output));
+    double writeSeconds = secondsSince(start);
+    if (!written) return 1;
+
+    // ===== КАРТИНКИ =====
+    double pngSeconds = 0, svgSeconds = 0;
+    if (!writeImages(options, graph, output, pngSeconds, svgSeconds)) return 1;
+
+    // ===== СТАТИСТИКА =====
+    cout << "vertices: " << n << endl;
+    cout << "edges: " << graph.getEdges().size() << endl;
+    cout << "algo: " << options.algorithm << endl;
+    cout << "reorder: " << options.reorder << endl;
+    cout << "kernel: " << ForceKernels::activeKernelName() << endl;
+    cout << "threads: " << (options.threads > 0 ? options.threads : ThreadPool::shared().getThreadCount()) << endl;
+    cout << "iterations: " << result.iterations << endl;
+    cout << "converged: " << (result.converged ? "yes" : "no") << endl;
+    cout << "energy: " << result.energy << endl;
+    cout << "load_seconds: " << loadSeconds << endl;
+    if (reorder) cout << "reorder_seconds: " << reorderSeconds << endl;
+    cout << "layout_seconds: " << layoutSeconds << endl;
+    cout << "write_seconds: " << writeSeconds << endl;
+    if (!options.png.empty()) cout << "png_seconds: " << pngSeconds << endl;
+    if (!options.svg.empty()) cout << "svg_seconds: " << svgSeconds << endl;
+    if (result.iterations > 0) {
+        cout << "ms_per_iteration: " << layoutSeconds * 1000.0 / result.iterations << endl;
+    }
+    if (Profiler::enabled()) {
+        // Время участков: количество вызовов и суммарные миллисекунды
+        ProfileStats stats = Profiler::snapshot();
+        for (int i = 0; i < ProfileStats::SECTION_COUNT; i++) {
+            ProfileSection section = static_cast<ProfileSection>(i);
+            if (stats[section].calls == 0) continue;
+            cout << "section." << Profiler::sectionName(section) << ": " << stats[section].calls
+                 << " calls, " << stats.milliseconds(section) << " ms" << endl;
+        }
+        for (int i = 0; i < ProfileStats::COUNTER_COUNT; i++) {
+            ProfileCounter counter = static_cast<ProfileCounter>(i);
+            if (stats.count(counter) == 0) continue;
+            cout << "counter." << Profiler::counterName(counter) << ": " << stats.count(counter) << endl;
+        }
+    }
+    return 0;
+}